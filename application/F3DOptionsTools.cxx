@@ -67,6 +67,7 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       { "help", "h", "Print help", "", "" }, { "version", "", "Print version details", "", "" },
       { "list-readers", "", "Print the list of readers", "", "" },
       { "force-reader", "", "Force a specific reader to be used, disregarding the file extension", "<reader>", "1"},
+      { "geometry-cache", "", "Cache the processed geometry of files read by generic readers to speed up the next loads", "<bool>", "1" },
       { "list-bindings", "", "Print the list of interaction bindings and exits, ignored with `--no-render`, only considers the first file group.", "<bool>", "1" },
       { "config", "", "Specify the configuration file to use. absolute/relative path or filename/filestem to search in configuration file locations", "<filePath/filename/fileStem>", "" },
       { "no-config", "", "Do not read the configuration file", "<bool>", "1" },
@@ -74,6 +75,7 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       { "rendering-backend", "", "Backend to use when rendering (auto|glx|wgl|egl|osmesa)", "<string>", "" },
       { "list-rendering-backends", "", "Print the list of rendering backends available on this system", "", "" },
       { "max-size", "", "Maximum size in Mib of a file to load, leave empty for unlimited", "<size in Mib>", "" },
+      { "max-memory", "", "Maximum memory in Mib used by the loaded data, leave empty for unlimited", "<size in Mib>", "" },
 #if F3D_MODULE_DMON
       { "watch", "", "Watch current file and automatically reload it whenever it is modified on disk", "<bool>", "1" },
 #endif
@@ -88,6 +90,7 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       { "multi-file-mode", "", R"(Choose the behavior when opening multiple files. "single" will show one file at a time, "all" will show all files in a single scene, "dir" will show files from the same directory in the same scene.)", "<single|all|dir>", "" },
       { "recursive-dir-add", "", "Add directories recursively", "<bool>", "1" },
       { "remove-empty-file-groups", "", "Remove file groups that results into an empty scene", "<bool>", "1" },
+      { "preload-size", "", "Preload adjacent file groups in the background when their total size in MiB is lower than this size, leave empty to disable", "<size in MiB>", "" },
       { "up", "", "Up direction", "<direction>", "" },
       { "axis", "x", "Show axes", "<bool>", "1" }, { "grid", "g", "Show grid", "<bool>", "1" },
       { "grid-absolute", "", "Position grid at the absolute origin instead of below the model", "<bool>", "1" },
@@ -100,6 +103,11 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
       { "camera-index", "", "Select the camera to use", "<index>", "" },
       { "interaction-trackball", "k", "Enable trackball interaction", "<bool>", "1" },
       { "invert-zoom", "", "Invert zoom direction with right mouse click", "<bool>", "1" },
+      { "lod", "", "Render a decimated geometry during camera motion", "<bool>", "1" },
+      { "lod-triangle-budget", "", "Maximum number of triangles of the decimated geometry", "<count>", "" },
+      { "dynamic-resolution", "", "Lower the resolution during camera motion", "<bool>", "1" },
+      { "dynamic-resolution-frame-rate", "", "Frame rate targeted by the dynamic resolution", "<fps>", "" },
+      { "output-tile-size", "", "Render outputs larger than this size in tiles, 0 to disable", "<size in pixels>", "" },
       { "animation-autoplay", "", "Automatically start animation", "<bool>", "1" },
       { "animation-index", "", "Select animation to show (deprecated)", "<index>", "" },
       { "animation-indices", "", "Select animations to show", "<index,index,index>", "" },
@@ -112,6 +120,8 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
     { {"point-sprites", "o", "Show sphere sprites instead of surfaces", "<bool>", "1" },
       {"point-sprites-type", "", "Point sprites type", "<sphere|gaussian>", ""},
       {"point-sprites-size", "", "Point sprites size", "<size>", ""},
+      {"point-sprites-streaming", "", "Stream large point clouds from an on-disk octree", "<bool>", "1"},
+      {"point-sprites-streaming-budget", "", "Memory budget of the streamed points, the imported point cloud is not bounded", "<MiB>", ""},
       {"point-size", "", "Point size when showing vertices, model specified by default", "<size>", ""},
       {"line-width", "", "Line width when showing edges, model specified by default", "<width>", ""},
       {"backface-type", "", "Backface type, can be visible or hidden, model specified by default", "<visible|hidden>", ""},
@@ -174,7 +184,7 @@ static inline const std::array<CLIGroup, 8> CLIOptions = {{
     { {"translucency-support", "p", "Enable translucency support, implemented using depth peeling", "<bool>", "1"},
       {"ambient-occlusion", "q", "Enable ambient occlusion providing approximate shadows for better depth perception, implemented using SSAO", "<bool>", "1"},
       {"anti-aliasing", "a", "Enable anti-aliasing", "<bool>", "1"},
-      {"anti-aliasing-mode", "", R"(Select anti-aliasing method ("fxaa" or "ssaa"))", "<string>", "fxaa"},
+      {"anti-aliasing-mode", "", R"(Select anti-aliasing method ("fxaa", "ssaa" or "taa"))", "<string>", "fxaa"},
       {"tone-mapping", "t", "Enable Tone Mapping, providing balanced coloring", "<bool>", "1"},
       {"final-shader", "", "Execute the final shader at the end of the rendering pipeline", "<GLSL code>", ""} } },
   {"Testing",
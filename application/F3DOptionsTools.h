@@ -42,6 +42,7 @@ static inline const OptionsDict DefaultAppOptions = {
   { "multi-file-mode", "single" },
   { "recursive-dir-add", "false" },
   { "remove-empty-file-groups", "false" },
+  { "preload-size", "" },
   { "resolution", "1000, 600" },
   { "position", "" },
   { "colormap-file", "" },
@@ -80,16 +81,25 @@ static inline const std::map<std::string_view, std::string_view> LibOptionsNames
   { "camera-index", "scene.camera.index" },
   { "interaction-trackball", "interactor.trackball" },
   { "invert-zoom", "interactor.invert_zoom" },
+  { "lod", "render.lod.enable" },
+  { "lod-triangle-budget", "render.lod.triangle_budget" },
+  { "dynamic-resolution", "render.dynamic_resolution.enable" },
+  { "dynamic-resolution-frame-rate", "render.dynamic_resolution.frame_rate" },
+  { "output-tile-size", "render.output_tile_size" },
   { "animation-autoplay", "scene.animation.autoplay" },
   { "animation-index", "scene.animation.index" },
   { "animation-indices", "scene.animation.indices" },
   { "animation-speed-factor", "scene.animation.speed_factor" },
   { "force-reader", "scene.force_reader" },
+  { "geometry-cache", "scene.geometry_cache" },
+  { "max-memory", "scene.max_memory" },
   { "font-file", "ui.font_file" },
   { "font-scale", "ui.scale" },
   { "point-sprites", "model.point_sprites.enable" },
   { "point-sprites-type", "model.point_sprites.type" },
   { "point-sprites-size", "model.point_sprites.size" },
+  { "point-sprites-streaming", "model.point_sprites.streaming.enable" },
+  { "point-sprites-streaming-budget", "model.point_sprites.streaming.budget" },
   { "point-size", "render.point_size" },
   { "line-width", "render.line_width" },
   { "backface-type", "render.backface_type" },
@@ -43,14 +43,19 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <csignal>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <mutex>
 #include <regex>
 #include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace fs = std::filesystem;
 
@@ -96,6 +101,7 @@ public:
     std::string MultiFileMode;
     bool RecursiveDirAdd;
     bool RemoveEmptyFileGroups;
+    std::optional<double> PreloadSize;
     std::vector<int> Resolution;
     std::vector<int> Position;
     std::string ColorMapFile;
@@ -246,13 +252,41 @@ public:
   {
     F3DStarter* self = reinterpret_cast<F3DStarter*>(userData);
     const std::lock_guard<std::mutex> lock(self->Internals->FilesToWatchMutex);
-    if (std::find_if(self->Internals->FilesToWatch.begin(), self->Internals->FilesToWatch.end(),
-          [&](const auto& path)
-          { return path.filename() == filename; }) != self->Internals->FilesToWatch.end())
+    for (const fs::path& path : self->Internals->FilesToWatch)
     {
-      self->Internals->ReloadFileRequested = true;
+      if (path.filename() == filename)
+      {
+        self->Internals->ChangedFiles.insert(path);
+        self->Internals->ReloadFileRequested = true;
+      }
     }
   }
+
+  /**
+   * State of a watched file, a file is reloaded only when its state is stable for
+   * WatchQuiescenceDelay so that files written in multiple chunks are reloaded once.
+   */
+  struct WatchedFileState
+  {
+    std::uintmax_t Size;
+    fs::file_time_type WriteTime;
+    std::chrono::steady_clock::time_point Since;
+
+    static WatchedFileState Get(const fs::path& path)
+    {
+      // Non existing files have an invalid state, which is stable until they are created
+      std::error_code ec;
+      std::uintmax_t size = fs::file_size(path, ec);
+      fs::file_time_type writeTime = fs::last_write_time(path, ec);
+      return { size, writeTime, std::chrono::steady_clock::now() };
+    }
+
+    bool operator!=(const WatchedFileState& other) const
+    {
+      return this->Size != other.Size || this->WriteTime != other.WriteTime;
+    }
+  };
+  static constexpr std::chrono::milliseconds WatchQuiescenceDelay{ 300 };
 #endif
 
   void addOutputImageMetadata(f3d::image& image)
@@ -749,6 +783,7 @@ public:
     this->ParseOption(appOptions, "recursive-dir-add", this->AppOptions.RecursiveDirAdd);
     this->ParseOption(
       appOptions, "remove-empty-file-groups", this->AppOptions.RemoveEmptyFileGroups);
+    this->ParseOption(appOptions, "preload-size", this->AppOptions.PreloadSize);
     this->ParseOption(appOptions, "resolution", this->AppOptions.Resolution);
     this->ParseOption(appOptions, "position", this->AppOptions.Position);
     this->ParseOption(appOptions, "colormap-file", this->AppOptions.ColorMapFile);
@@ -927,6 +962,227 @@ public:
     return parents;
   }
 
+  struct PathHash
+  {
+    size_t operator()(const fs::path& path) const
+    {
+      return fs::hash_value(path);
+    }
+  };
+
+  /**
+   * List the regular files of a directory sorted by path, with the files of its subdirectories
+   * in place if recursive is true. Subdirectories are listed in parallel, errors in them are
+   * logged and do not stop the listing.
+   */
+  static std::vector<fs::path> ListDirectory(const fs::path& dir, bool recursive, bool quiet)
+  {
+    // Sorted entries, true for directories
+    std::map<fs::path, bool> sortedPaths = F3DInternals::ListDirectoryEntries(dir, recursive);
+
+    std::vector<fs::path> subDirs;
+    for (const auto& [entryPath, isDir] : sortedPaths)
+    {
+      if (isDir)
+      {
+        subDirs.emplace_back(entryPath);
+      }
+    }
+
+    // Each worker lists whole subdirectories, picked in order until none are left
+    std::vector<std::vector<fs::path>> subDirFiles(subDirs.size());
+    std::vector<std::string> subDirErrors(subDirs.size());
+    std::atomic<size_t> nextSubDir = 0;
+    const auto listSubDirs = [&]()
+    {
+      for (size_t i = nextSubDir++; i < subDirs.size(); i = nextSubDir++)
+      {
+        try
+        {
+          subDirFiles[i] = F3DInternals::ListSubDirectory(subDirs[i]);
+        }
+        catch (const fs::filesystem_error& ex)
+        {
+          subDirErrors[i] = ex.what();
+        }
+      }
+    };
+
+    const size_t nbThreads = std::min<size_t>(
+      subDirs.size(), std::max<unsigned int>(std::thread::hardware_concurrency(), 1));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < nbThreads; i++)
+    {
+      workers.emplace_back(listSubDirs);
+    }
+    listSubDirs();
+    for (std::thread& worker : workers)
+    {
+      worker.join();
+    }
+
+    std::vector<fs::path> files;
+    size_t subDirIndex = 0;
+    for (const auto& [entryPath, isDir] : sortedPaths)
+    {
+      if (isDir)
+      {
+        if (!quiet && !subDirErrors[subDirIndex].empty())
+        {
+          f3d::log::error("Error adding file: ", subDirErrors[subDirIndex]);
+        }
+        std::move(subDirFiles[subDirIndex].begin(), subDirFiles[subDirIndex].end(),
+          std::back_inserter(files));
+        subDirIndex++;
+      }
+      else
+      {
+        files.emplace_back(entryPath);
+      }
+    }
+    return files;
+  }
+
+  /**
+   * Serially list all regular files of a directory and its subdirectories, sorted by path
+   */
+  static std::vector<fs::path> ListSubDirectory(const fs::path& dir)
+  {
+    std::vector<fs::path> files;
+    for (const auto& [entryPath, isDir] : F3DInternals::ListDirectoryEntries(dir, true))
+    {
+      if (isDir)
+      {
+        std::vector<fs::path> subFiles = F3DInternals::ListSubDirectory(entryPath);
+        std::move(subFiles.begin(), subFiles.end(), std::back_inserter(files));
+      }
+      else
+      {
+        files.emplace_back(entryPath);
+      }
+    }
+    return files;
+  }
+
+  /**
+   * List the regular files and, if requested, the directories of a directory, sorted by path.
+   * The value is true for directories.
+   */
+  static std::map<fs::path, bool> ListDirectoryEntries(const fs::path& dir, bool withDirectories)
+  {
+    std::map<fs::path, bool> sortedPaths;
+    for (const auto& entry : fs::directory_iterator(dir))
+    {
+      if (entry.is_regular_file())
+      {
+        sortedPaths.emplace(entry.path(), false);
+      }
+      else if (withDirectories && entry.is_directory())
+      {
+        sortedPaths.emplace(entry.path(), true);
+      }
+    }
+    return sortedPaths;
+  }
+
+  /**
+   * Add an absolute file path to the files group matching its key, creating it if needed.
+   * Return the index of the files group.
+   */
+  int AddToFilesGroup(const fs::path& filePath)
+  {
+    // Compute a key to identify the group the file should go in
+    std::string groupKey;
+    // XXX more multi-file mode may be added in the future
+    if (this->AppOptions.MultiFileMode == "dir")
+    {
+      groupKey = filePath.parent_path().string();
+    }
+    else if (this->AppOptions.MultiFileMode != "all")
+    {
+      groupKey = filePath.string();
+    }
+
+    auto [it, inserted] = this->FilesGroupsIndex.try_emplace(groupKey);
+    FilesGroupIndex& groupIndex = it->second;
+    if (inserted)
+    {
+      // Create new group if we haven't found one
+      groupIndex.Index = this->FilesGroups.size();
+      this->FilesGroups.emplace_back(groupKey, std::vector<fs::path>());
+    }
+
+    // Check if file has already been added
+    if (groupIndex.Paths.insert(filePath).second)
+    {
+      this->FilesGroups[groupIndex.Index].second.emplace_back(filePath);
+    }
+    return static_cast<int>(groupIndex.Index);
+  }
+
+  /**
+   * Remove a files group and update the index accordingly
+   */
+  void EraseFilesGroup(int index)
+  {
+    this->FilesGroupsIndex.erase(this->FilesGroups[index].first);
+    this->FilesGroups.erase(this->FilesGroups.begin() + index);
+    for (auto& [key, groupIndex] : this->FilesGroupsIndex)
+    {
+      if (groupIndex.Index > static_cast<size_t>(index))
+      {
+        groupIndex.Index--;
+      }
+    }
+  }
+
+  /**
+   * Preload the next and previous files groups in the background if their total file size
+   * fits in the preload size. Previously preloaded files that are not adjacent anymore are
+   * discarded.
+   */
+  void PreloadAdjacentFilesGroups()
+  {
+    if (!this->AppOptions.PreloadSize.has_value() || this->AppOptions.NoRender ||
+      this->CurrentFilesGroupIndex < 0)
+    {
+      return;
+    }
+
+    static constexpr int BYTES_IN_MIB = 1048576;
+    const auto budget =
+      static_cast<std::uintmax_t>(this->AppOptions.PreloadSize.value() * BYTES_IN_MIB);
+    const int size = static_cast<int>(this->FilesGroups.size());
+
+    std::vector<fs::path> paths;
+    std::uintmax_t totalSize = 0;
+    std::set<int> groupIndices = { this->CurrentFilesGroupIndex };
+    for (int offset : { 1, -1 })
+    {
+      int groupIndex = (this->CurrentFilesGroupIndex + offset + size) % size;
+      if (!groupIndices.insert(groupIndex).second)
+      {
+        continue;
+      }
+
+      const std::vector<fs::path>& groupPaths = this->FilesGroups[groupIndex].second;
+      std::uintmax_t groupSize = 0;
+      for (const fs::path& groupPath : groupPaths)
+      {
+        std::error_code ec;
+        std::uintmax_t fileSize = fs::file_size(groupPath, ec);
+        groupSize += ec ? 0 : fileSize;
+      }
+      if (totalSize + groupSize <= budget)
+      {
+        totalSize += groupSize;
+        paths.insert(paths.end(), groupPaths.begin(), groupPaths.end());
+      }
+    }
+
+    this->Engine->getScene().preload(paths);
+  }
+
   static void SigCallback(int)
   {
     if (GlobalInteractor)
@@ -945,6 +1201,15 @@ public:
   F3DConfigFileTools::BindingsEntries ConfigBindingsEntries;
   std::unique_ptr<f3d::engine> Engine;
   std::vector<std::pair<std::string, std::vector<fs::path>>> FilesGroups;
+
+  // Index of the files groups by key, with the paths they contain for fast lookup
+  struct FilesGroupIndex
+  {
+    size_t Index = 0;
+    std::unordered_set<fs::path, PathHash> Paths;
+  };
+  std::unordered_map<std::string, FilesGroupIndex> FilesGroupsIndex;
+
   std::vector<fs::path> LoadedFiles;
   std::set<fs::path> FilesToWatch;
   int CurrentFilesGroupIndex = -1;
@@ -953,6 +1218,8 @@ public:
   // dmon related
   std::mutex FilesToWatchMutex;
   std::map<fs::path, dmon_watch_id> FolderWatchIds;
+  std::set<fs::path> ChangedFiles; // Guarded by FilesToWatchMutex
+  std::map<fs::path, WatchedFileState> FilesToReload;
 #endif
 
   // Event loop atomics
@@ -1427,8 +1694,7 @@ void F3DStarter::LoadFileGroup(int index, bool relativeIndex, bool forceClear)
 
     if (this->Internals->AppOptions.RemoveEmptyFileGroups && this->Internals->LoadedFiles.empty())
     {
-      this->Internals->FilesGroups.erase(
-        this->Internals->FilesGroups.begin() + this->Internals->CurrentFilesGroupIndex);
+      this->Internals->EraseFilesGroup(this->Internals->CurrentFilesGroupIndex);
       this->LoadRelativeFileGroup(0, false, true);
     }
   }
@@ -1437,6 +1703,8 @@ void F3DStarter::LoadFileGroup(int index, bool relativeIndex, bool forceClear)
     this->Internals->CurrentFilesGroupIndex = groupIndex;
     this->LoadFileGroupInternal(std::vector<fs::path>{}, true, "");
   }
+
+  this->Internals->PreloadAdjacentFilesGroups();
 }
 
 //----------------------------------------------------------------------------
@@ -1540,10 +1808,11 @@ void F3DStarter::LoadFileGroupInternal(
       this->Internals->Engine->setOptions(this->Internals->LibOptions);
 
       f3d::log::debug("Checking files:");
+      std::unordered_set<fs::path, F3DInternals::PathHash> loadedFiles(
+        this->Internals->LoadedFiles.begin(), this->Internals->LoadedFiles.end());
       for (const fs::path& tmpPath : paths)
       {
-        if (std::find(this->Internals->LoadedFiles.begin(), this->Internals->LoadedFiles.end(),
-              tmpPath) == this->Internals->LoadedFiles.end())
+        if (loadedFiles.find(tmpPath) == loadedFiles.end())
         {
           // Always add files to the watch set
           if (this->Internals->AppOptions.Watch)
@@ -1775,57 +2044,16 @@ int F3DStarter::AddFile(const fs::path& path, bool quiet)
     // If file is a directory, add files recursively
     if (fs::is_directory(tmpPath))
     {
-      std::set<fs::path> sortedPaths;
-      for (const auto& entry : fs::directory_iterator(tmpPath))
+      for (const fs::path& filePath : F3DInternals::ListDirectory(
+             tmpPath, this->Internals->AppOptions.RecursiveDirAdd, quiet))
       {
-        if (entry.is_regular_file() ||
-          (this->Internals->AppOptions.RecursiveDirAdd && entry.is_directory()))
-        {
-          sortedPaths.insert(entry.path());
-        }
-      }
-      for (const auto& entryPath : sortedPaths)
-      {
-        // Recursively add all files
-        this->AddFile(entryPath, quiet);
+        this->Internals->AddToFilesGroup(filePath);
       }
       return static_cast<int>(this->Internals->FilesGroups.size()) - 1;
     }
     else
     {
-      // Compute a key to identify the group the file should go in
-      const auto pathToGroupKey = [&]()
-      {
-        // XXX more multi-file mode may be added in the future
-        if (this->Internals->AppOptions.MultiFileMode == "all")
-        {
-          return std::string("");
-        }
-        if (this->Internals->AppOptions.MultiFileMode == "dir")
-        {
-          return tmpPath.parent_path().string();
-        }
-        return tmpPath.string();
-      };
-
-      const std::string groupKey = pathToGroupKey();
-      size_t groupIndex = 0;
-      for (auto& [key, paths] : this->Internals->FilesGroups)
-      {
-        if (key == groupKey)
-        {
-          // Check if file has already been added
-          if (std::find(paths.begin(), paths.end(), tmpPath) == paths.end())
-          {
-            paths.emplace_back(tmpPath);
-          }
-          return static_cast<int>(groupIndex);
-        }
-        ++groupIndex;
-      }
-      // Create new group if we haven't found one and returned already
-      this->Internals->FilesGroups.emplace_back(groupKey, std::vector<fs::path>({ tmpPath }));
-      return static_cast<int>(this->Internals->FilesGroups.size()) - 1;
+      return this->Internals->AddToFilesGroup(tmpPath);
     }
   }
   catch (const fs::filesystem_error& ex)
@@ -1862,11 +2090,93 @@ bool F3DStarter::LoadRelativeFileGroup(int index, bool restoreCamera, bool force
 //----------------------------------------------------------------------------
 void F3DStarter::EventLoop()
 {
+#if F3D_MODULE_DMON
+  using WatchedFileState = F3DInternals::WatchedFileState;
+
   if (this->Internals->ReloadFileRequested)
   {
-    this->LoadRelativeFileGroup(0, true, true);
+    // Each new change event restarts the quiescence delay of the file
+    const std::lock_guard<std::mutex> lock(this->Internals->FilesToWatchMutex);
+    for (const fs::path& path : this->Internals->ChangedFiles)
+    {
+      this->Internals->FilesToReload[path] = WatchedFileState::Get(path);
+    }
+    this->Internals->ChangedFiles.clear();
     this->Internals->ReloadFileRequested = false;
   }
+
+  if (this->Internals->FilesToReload.empty())
+  {
+    return;
+  }
+
+  // Recover files that did not change during the quiescence delay
+  std::vector<fs::path> stableFiles;
+  for (auto it = this->Internals->FilesToReload.begin();
+       it != this->Internals->FilesToReload.end();)
+  {
+    WatchedFileState state = WatchedFileState::Get(it->first);
+    if (state != it->second)
+    {
+      it->second = state;
+      it++;
+    }
+    else if (state.Since - it->second.Since >= F3DInternals::WatchQuiescenceDelay)
+    {
+      stableFiles.emplace_back(it->first);
+      it = this->Internals->FilesToReload.erase(it);
+    }
+    else
+    {
+      it++;
+    }
+  }
+
+  if (stableFiles.empty())
+  {
+    return;
+  }
+
+  // Only reload the changed files if they are already loaded, keeping the rest of the scene
+  const std::vector<fs::path>& loadedFiles = this->Internals->LoadedFiles;
+  bool fullReload = std::any_of(stableFiles.begin(), stableFiles.end(), [&](const fs::path& path)
+    { return std::find(loadedFiles.begin(), loadedFiles.end(), path) == loadedFiles.end(); });
+  if (!fullReload)
+  {
+    if (!this->Internals->AppOptions.NoRender)
+    {
+      this->Internals->Engine->getInteractor().stopAnimation();
+    }
+
+    try
+    {
+      f3d::scene& scene = this->Internals->Engine->getScene();
+      for (const fs::path& path : stableFiles)
+      {
+        f3d::log::debug("Reloading changed file: ", path.string());
+        scene.reload(path);
+      }
+    }
+    catch (const f3d::scene::load_failure_exception& ex)
+    {
+      // Either the file is missing or not supported anymore and the scene is untouched,
+      // or it failed to import and the scene has been cleared. In both cases, reload the whole
+      // group so that the scene matches the files currently on disk
+      f3d::log::error("Could not reload changed file: ", ex.what());
+      fullReload = true;
+    }
+  }
+
+  if (fullReload)
+  {
+    this->LoadRelativeFileGroup(0, true, true);
+  }
+
+  if (!this->Internals->AppOptions.NoRender)
+  {
+    this->Internals->Engine->getInteractor().requestRender();
+  }
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -1907,8 +2217,7 @@ void F3DStarter::AddCommands()
         {
           this->Internals->Engine->getInteractor().stopAnimation();
         }
-        this->Internals->FilesGroups.erase(
-          this->Internals->FilesGroups.begin() + this->Internals->CurrentFilesGroupIndex);
+        this->Internals->EraseFilesGroup(this->Internals->CurrentFilesGroupIndex);
         this->LoadRelativeFileGroup(0, false, true);
       }
     });
@@ -1921,6 +2230,7 @@ void F3DStarter::AddCommands()
         this->Internals->Engine->getInteractor().stopAnimation();
       }
       this->Internals->FilesGroups.clear();
+      this->Internals->FilesGroupsIndex.clear();
       this->LoadFileGroup(0, false, true);
       this->ResetWindowName();
     });
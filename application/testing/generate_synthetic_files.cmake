@@ -0,0 +1,11 @@
+# Generate a directory tree of empty synthetic files
+# Usage: cmake -DOUTPUT_DIR=<dir> -DNB_DIRS=<count> -DNB_FILES=<count> -P generate_synthetic_files.cmake
+file(REMOVE_RECURSE "${OUTPUT_DIR}")
+foreach(_dir RANGE 1 ${NB_DIRS})
+  set(_files "")
+  foreach(_file RANGE 1 ${NB_FILES})
+    list(APPEND _files "${OUTPUT_DIR}/${_dir}/${_file}.dummy")
+  endforeach()
+  file(MAKE_DIRECTORY "${OUTPUT_DIR}/${_dir}")
+  file(TOUCH ${_files})
+endforeach()
@@ -0,0 +1,38 @@
+# Test the debounce of the watch feature by rewriting a loaded file
+# in multiple chunks and checking that it has been reloaded only once,
+# keeping the rest of the scene
+
+$f3d_cmd = $args[0]
+$data_dir = $args[1]
+$tmp_dir = $args[2]
+
+$hires_data = "$data_dir/cow.vtp"
+$lowres_data = "$data_dir/cowlow.vtp"
+$reloaded_data = "$tmp_dir/cow_debounce.vtp"
+
+Copy-Item $hires_data -Destination $reloaded_data
+
+$log = "$tmp_dir/output_debounce.log"
+$id = (Start-Process -FilePath $f3d_cmd -ArgumentList "--watch --verbose $reloaded_data" -RedirectStandardOutput $log -PassThru).Id
+
+Start-Sleep -Seconds 1
+$bytes = [System.IO.File]::ReadAllBytes($lowres_data)
+$half = [int]($bytes.Length / 2)
+$stream = [System.IO.File]::Open($reloaded_data, [System.IO.FileMode]::Create)
+$stream.Write($bytes, 0, $half)
+$stream.Flush()
+Start-Sleep -Milliseconds 100
+$stream.Write($bytes, $half, $bytes.Length - $half)
+$stream.Close()
+Start-Sleep -Milliseconds 1500
+
+$reloads = (Select-String $log -Pattern "Reloading changed file").Count
+$str = Select-String $log -Pattern "Number of points: 634"
+if ($reloads -eq 1 -and $str -ne $null) {
+  $ret = 0
+} else {
+  $ret = 1
+}
+
+Stop-Process -Id $id
+exit $ret
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# Test the debounce of the watch feature by rewriting a loaded file
+# in multiple chunks and checking that it has been reloaded only once,
+# keeping the rest of the scene
+
+set -euo pipefail
+f3d_cmd=$1
+data_dir=$2
+tmp_dir=$3
+
+hires_data=$data_dir/cow.vtp
+lowres_data=$data_dir/cowlow.vtp
+reloaded_data=$tmp_dir/cow_debounce.vtp
+
+cp $hires_data $reloaded_data
+
+log=$tmp_dir/output_debounce.log
+$f3d_cmd --watch --verbose $reloaded_data > $log &
+pid=$!
+
+function cleanup()
+{
+  kill -SIGTERM $pid
+}
+trap "cleanup" EXIT
+
+sleep 1
+size=$(wc -c < $lowres_data)
+half=$((size / 2))
+head -c $half $lowres_data > $reloaded_data
+sleep 0.1
+tail -c +$((half + 1)) $lowres_data >> $reloaded_data
+sleep 1.5
+
+test "$(grep -c "Reloading changed file" $log)" -eq 1
+grep -q "Number of points: 634" $log
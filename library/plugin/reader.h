@@ -163,6 +163,14 @@ public:
     return keys;
   }
 
+  /**
+   * Return the names and values of all reader options
+   */
+  const std::map<std::string, std::string>& getAllReaderOptions() const
+  {
+    return this->ReaderOptions;
+  }
+
 protected:
   std::map<std::string, std::string> ReaderOptions;
 };
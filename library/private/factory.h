@@ -16,8 +16,12 @@
 #include "plugin.h"
 #include "reader.h"
 
+#include <cstdint>
+#include <filesystem>
 #include <map>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace f3d
@@ -43,10 +47,19 @@ public:
   void autoload();
 
   /**
-   * Get the reader that can read the given file, nullptr if none
+   * Get the reader that can read the given file, nullptr if none.
+   * Readers are looked up by file extension using an index built when plugins are registered.
+   * If no reader matches the extension and content sniffing is enabled, the first bytes of the
+   * file are compared against known format signatures.
    */
   reader* getReader(const std::string& fileName, std::optional<std::string> forceReader);
 
+  /**
+   * Enable or disable content sniffing for files with a missing or unknown extension.
+   * Enabled by default.
+   */
+  void setContentSniffing(bool enable);
+
   /**
    * Get the list of the registered plugins
    */
@@ -75,9 +88,40 @@ protected:
 
   bool registerOnce(plugin* p);
 
+  /**
+   * Rebuild the extension and name indices from the registered plugins if needed
+   */
+  void updateIndex();
+
+  /**
+   * Find the best reader for the extension of the given file, nullptr if none.
+   * If no reader indexed for the extension accepts it, all readers are checked with canRead.
+   */
+  reader* findReaderByExtension(const std::string& fileName);
+
+  /**
+   * Find the best reader by reading the first bytes of the given file, nullptr if none.
+   * Readers of the identified format are checked with canRead on the file name completed
+   * with the identified extension.
+   */
+  reader* findReaderByContent(const std::string& fileName);
+
   std::vector<plugin*> Plugins;
 
   std::map<std::string, plugin_initializer_t> StaticPluginInitializers;
+
+  // Readers sorted by decreasing score for each lowercase extension
+  std::unordered_map<std::string, std::vector<reader*>> ReaderIndex;
+  std::unordered_map<std::string, reader*> ReaderNames;
+  // All readers sorted by decreasing score, for the ones accepting other files in canRead
+  std::vector<reader*> AllReaders;
+  bool IndexDirty = true;
+
+  bool ContentSniffing = true;
+  std::string LastSniffedFile;
+  std::filesystem::file_time_type LastSniffedTime;
+  std::uintmax_t LastSniffedSize = 0;
+  reader* LastSniffedReader = nullptr;
 };
 }
 #endif
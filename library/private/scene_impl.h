@@ -35,7 +35,9 @@ public:
   scene& add(const std::vector<std::filesystem::path>& filePath) override;
   scene& add(const std::vector<std::string>& filePathStrings) override;
   scene& add(const mesh_t& mesh) override;
+  scene& reload(const std::filesystem::path& filePath) override;
   scene& clear() override;
+  scene& preload(const std::vector<std::filesystem::path>& filePaths) override;
   bool supports(const std::filesystem::path& filePath) override;
   scene& loadAnimationTime(double timeValue) override;
   std::pair<double, double> animationTimeRange() override;
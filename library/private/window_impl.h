@@ -111,6 +111,12 @@ public:
    */
   void SetCachePath(const std::filesystem::path& cachePath);
 
+  /**
+   * Implementation only API.
+   * Get the cache path.
+   */
+  const std::filesystem::path& GetCachePath() const;
+
   /**
    * Implementation only API.
    * Set the interactor to use when recovering bindings documentation.
@@ -123,6 +129,13 @@ public:
    */
   void RenderUIOnly();
 
+  /**
+   * Implementation only API.
+   * Render one more frame of the progressive anti-aliasing if it has not converged yet.
+   * Return false without rendering otherwise.
+   */
+  bool RenderAccumulationStep();
+
 private:
   class internals;
   std::unique_ptr<internals> Internals;
@@ -5,6 +5,7 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
 
 namespace f3d
 {
@@ -40,12 +41,17 @@ public:
 
   /**
    * Log provided args as provided verbose level.
+   * Args are only formatted if the level is enabled.
    */
   template<typename... Args>
-  static void print(VerboseLevel level, Args... args)
+  static void print(VerboseLevel level, Args&&... args)
   {
+    if (!log::isEnabled(level))
+    {
+      return;
+    }
     std::stringstream ss;
-    log::appendArg(ss, args...);
+    log::appendArg(ss, std::forward<Args>(args)...);
     log::printInternal(level, ss.str());
   }
 
@@ -53,10 +59,14 @@ public:
    * Log provided args as a debug.
    */
   template<typename... Args>
-  static void debug(Args... args)
+  static void debug(Args&&... args)
   {
+    if (!log::isEnabled(VerboseLevel::DEBUG))
+    {
+      return;
+    }
     std::stringstream ss;
-    log::appendArg(ss, args...);
+    log::appendArg(ss, std::forward<Args>(args)...);
     log::debugInternal(ss.str());
   }
 
@@ -64,10 +74,14 @@ public:
    * Log provided args as an info.
    */
   template<typename... Args>
-  static void info(Args... args)
+  static void info(Args&&... args)
   {
+    if (!log::isEnabled(VerboseLevel::INFO))
+    {
+      return;
+    }
     std::stringstream ss;
-    log::appendArg(ss, args...);
+    log::appendArg(ss, std::forward<Args>(args)...);
     log::infoInternal(ss.str());
   }
 
@@ -75,10 +89,14 @@ public:
    * Log provided args as a warning.
    */
   template<typename... Args>
-  static void warn(Args... args)
+  static void warn(Args&&... args)
   {
+    if (!log::isEnabled(VerboseLevel::WARN))
+    {
+      return;
+    }
     std::stringstream ss;
-    log::appendArg(ss, args...);
+    log::appendArg(ss, std::forward<Args>(args)...);
     log::warnInternal(ss.str());
   }
 
@@ -86,10 +104,14 @@ public:
    * Log provided args as an error.
    */
   template<typename... Args>
-  static void error(Args... args)
+  static void error(Args&&... args)
   {
+    if (!log::isEnabled(VerboseLevel::ERROR))
+    {
+      return;
+    }
     std::stringstream ss;
-    log::appendArg(ss, args...);
+    log::appendArg(ss, std::forward<Args>(args)...);
     log::errorInternal(ss.str());
   }
 
@@ -110,6 +132,12 @@ public:
    */
   static VerboseLevel getVerboseLevel();
 
+  /**
+   * Return true if logs of the provided level are displayed with the current verbose level.
+   * Can be used to skip building expensive messages.
+   */
+  static bool isEnabled(VerboseLevel level);
+
 protected:
   //! @cond
   static void appendArg(std::stringstream&)
@@ -117,10 +145,10 @@ protected:
   }
 
   template<typename T, typename... Args>
-  static void appendArg(std::stringstream& ss, T value, Args... args)
+  static void appendArg(std::stringstream& ss, T&& value, Args&&... args)
   {
-    ss << value;
-    log::appendArg(ss, args...);
+    ss << std::forward<T>(value);
+    log::appendArg(ss, std::forward<Args>(args)...);
   }
 
   static void printInternal(VerboseLevel level, const std::string& msg);
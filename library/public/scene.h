@@ -74,11 +74,26 @@ public:
   }
   ///@}
 
+  /**
+   * Reload a previously added file after it changed on disk.
+   * Only this file is read again, other files and the camera are kept as is.
+   * Throw a load_failure_exception if the file has not been added to the scene,
+   * or if it fails to load, in which case the scene is cleared.
+   */
+  virtual scene& reload(const std::filesystem::path& filePath) = 0;
+
   /**
    * Clear the scene of all added files
    */
   virtual scene& clear() = 0;
 
+  /**
+   * Start reading provided files in the background so that adding them later is faster.
+   * Files that were preloaded previously and are not part of provided files are discarded.
+   * Unsupported files are ignored. Only files read by a geometry reader are preloaded.
+   */
+  virtual scene& preload(const std::vector<std::filesystem::path>& filePaths) = 0;
+
   /**
    * Return true if provided file path is supported, false otherwise.
    */
@@ -464,6 +464,12 @@ engine::libInformation engine::getLibInfo()
   libInfo.Modules["OpenEXR"] = false;
 #endif
 
+#if F3D_MODULE_KTX
+  libInfo.Modules["KTX"] = true;
+#else
+  libInfo.Modules["KTX"] = false;
+#endif
+
 #if F3D_MODULE_UI
   libInfo.Modules["ImGui"] = true;
 #else
@@ -8,6 +8,10 @@
 #include "vtkF3DEXRReader.h"
 #endif
 
+#if F3D_MODULE_KTX
+#include "vtkF3DKTXReader.h"
+#endif
+
 #include <vtkImageReader2Factory.h>
 #include <vtkLogger.h>
 #include <vtkNew.h>
@@ -57,5 +61,10 @@ init::init()
   vtkNew<vtkF3DEXRReader> reader;
   vtkImageReader2Factory::RegisterReader(reader);
 #endif
+
+#if F3D_MODULE_KTX
+  vtkNew<vtkF3DKTXReader> ktxReader;
+  vtkImageReader2Factory::RegisterReader(ktxReader);
+#endif
 }
 }
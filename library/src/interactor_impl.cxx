@@ -586,7 +586,7 @@ public:
       this->Window.render();
       this->RenderRequested = false;
     }
-    else
+    else if (!this->Window.RenderAccumulationStep())
     {
       this->Window.RenderUIOnly();
     }
@@ -762,6 +762,10 @@ interactor& interactor_impl::initCommands()
         {
           mode = "ssaa";
         }
+        else if (mode == "ssaa")
+        {
+          mode = "taa";
+        }
         else
         {
           enabled = false;
@@ -1088,7 +1092,7 @@ interactor& interactor_impl::initBindings()
     }
   };
 
-  // "Cycle anti-aliasing" , "none/fxaa/ssaa"
+  // "Cycle anti-aliasing" , "none/fxaa/ssaa/taa"
   auto docAA = [&]()
   {
     std::string desc;
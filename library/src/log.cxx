@@ -129,4 +129,10 @@ log::VerboseLevel log::getVerboseLevel()
       return log::VerboseLevel::INFO;
   }
 }
+
+//----------------------------------------------------------------------------
+bool log::isEnabled(log::VerboseLevel level)
+{
+  return level != log::VerboseLevel::QUIET && level >= log::getVerboseLevel();
+}
 }
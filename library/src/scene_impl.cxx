@@ -1,25 +1,33 @@
 #include "scene_impl.h"
 
 #include "animationManager.h"
+#include "config.h"
 #include "interactor_impl.h"
 #include "log.h"
 #include "options.h"
 #include "scene.h"
 #include "window_impl.h"
 
+#include "F3DLog.h"
 #include "factory.h"
 #include "vtkF3DGenericImporter.h"
 #include "vtkF3DMemoryMesh.h"
 #include "vtkF3DMetaImporter.h"
 
-#include <optional>
 #include <vtkCallbackCommand.h>
 #include <vtkProgressBarRepresentation.h>
 #include <vtkProgressBarWidget.h>
 #include <vtkTimerLog.h>
-#include <vtkVersion.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -39,6 +47,244 @@ public:
     this->AnimationManager.SetImporter(this->MetaImporter);
   }
 
+  ~internals()
+  {
+    // Remaining files are skipped and the file being read is aborted, so that joining does not
+    // wait for a whole read, unless the reader never reports its progress
+    for (const auto& [path, file] : this->PreloadedFiles)
+    {
+      file->Cancel();
+    }
+    for (PreloadWorker& worker : this->PreloadWorkers)
+    {
+      worker.Thread.join();
+    }
+    F3DLog::FlushDeferredMessages();
+  }
+
+  /**
+   * Create an importer for the provided file using the provided reader
+   */
+  vtkSmartPointer<vtkImporter> CreateImporter(
+    const f3d::reader* reader, const fs::path& filePath) const
+  {
+    vtkSmartPointer<vtkImporter> importer = reader->createSceneReader(filePath.string());
+    if (!importer)
+    {
+      // XXX: F3D Plugin CMake logic ensure there is either a scene reader or a geometry reader
+      auto vtkReader = reader->createGeometryReader(filePath.string());
+      assert(vtkReader);
+      vtkSmartPointer<vtkF3DGenericImporter> genericImporter =
+        vtkSmartPointer<vtkF3DGenericImporter>::New();
+      genericImporter->SetInternalReader(vtkReader);
+      if (this->Options.scene.geometry_cache)
+      {
+        // the processed geometries of a file are grouped so that the outdated ones are removed
+        fs::path fileCachePath = this->Window.GetCachePath() / "geometry" /
+          scene_impl::internals::ComputeGeometryCachePathKey(filePath);
+        std::string key = scene_impl::internals::ComputeGeometryCacheKey(reader, filePath);
+        scene_impl::internals::PruneGeometryCache(fileCachePath, key);
+        genericImporter->SetCacheDirectory((fileCachePath / key).string());
+      }
+      importer = genericImporter;
+    }
+    return importer;
+  }
+
+  /**
+   * Compute a key identifying the provided file from its absolute path,
+   * used to group the processed geometries of the file in the cache.
+   */
+  static std::string ComputeGeometryCachePathKey(const fs::path& filePath)
+  {
+    std::error_code ec;
+    std::string path = fs::absolute(filePath, ec).string();
+
+    unsigned char digest[16];
+    char md5Hash[33];
+    md5Hash[32] = '\0';
+    vtksysMD5* md5 = vtksysMD5_New();
+    vtksysMD5_Initialize(md5);
+    vtksysMD5_Append(
+      md5, reinterpret_cast<const unsigned char*>(path.data()), static_cast<int>(path.size()));
+    vtksysMD5_Finalize(md5, digest);
+    vtksysMD5_DigestToHex(digest, md5Hash);
+    vtksysMD5_Delete(md5);
+    return md5Hash;
+  }
+
+  /**
+   * Remove the processed geometries of a file cached with another key than the provided one,
+   * they are outdated since the file, the reader options or the F3D version changed.
+   * Temporary directories are only removed when older than a day, as another process may still
+   * be writing them.
+   */
+  static void PruneGeometryCache(const fs::path& fileCachePath, const std::string& key)
+  {
+    std::error_code ec;
+    const fs::file_time_type now = fs::file_time_type::clock::now();
+    for (fs::directory_iterator it(fileCachePath, ec), end; !ec && it != end; it.increment(ec))
+    {
+      const fs::path& entry = it->path();
+      if (entry.filename() == key)
+      {
+        continue;
+      }
+
+      if (entry.extension() == ".tmp")
+      {
+        std::error_code timeEc;
+        fs::file_time_type writeTime = fs::last_write_time(entry, timeEc);
+        if (timeEc || now - writeTime < std::chrono::hours(24))
+        {
+          continue;
+        }
+      }
+
+      log::debug("Removing outdated geometry cache ", entry.string());
+      std::error_code removeEc;
+      fs::remove_all(entry, removeEc);
+    }
+  }
+
+  /**
+   * Compute a key identifying the processed geometry of the provided file read with the
+   * provided reader, from the file path, size, modification time and content, the reader options
+   * and the F3D version. Only the start and the end of the file are hashed so that it stays cheap
+   * on large files.
+   */
+  static std::string ComputeGeometryCacheKey(const f3d::reader* reader, const fs::path& filePath)
+  {
+    vtksysMD5* md5 = vtksysMD5_New();
+    vtksysMD5_Initialize(md5);
+    auto append = [&](const std::string& str)
+    {
+      // prefix with the size so that consecutive strings cannot be confused
+      std::string sized = std::to_string(str.size()) + ":" + str;
+      vtksysMD5_Append(md5, reinterpret_cast<const unsigned char*>(sized.data()),
+        static_cast<int>(sized.size()));
+    };
+
+    std::error_code ec;
+    append(detail::LibVersionFull);
+    append(fs::absolute(filePath, ec).string());
+    append(reader->getName());
+    for (const auto& [name, value] : reader->getAllReaderOptions())
+    {
+      append(name);
+      append(value);
+    }
+
+    std::uintmax_t fileSize = fs::file_size(filePath, ec);
+    append(std::to_string(fileSize));
+    append(std::to_string(fs::last_write_time(filePath, ec).time_since_epoch().count()));
+
+    constexpr std::uintmax_t chunkSize = 1 << 20;
+    vtksys::ifstream file(filePath.string().c_str(), std::ios::binary);
+    const std::uintmax_t tailOffset = fileSize > chunkSize ? fileSize - chunkSize : 0;
+    for (std::uintmax_t offset : { std::uintmax_t(0), tailOffset })
+    {
+      std::string buffer(chunkSize, '\0');
+      file.clear();
+      file.seekg(static_cast<std::streamoff>(offset));
+      file.read(buffer.data(), static_cast<std::streamsize>(chunkSize));
+      buffer.resize(static_cast<size_t>(file.gcount()));
+      append(buffer);
+    }
+
+    unsigned char digest[16];
+    char md5Hash[33];
+    md5Hash[32] = '\0';
+    vtksysMD5_Finalize(md5, digest);
+    vtksysMD5_DigestToHex(digest, md5Hash);
+    vtksysMD5_Delete(md5);
+    return md5Hash;
+  }
+
+  /**
+   * Recover the reader to use for the provided file, taking the forced reader into account
+   * Throw a load_failure_exception if there is none
+   */
+  const f3d::reader* GetReader(const fs::path& filePath)
+  {
+    std::optional<std::string> forceReader = this->Options.scene.force_reader;
+    const f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string(), forceReader);
+    if (reader)
+    {
+      if (forceReader)
+      {
+        log::debug("Forcing reader ", (*forceReader), " for ", filePath.string());
+      }
+      else
+      {
+        log::debug("Found a reader for \"", filePath.string(), "\" : \"", reader->getName(), "\"");
+      }
+    }
+    else
+    {
+      if (forceReader)
+      {
+        throw scene::load_failure_exception(*forceReader + " is not a valid force reader");
+      }
+      throw scene::load_failure_exception(
+        filePath.string() + " is not a file of a supported 3D scene file format");
+    }
+
+    return reader;
+  }
+
+  /**
+   * Recover the importer of a preloaded file and remove it from the preloaded files.
+   * Wait for the file to be read if needed.
+   * Return nullptr if the file was not preloaded, was preloaded with another reader
+   * or has been modified since it was preloaded.
+   */
+  vtkSmartPointer<vtkImporter> TakePreloadedImporter(
+    const fs::path& filePath, const f3d::reader* reader)
+  {
+    auto it = this->PreloadedFiles.find(filePath);
+    if (it == this->PreloadedFiles.end())
+    {
+      return nullptr;
+    }
+    std::shared_ptr<PreloadedFile> file = it->second;
+    this->PreloadedFiles.erase(it);
+
+    if (file->Reader != reader || file->IsStale(filePath))
+    {
+      file->Cancel();
+      log::debug("Discarding outdated preloaded file ", filePath.string());
+      return nullptr;
+    }
+
+    file->Ready.wait();
+
+    // Messages of the preload workers are only displayed from this thread
+    F3DLog::FlushDeferredMessages();
+    log::debug("Using preloaded file ", filePath.string());
+    return file->Importer;
+  }
+
+  /**
+   * Join the preload workers that are done
+   */
+  void JoinFinishedPreloadWorkers()
+  {
+    for (auto it = this->PreloadWorkers.begin(); it != this->PreloadWorkers.end();)
+    {
+      if (it->Done.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+      {
+        it->Thread.join();
+        it = this->PreloadWorkers.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    F3DLog::FlushDeferredMessages();
+  }
+
   struct ProgressDataStruct
   {
     vtkTimerLog* timer;
@@ -87,20 +333,23 @@ public:
     data->timer->StartTimer();
   }
 
-  void Load(const std::vector<vtkSmartPointer<vtkImporter>>& importers)
+  void Load(const std::vector<vtkSmartPointer<vtkImporter>>& importers, bool resetCamera = true)
   {
     for (const vtkSmartPointer<vtkImporter>& importer : importers)
     {
       this->MetaImporter->AddImporter(importer);
     }
 
-    // Initialize the UpVector on load
-    this->Window.InitializeUpVector();
-
-    // Reset temporary up to apply any config values
-    if (this->Interactor)
+    if (resetCamera)
     {
-      this->Interactor->ResetTemporaryUp();
+      // Initialize the UpVector on load
+      this->Window.InitializeUpVector();
+
+      // Reset temporary up to apply any config values
+      if (this->Interactor)
+      {
+        this->Interactor->ResetTemporaryUp();
+      }
     }
 
     if (this->Options.scene.camera.index.has_value())
@@ -120,20 +369,22 @@ public:
         &callbackData, this->MetaImporter, this->Interactor);
     }
 
+    // max_memory option is in MiB
+    const std::optional<int>& maxMemory = this->Options.scene.max_memory;
+    this->MetaImporter->SetMemoryLimit(
+      maxMemory.has_value() && maxMemory.value() > 0 ? maxMemory.value() * 1024UL : 0UL);
+
     // Update the meta importer, the will only update importers that have not been updated before
-#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
     if (!this->MetaImporter->Update())
     {
       this->MetaImporter->RemoveObservers(vtkCommand::ProgressEvent);
       progressWidget->Off();
 
       this->MetaImporter->Clear();
+      this->FileImporters.clear();
       this->Window.Initialize();
       throw scene::load_failure_exception("failed to load scene");
     }
-#else
-    this->MetaImporter->Update();
-#endif
 
     // Remove anything progress related if any
     this->MetaImporter->RemoveObservers(vtkCommand::ProgressEvent);
@@ -144,7 +395,7 @@ public:
 
     // Update all window options and reset camera to bounds if needed
     this->Window.UpdateDynamicOptions();
-    if (!this->Options.scene.camera.index.has_value())
+    if (resetCamera && !this->Options.scene.camera.index.has_value())
     {
       this->Window.getCamera().resetToBounds();
     }
@@ -154,6 +405,11 @@ public:
 
   static void DisplayImporterDescription(log::VerboseLevel level, vtkImporter* importer)
   {
+    if (!log::isEnabled(level))
+    {
+      return;
+    }
+
     vtkIdType availCameras = importer->GetNumberOfCameras();
     if (availCameras <= 0)
     {
@@ -173,6 +429,12 @@ public:
 
   static void DisplayAllInfo(vtkImporter* importer, window_impl& window)
   {
+    // Descriptions are expensive to build, especially when called for each animation frame
+    if (!log::isEnabled(log::VerboseLevel::DEBUG))
+    {
+      return;
+    }
+
     // Display output description
     scene_impl::internals::DisplayImporterDescription(log::VerboseLevel::DEBUG, importer);
 
@@ -190,6 +452,47 @@ public:
   animationManager AnimationManager;
 
   vtkNew<vtkF3DMetaImporter> MetaImporter;
+
+  // Importer of each added file, used to reload a single file
+  std::map<fs::path, vtkImporter*> FileImporters;
+
+  struct PreloadedFile
+  {
+    const f3d::reader* Reader = nullptr;
+    vtkSmartPointer<vtkF3DGenericImporter> Importer;
+    std::atomic<bool> Cancelled = false;
+    std::promise<void> ReadyPromise;
+    std::shared_future<void> Ready;
+    fs::file_time_type WriteTime;
+    std::uintmax_t Size = 0;
+
+    /**
+     * Check if the file has been modified since it was preloaded
+     */
+    bool IsStale(const fs::path& filePath) const
+    {
+      std::error_code ec;
+      return fs::last_write_time(filePath, ec) != this->WriteTime ||
+        fs::file_size(filePath, ec) != this->Size;
+    }
+
+    /**
+     * Skip the file if it has not been read yet, stop reading it as soon as possible otherwise
+     */
+    void Cancel()
+    {
+      this->Cancelled = true;
+      this->Importer->CancelUpdate();
+    }
+  };
+  std::map<fs::path, std::shared_ptr<PreloadedFile>> PreloadedFiles;
+
+  struct PreloadWorker
+  {
+    std::thread Thread;
+    std::future<void> Done;
+  };
+  std::vector<PreloadWorker> PreloadWorkers;
 };
 
 //----------------------------------------------------------------------------
@@ -237,42 +540,15 @@ scene& scene_impl::add(const std::vector<fs::path>& filePaths)
     {
       throw scene::load_failure_exception(filePath.string() + " does not exists");
     }
-    std::optional<std::string> forceReader = this->Internals->Options.scene.force_reader;
-    // Recover the importer for the provided file path
-    const f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string(), forceReader);
-    if (reader)
-    {
-      if (forceReader)
-      {
-        log::debug("Forcing reader ", (*forceReader), " for ", filePath.string());
-      }
-      else
-      {
-        log::debug("Found a reader for \"", filePath.string(), "\" : \"", reader->getName(), "\"");
-      }
-    }
-    else
-    {
-      if (forceReader)
-      {
-        throw scene::load_failure_exception(*forceReader + " is not a valid force reader");
-      }
-      throw scene::load_failure_exception(
-        filePath.string() + " is not a file of a supported 3D scene file format");
-    }
-
-    vtkSmartPointer<vtkImporter> importer = reader->createSceneReader(filePath.string());
+    const f3d::reader* reader = this->Internals->GetReader(filePath);
+    vtkSmartPointer<vtkImporter> importer =
+      this->Internals->TakePreloadedImporter(filePath, reader);
     if (!importer)
     {
-      // XXX: F3D Plugin CMake logic ensure there is either a scene reader or a geometry reader
-      auto vtkReader = reader->createGeometryReader(filePath.string());
-      assert(vtkReader);
-      vtkSmartPointer<vtkF3DGenericImporter> genericImporter =
-        vtkSmartPointer<vtkF3DGenericImporter>::New();
-      genericImporter->SetInternalReader(vtkReader);
-      importer = genericImporter;
+      importer = this->Internals->CreateImporter(reader, filePath);
     }
     importers.emplace_back(importer);
+    this->Internals->FileImporters[filePath] = importer;
   }
 
   log::debug("\nLoading files: ");
@@ -293,6 +569,34 @@ scene& scene_impl::add(const std::vector<fs::path>& filePaths)
   return *this;
 }
 
+//----------------------------------------------------------------------------
+scene& scene_impl::reload(const fs::path& filePath)
+{
+  auto it = this->Internals->FileImporters.find(filePath);
+  if (it == this->Internals->FileImporters.end())
+  {
+    throw scene::load_failure_exception(filePath.string() + " has not been added to the scene");
+  }
+  if (!vtksys::SystemTools::FileExists(filePath.string(), true))
+  {
+    throw scene::load_failure_exception(filePath.string() + " does not exists");
+  }
+
+  // A preloaded importer would contain outdated data, always create a new one
+  const f3d::reader* reader = this->Internals->GetReader(filePath);
+  vtkSmartPointer<vtkImporter> importer =
+    this->Internals->CreateImporter(reader, filePath);
+  this->Internals->MetaImporter->ReplaceImporter(it->second, importer);
+  it->second = importer;
+
+  log::debug("\nReloading file: ", filePath.string());
+  log::debug("");
+
+  // Other files and the camera are kept as is
+  this->Internals->Load({}, false);
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 scene& scene_impl::add(const mesh_t& mesh)
 {
@@ -322,6 +626,7 @@ scene& scene_impl::clear()
 {
   // Clear the meta importer from all importers
   this->Internals->MetaImporter->Clear();
+  this->Internals->FileImporters.clear();
 
   // Clear the window of all actors
   this->Internals->Window.Initialize();
@@ -329,6 +634,91 @@ scene& scene_impl::clear()
   return *this;
 }
 
+//----------------------------------------------------------------------------
+scene& scene_impl::preload(const std::vector<fs::path>& filePaths)
+{
+  using PreloadedFile = scene_impl::internals::PreloadedFile;
+  std::map<fs::path, std::shared_ptr<PreloadedFile>> preloadedFiles;
+  std::vector<std::shared_ptr<PreloadedFile>> newFiles;
+  std::optional<std::string> forceReader = this->Internals->Options.scene.force_reader;
+
+  for (const fs::path& filePath : filePaths)
+  {
+    if (preloadedFiles.find(filePath) != preloadedFiles.end())
+    {
+      continue;
+    }
+
+    // Keep files that are already being preloaded, unless they have been modified since
+    auto it = this->Internals->PreloadedFiles.find(filePath);
+    if (it != this->Internals->PreloadedFiles.end() && !it->second->IsStale(filePath))
+    {
+      preloadedFiles.emplace(filePath, it->second);
+      this->Internals->PreloadedFiles.erase(it);
+      continue;
+    }
+
+    if (filePath.empty() || !vtksys::SystemTools::FileExists(filePath.string(), true))
+    {
+      continue;
+    }
+
+    // Scene readers need a renderer to read their file, only geometry readers can be preloaded
+    f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string(), forceReader);
+    if (!reader || reader->hasSceneReader() || !reader->hasGeometryReader())
+    {
+      continue;
+    }
+
+    auto file = std::make_shared<PreloadedFile>();
+    file->Reader = reader;
+    file->Importer = vtkF3DGenericImporter::SafeDownCast(
+      this->Internals->CreateImporter(reader, filePath));
+    file->Ready = file->ReadyPromise.get_future().share();
+    std::error_code ec;
+    file->WriteTime = fs::last_write_time(filePath, ec);
+    file->Size = fs::file_size(filePath, ec);
+    preloadedFiles.emplace(filePath, file);
+    newFiles.emplace_back(file);
+  }
+
+  // Discard stale files, their importers are released once their worker is done with them
+  for (const auto& [path, file] : this->Internals->PreloadedFiles)
+  {
+    file->Cancel();
+  }
+  this->Internals->PreloadedFiles = std::move(preloadedFiles);
+  this->Internals->JoinFinishedPreloadWorkers();
+
+  if (!newFiles.empty())
+  {
+    log::debug("Preloading ", newFiles.size(), " file(s) in the background");
+
+    std::promise<void> done;
+    scene_impl::internals::PreloadWorker worker;
+    worker.Done = done.get_future();
+    worker.Thread = std::thread(
+      [files = std::move(newFiles), done = std::move(done)]() mutable
+      {
+        // Printing is not thread safe, messages are printed by the main thread once it takes a
+        // preloaded file, SMP workers spawned by the readers still print immediately
+        F3DLog::SetDeferMessages(true);
+        for (const std::shared_ptr<PreloadedFile>& file : files)
+        {
+          if (!file->Cancelled)
+          {
+            file->Importer->PreUpdate();
+          }
+          file->ReadyPromise.set_value();
+        }
+        done.set_value();
+      });
+    this->Internals->PreloadWorkers.emplace_back(std::move(worker));
+  }
+
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 bool scene_impl::supports(const fs::path& filePath)
 {
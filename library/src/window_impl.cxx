@@ -7,19 +7,31 @@
 #include "options.h"
 #include "utils.h"
 
+#include "vtkF3DAccumulationPass.h"
 #include "vtkF3DExternalRenderWindow.h"
 
 #include "vtkF3DGenericImporter.h"
 #include "vtkF3DNoRenderWindow.h"
 #include "vtkF3DRenderer.h"
+#include "vtkF3DShaderCache.h"
 
+#if F3D_MODULE_UI
+#include "vtkF3DImguiConsole.h"
+#endif
+
+#include <vtkBoundingBox.h>
 #include <vtkCamera.h>
+#include <vtkCollection.h>
 #include <vtkF3DRenderPass.h>
 #include <vtkImageData.h>
 #include <vtkImageExport.h>
 #include <vtkInformation.h>
+#include <vtkMath.h>
+#include <vtkOpenGLRenderWindow.h>
 #include <vtkPNGReader.h>
 #include <vtkPointGaussianMapper.h>
+#include <vtkProp3D.h>
+#include <vtkPropCollection.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRendererCollection.h>
 #include <vtkRenderingOpenGLConfigure.h>
@@ -42,7 +54,10 @@
 #include <vtkOSOpenGLRenderWindow.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -97,6 +112,179 @@ public:
 #endif
   }
 
+  /**
+   * Compute the margin in pixels rendered around each tile of an output of the provided size,
+   * so that screen space effects reading neighbouring pixels are continuous across tiles.
+   * It is clamped to a quarter of the tile size.
+   */
+  int ComputeTileMargin(int tileSize, const int fullSize[2])
+  {
+    // FXAA only reads a few neighbouring pixels
+    double margin = 16.0;
+
+    // the bokeh blur of the background gathers the pixels of its circle of confusion
+    if (this->Options.render.background.blur.enable)
+    {
+      margin = std::max(margin, this->Options.render.background.blur.coc);
+    }
+
+    // the SSAO radius is a tenth of the bounding box diagonal, it is projected where it is the
+    // largest on screen, at the front of the bounding box
+    double bounds[6];
+    this->Renderer->ComputeVisiblePropBounds(bounds);
+    if (this->Options.render.effect.ambient_occlusion && vtkMath::AreBoundsInitialized(bounds))
+    {
+      vtkBoundingBox bbox(bounds);
+      const double diagonal = bbox.GetDiagonalLength();
+      vtkCamera* cam = this->Renderer->GetActiveCamera();
+
+      double viewSize = 0.0;
+      int viewPixels = fullSize[1];
+      if (cam->GetParallelProjection())
+      {
+        viewSize = 2.0 * cam->GetParallelScale();
+      }
+      else
+      {
+        double center[3];
+        bbox.GetCenter(center);
+        const double distance =
+          std::sqrt(vtkMath::Distance2BetweenPoints(cam->GetPosition(), center));
+        const double nearest = std::max(distance - 0.5 * diagonal, cam->GetClippingRange()[0]);
+        viewSize = 2.0 * nearest * std::tan(vtkMath::RadiansFromDegrees(cam->GetViewAngle()) / 2.0);
+        viewPixels = cam->GetUseHorizontalViewAngle() ? fullSize[0] : fullSize[1];
+      }
+
+      if (viewSize > 0.0)
+      {
+        margin = std::max(margin, 0.1 * diagonal / viewSize * viewPixels);
+      }
+    }
+
+    return static_cast<int>(std::ceil(std::min(margin, tileSize / 4.0)));
+  }
+
+  /**
+   * Render the window in tiles of at most tileSize pixels and assemble them in an image,
+   * so that the framebuffer never has the size of the output image.
+   * The camera frustum is restricted to each tile with a margin so that screen space effects
+   * are continuous across tiles. 2D props and additional renderers are not rendered.
+   */
+  image RenderTiles(window_impl& window, bool noBackground, int tileSize)
+  {
+    const int fullSize[2] = { this->RenWin->GetSize()[0], this->RenWin->GetSize()[1] };
+    const int margin = this->ComputeTileMargin(tileSize, fullSize);
+    const int content = tileSize - 2 * margin;
+    const int contentSize[2] = { std::min(content, fullSize[0]), std::min(content, fullSize[1]) };
+    const int tileWindowSize[2] = { contentSize[0] + 2 * margin, contentSize[1] + 2 * margin };
+    const unsigned int channels = noBackground ? 4 : 3;
+
+    if (noBackground)
+    {
+      // we need to set the background to black to avoid blending issues with translucent
+      // objects when saving to file with no background
+      this->Renderer->SetBackground(0, 0, 0);
+    }
+
+    // 2D props and overlay renderers like the axis widget would be repeated in every tile
+    std::vector<vtkProp*> hiddenProps;
+    vtkPropCollection* props = this->Renderer->GetViewProps();
+    vtkCollectionSimpleIterator pit;
+    props->InitTraversal(pit);
+    while (vtkProp* prop = props->GetNextProp(pit))
+    {
+      if (!vtkProp3D::SafeDownCast(prop) && prop->GetVisibility())
+      {
+        prop->VisibilityOff();
+        hiddenProps.emplace_back(prop);
+      }
+    }
+    std::vector<vtkRenderer*> hiddenRenderers;
+    vtkRendererCollection* renderers = this->RenWin->GetRenderers();
+    vtkCollectionSimpleIterator rit;
+    renderers->InitTraversal(rit);
+    while (vtkRenderer* ren = renderers->GetNextRenderer(rit))
+    {
+      if (ren != this->Renderer && ren->GetDraw())
+      {
+        ren->DrawOff();
+        hiddenRenderers.emplace_back(ren);
+      }
+    }
+
+    vtkCamera* cam = this->Renderer->GetActiveCamera();
+    const double viewAngle = cam->GetViewAngle();
+    const double parallelScale = cam->GetParallelScale();
+    double windowCenter[2];
+    cam->GetWindowCenter(windowCenter);
+
+    this->RenWin->SetSize(tileWindowSize[0], tileWindowSize[1]);
+
+    image output(fullSize[0], fullSize[1], channels);
+    unsigned char* outputData = static_cast<unsigned char*>(output.getContent());
+
+    for (int y0 = 0; y0 < fullSize[1]; y0 += contentSize[1])
+    {
+      for (int x0 = 0; x0 < fullSize[0]; x0 += contentSize[0])
+      {
+        // restrict the frustum to the tile and its margin, window center is in [-1, 1]
+        const double scale[2] = { static_cast<double>(tileWindowSize[0]) / fullSize[0],
+          static_cast<double>(tileWindowSize[1]) / fullSize[1] };
+        const double center[2] = {
+          (x0 - margin + 0.5 * tileWindowSize[0]) / fullSize[0] * 2.0 - 1.0,
+          (y0 - margin + 0.5 * tileWindowSize[1]) / fullSize[1] * 2.0 - 1.0
+        };
+        const double angleScale = cam->GetUseHorizontalViewAngle() ? scale[0] : scale[1];
+        cam->SetParallelScale(parallelScale * scale[1]);
+        cam->SetViewAngle(vtkMath::DegreesFromRadians(
+          2.0 * std::atan(std::tan(vtkMath::RadiansFromDegrees(viewAngle) / 2.0) * angleScale)));
+        cam->SetWindowCenter(
+          (windowCenter[0] + center[0]) / scale[0], (windowCenter[1] + center[1]) / scale[1]);
+
+        this->RenWin->Render();
+        while (window.RenderAccumulationStep())
+        {
+        }
+
+        vtkNew<vtkWindowToImageFilter> rtW2if;
+        rtW2if->SetInput(this->RenWin);
+        rtW2if->ShouldRerenderOff();
+        if (noBackground)
+        {
+          rtW2if->SetInputBufferTypeToRGBA();
+        }
+        rtW2if->Update();
+
+        // copy the tile without its margin, rows start from the bottom in both images
+        const unsigned char* tileData =
+          static_cast<const unsigned char*>(rtW2if->GetOutput()->GetScalarPointer());
+        const int width = std::min(contentSize[0], fullSize[0] - x0);
+        const int height = std::min(contentSize[1], fullSize[1] - y0);
+        for (int j = 0; j < height; j++)
+        {
+          std::copy_n(tileData + ((j + margin) * tileWindowSize[0] + margin) * channels,
+            width * channels,
+            outputData + ((y0 + j) * static_cast<size_t>(fullSize[0]) + x0) * channels);
+        }
+      }
+    }
+
+    cam->SetViewAngle(viewAngle);
+    cam->SetParallelScale(parallelScale);
+    cam->SetWindowCenter(windowCenter[0], windowCenter[1]);
+    this->RenWin->SetSize(fullSize[0], fullSize[1]);
+    for (vtkProp* prop : hiddenProps)
+    {
+      prop->VisibilityOn();
+    }
+    for (vtkRenderer* ren : hiddenRenderers)
+    {
+      ren->DrawOn();
+    }
+
+    return output;
+  }
+
   std::unique_ptr<camera_impl> Camera;
   vtkSmartPointer<vtkRenderWindow> RenWin;
   vtkNew<vtkF3DRenderer> Renderer;
@@ -385,6 +573,16 @@ void window_impl::UpdateDynamicOptions()
 
   const options& opt = this->Internals->Options;
 
+  // Only F3D render windows provide a shader cache storing program binaries
+  vtkOpenGLRenderWindow* glRenWin = vtkOpenGLRenderWindow::SafeDownCast(this->Internals->RenWin);
+  vtkF3DShaderCache* shaderCache =
+    glRenWin ? vtkF3DShaderCache::SafeDownCast(glRenWin->GetShaderCache()) : nullptr;
+  if (shaderCache)
+  {
+    shaderCache->SetCacheDirectory(
+      opt.render.shader_cache ? (this->Internals->CachePath / "shaders").string() : "");
+  }
+
   if (this->Internals->Interactor)
   {
     renderer->ShowAxis(opt.ui.axis);
@@ -400,6 +598,12 @@ void window_impl::UpdateDynamicOptions()
     : vtkF3DRenderer::SplatType::SPHERE;
   renderer->SetPointSpritesProperties(splatType, pointSpritesSize);
 
+  // budget option is in MiB
+  const vtkIdType pointSpritesBudget =
+    static_cast<vtkIdType>(opt.model.point_sprites.streaming.budget) * 1024 * 1024;
+  renderer->SetPointSpritesMemoryBudget(
+    opt.model.point_sprites.streaming.enable ? pointSpritesBudget : 0);
+
   renderer->SetLineWidth(opt.render.line_width);
   renderer->SetPointSize(opt.render.point_size);
   renderer->ShowEdge(opt.render.show_edges);
@@ -410,6 +614,13 @@ void window_impl::UpdateDynamicOptions()
   renderer->ShowCheatSheet(opt.ui.cheatsheet);
   renderer->ShowConsole(opt.ui.console);
   renderer->ShowMinimalConsole(opt.ui.minimal_console);
+#if F3D_MODULE_UI
+  vtkF3DImguiConsole* console = vtkF3DImguiConsole::SafeDownCast(vtkOutputWindow::GetInstance());
+  if (console)
+  {
+    console->SetMaxNumberOfLogs(static_cast<size_t>(std::max(opt.ui.console_max_logs, 1)));
+  }
+#endif
   renderer->ShowDropZone(opt.ui.drop_zone.enable);
   renderer->SetDropZoneInfo(opt.ui.drop_zone.info);
   renderer->ShowDropZoneLogo(opt.ui.drop_zone.show_logo);
@@ -435,6 +646,7 @@ void window_impl::UpdateDynamicOptions()
   F3D_SILENT_WARNING_POP()
 
   renderer->ShowArmature(opt.render.armature.enable);
+  renderer->SetLODTriangleBudget(opt.render.lod.enable ? opt.render.lod.triangle_budget : 0);
 
   renderer->SetUseRaytracing(opt.render.raytracing.enable);
   renderer->SetRaytracingSamples(opt.render.raytracing.samples);
@@ -464,10 +676,14 @@ void window_impl::UpdateDynamicOptions()
     {
       aaMode = vtkF3DRenderer::AntiAliasingMode::SSAA;
     }
+    else if (opt.render.effect.antialiasing.mode == "taa")
+    {
+      aaMode = vtkF3DRenderer::AntiAliasingMode::TAA;
+    }
     else
     {
       log::warn(opt.render.effect.antialiasing.mode,
-        R"( is an invalid antialiasing mode. Valid modes are: "fxaa", "ssaa")");
+        R"( is an invalid antialiasing mode. Valid modes are: "fxaa", "ssaa", "taa")");
     }
   }
 
@@ -477,6 +693,9 @@ void window_impl::UpdateDynamicOptions()
   renderer->SetUseDepthPeelingPass(opt.render.effect.translucency_support);
   renderer->SetBackfaceType(opt.render.backface_type);
   renderer->SetFinalShader(opt.render.effect.final_shader);
+  renderer->SetUseDynamicResolution(opt.render.dynamic_resolution.enable);
+  renderer->SetDynamicResolutionTargetFrameRate(opt.render.dynamic_resolution.frame_rate);
+  renderer->SetDynamicResolutionMinimumScale(opt.render.dynamic_resolution.min_scale);
 
   renderer->SetBackground(opt.render.background.color.data());
   renderer->SetUseBlurBackground(opt.render.background.blur.enable);
@@ -557,12 +776,20 @@ void window_impl::UpdateDynamicOptions()
 //----------------------------------------------------------------------------
 void window_impl::PrintSceneDescription(log::VerboseLevel level)
 {
+  if (!log::isEnabled(level))
+  {
+    return;
+  }
   log::print(level, this->Internals->Renderer->GetSceneDescription());
 }
 
 //----------------------------------------------------------------------------
 void window_impl::PrintColoringDescription(log::VerboseLevel level)
 {
+  if (!log::isEnabled(level))
+  {
+    return;
+  }
   std::string descr = this->Internals->Renderer->GetColoringDescription();
   if (!descr.empty())
   {
@@ -587,6 +814,22 @@ bool window_impl::render()
 //----------------------------------------------------------------------------
 image window_impl::renderToImage(bool noBackground)
 {
+  // smaller tiles would mostly contain their margin
+  constexpr int minimumTileSize = 128;
+  int tileSize = this->Internals->Options.render.output_tile_size;
+  if (tileSize > 0 && tileSize < minimumTileSize)
+  {
+    log::warn("render.output_tile_size ", tileSize, " is too small, using ", minimumTileSize,
+      " instead");
+    tileSize = minimumTileSize;
+  }
+  const int* size = this->Internals->RenWin->GetSize();
+  if (tileSize > 0 && (size[0] > tileSize || size[1] > tileSize))
+  {
+    this->UpdateDynamicOptions();
+    return this->Internals->RenderTiles(*this, noBackground, tileSize);
+  }
+
   this->render();
 
   vtkNew<vtkWindowToImageFilter> rtW2if;
@@ -600,6 +843,17 @@ image window_impl::renderToImage(bool noBackground)
     rtW2if->SetInputBufferTypeToRGBA();
   }
 
+  if (this->Internals->Renderer->NeedsAccumulationStep())
+  {
+    // restart the progressive anti-aliasing with the final background and let it converge,
+    // the filter must then read the pixels without rendering again
+    this->Internals->RenWin->Render();
+    while (this->RenderAccumulationStep())
+    {
+    }
+    rtW2if->ShouldRerenderOff();
+  }
+
   vtkNew<vtkImageExport> exporter;
   exporter->SetInputConnection(rtW2if->GetOutputPort());
   exporter->ImageLowerLeftOn();
@@ -640,6 +894,12 @@ void window_impl::SetCachePath(const fs::path& cachePath)
   this->Internals->CachePath = cachePath;
 }
 
+//----------------------------------------------------------------------------
+const fs::path& window_impl::GetCachePath() const
+{
+  return this->Internals->CachePath;
+}
+
 //----------------------------------------------------------------------------
 void window_impl::SetInteractor(interactor_impl* interactor)
 {
@@ -660,4 +920,20 @@ void window_impl::RenderUIOnly()
   info->Remove(vtkF3DRenderPass::RENDER_UI_ONLY());
 #endif
 }
+
+//----------------------------------------------------------------------------
+bool window_impl::RenderAccumulationStep()
+{
+  vtkF3DRenderer* renderer = this->Internals->Renderer;
+  if (!renderer->NeedsAccumulationStep())
+  {
+    return false;
+  }
+
+  vtkInformation* info = renderer->GetInformation();
+  info->Set(vtkF3DAccumulationPass::ACCUMULATE(), 1);
+  this->Internals->RenWin->Render();
+  info->Remove(vtkF3DAccumulationPass::ACCUMULATE());
+  return true;
+}
 };
@@ -0,0 +1,100 @@
+#include "PseudoUnitTest.h"
+
+#include <engine.h>
+#include <log.h>
+#include <options.h>
+#include <scene.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+// Names of the directories in the provided directory
+std::set<std::string> ListDirectories(const fs::path& path)
+{
+  std::set<std::string> names;
+  std::error_code ec;
+  for (const fs::directory_entry& entry : fs::directory_iterator(path, ec))
+  {
+    if (entry.is_directory())
+    {
+      names.insert(entry.path().filename().string());
+    }
+  }
+  return names;
+}
+
+void WriteTriangle(const std::string& path, const std::string& vertices)
+{
+  std::ofstream file(path);
+  file << "solid triangle\nfacet normal 0 0 1\nouter loop\n"
+       << vertices << "endloop\nendfacet\nendsolid triangle\n";
+}
+}
+
+int TestSDKGeometryCache(int argc, char* argv[])
+{
+  PseudoUnitTest test;
+
+  // Generate a random cache path to avoid reusing any existing cache
+  std::random_device r;
+  std::default_random_engine e1(r());
+  std::uniform_int_distribution<int> dist(1, 100000);
+  fs::path cachePath = fs::path(argv[2]) / ("cache_" + std::to_string(dist(e1)));
+  fs::path geometryPath = cachePath / "geometry";
+
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+  f3d::engine eng = f3d::engine::create(true);
+  eng.setCachePath(cachePath.string());
+  eng.getOptions().scene.geometry_cache = true;
+  f3d::scene& sce = eng.getScene();
+
+  std::string triangle = std::string(argv[2]) + "TestSDKGeometryCache.stl";
+  ::WriteTriangle(triangle, "vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n");
+  test("add a file with the geometry cache", [&]() { sce.add(triangle); });
+
+  std::set<std::string> files = ::ListDirectories(geometryPath);
+  test("geometry cache is grouped by file", files.size() == 1);
+  if (files.size() != 1)
+  {
+    return test.result();
+  }
+  fs::path fileCachePath = geometryPath / *files.begin();
+  std::set<std::string> entries = ::ListDirectories(fileCachePath);
+  test("geometry cache is written", entries.size() == 1);
+
+  // an interrupted write of another process is kept while recent and removed once old
+  fs::path recentTmp = fileCachePath / "interrupted.1.tmp";
+  fs::path oldTmp = fileCachePath / "interrupted.2.tmp";
+  fs::create_directories(recentTmp);
+  fs::create_directories(oldTmp);
+  fs::last_write_time(oldTmp, fs::last_write_time(oldTmp) - std::chrono::hours(48));
+
+  // a modified file replaces its outdated geometry in the cache
+  ::WriteTriangle(triangle, "vertex 0 0 0\nvertex 1 0 0\nvertex 1 1 0\n");
+  fs::last_write_time(triangle, fs::last_write_time(triangle) + std::chrono::hours(1));
+  test("add a modified file with the geometry cache", [&]() { sce.clear().add(triangle); });
+
+  std::set<std::string> newEntries = ::ListDirectories(fileCachePath);
+  newEntries.erase(recentTmp.filename().string());
+  test("outdated geometry cache is removed", newEntries.size() == 1 && newEntries != entries);
+  test("recent temporary directory is kept", fs::exists(recentTmp));
+  test("old temporary directory is removed", !fs::exists(oldTmp));
+
+  // the geometries of other files are kept
+  std::string otherTriangle = std::string(argv[2]) + "TestSDKGeometryCacheOther.stl";
+  ::WriteTriangle(otherTriangle, "vertex 0 0 0\nvertex 0 1 0\nvertex 0 0 1\n");
+  test("add another file with the geometry cache", [&]() { sce.clear().add(otherTriangle); });
+  newEntries.insert(recentTmp.filename().string());
+  test("geometry cache of other files is kept",
+    ::ListDirectories(geometryPath).size() == 2 &&
+      ::ListDirectories(fileCachePath) == newEntries);
+
+  return test.result();
+}
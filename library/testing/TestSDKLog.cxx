@@ -1,5 +1,22 @@
 #include <log.h>
 
+#include <iostream>
+
+namespace
+{
+// Count how many times it is formatted
+struct FormatCounter
+{
+  int& Count;
+};
+
+std::ostream& operator<<(std::ostream& os, const FormatCounter& counter)
+{
+  counter.Count++;
+  return os;
+}
+}
+
 int TestSDKLog(int argc, char* argv[])
 {
   f3d::log::setUseColoring(false);
@@ -51,5 +68,27 @@ int TestSDKLog(int argc, char* argv[])
   f3d::log::warn("Test Warning Coloring");
   f3d::log::error("Test Error Coloring");
 
+  // Disabled levels must not format their arguments
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::WARN);
+  if (f3d::log::isEnabled(f3d::log::VerboseLevel::INFO) ||
+    !f3d::log::isEnabled(f3d::log::VerboseLevel::WARN) ||
+    f3d::log::isEnabled(f3d::log::VerboseLevel::QUIET))
+  {
+    std::cerr << "Unexpected isEnabled result\n";
+    return EXIT_FAILURE;
+  }
+
+  int formatCount = 0;
+  ::FormatCounter counter{ formatCount };
+  f3d::log::debug("Test Debug Counter ", counter);
+  f3d::log::info("Test Info Counter ", counter);
+  f3d::log::print(f3d::log::VerboseLevel::INFO, "Test Print Counter ", counter);
+  f3d::log::print(f3d::log::VerboseLevel::QUIET, "Test Print Counter ", counter);
+  if (formatCount != 0)
+  {
+    std::cerr << "Disabled logs formatted their arguments " << formatCount << " times\n";
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,53 @@
+#include <engine.h>
+#include <options.h>
+#include <scene.h>
+#include <window.h>
+
+#include "TestSDKHelpers.h"
+
+int TestSDKRenderTiled(int argc, char* argv[])
+{
+  f3d::engine eng = f3d::engine::create(true);
+
+  f3d::options& options = eng.getOptions();
+  options.render.output_tile_size = 200;
+  options.render.effect.final_shader = R"=(
+    vec4 pixel(vec2 uv)
+    {
+        vec3 value = texture(source, uv).rgb;
+        return vec4(vec3(1.0) - value, 1.0);
+    }
+  )=";
+
+  f3d::window& win = eng.getWindow();
+  win.setSize(300, 300);
+
+  f3d::scene& sce = eng.getScene();
+  sce.add(std::string(argv[1]) + "/data/cow.vtp");
+
+  // the output is assembled from 2x2 tiles with a 16 pixels margin
+  // and must match the regular rendering
+  if (!TestSDKHelpers::RenderTest(
+        win, std::string(argv[1]) + "baselines/", std::string(argv[2]), "TestSDKRenderTiled"))
+  {
+    std::cerr << "Tiled rendering failure";
+    return EXIT_FAILURE;
+  }
+
+  // smaller tile sizes are clamped to 128 pixels, the output is assembled from 4x4 tiles
+  options.render.output_tile_size = 50;
+  if (!TestSDKHelpers::RenderTest(
+        win, std::string(argv[1]) + "baselines/", std::string(argv[2]), "TestSDKRenderTiled"))
+  {
+    std::cerr << "Tiled rendering with a clamped tile size failure";
+    return EXIT_FAILURE;
+  }
+
+  if (win.getWidth() != 300 || win.getHeight() != 300)
+  {
+    std::cerr << "Window size was not restored after tiled rendering";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
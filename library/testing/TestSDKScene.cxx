@@ -6,6 +6,9 @@
 #include <scene.h>
 #include <window.h>
 
+#include <chrono>
+#include <fstream>
+
 namespace fs = std::filesystem;
 
 int TestSDKScene(int argc, char* argv[])
@@ -43,6 +46,17 @@ int TestSDKScene(int argc, char* argv[])
   test("supported with default scene format", sce.supports(cube));
   test("supported with full scene format", sce.supports(logo));
 
+  // content sniffing of an extensionless file
+  std::string sniffed = std::string(argv[2]) + "TestSDKSceneSniffed";
+  {
+    std::ofstream sniffedFile(sniffed);
+    sniffedFile << "solid triangle\n"
+                   "facet normal 0 0 1\nouter loop\n"
+                   "vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n"
+                   "endloop\nendfacet\nendsolid triangle\n";
+  }
+  test("supported with extensionless file", sce.supports(sniffed));
+
   // add error code paths
   test.expect<f3d::scene::load_failure_exception>("add with dummy file", [&]() { sce.add(dummy); });
   test.expect<f3d::scene::load_failure_exception>(
@@ -54,9 +68,15 @@ int TestSDKScene(int argc, char* argv[])
   test("add with empty file", [&]() { sce.add(std::vector<std::string>{}); });
   test("add with empty file", [&]() { sce.add(empty); });
   test("add with a single path", [&]() { sce.add(fs::path(logo)); });
+  test("preload files", [&]() { sce.preload({ fs::path(cube), fs::path(unsupported) }); });
   test("add with multiples filepaths", [&]() { sce.add({ fs::path(sphere2), fs::path(cube) }); });
   test("add with multiples file strings", [&]() { sce.add({ sphere1, world }); });
 
+  // reload code paths
+  test.expect<f3d::scene::load_failure_exception>(
+    "reload a file not added", [&]() { sce.reload(fs::path(dummy)); });
+  test("reload an added file", [&]() { sce.reload(fs::path(cube)); });
+
   // render test
   test("render after add", [&]() {
     if (!TestSDKHelpers::RenderTest(
@@ -66,5 +86,41 @@ int TestSDKScene(int argc, char* argv[])
     }
   });
 
+  // reloading a file rewritten on disk displays its new content
+  std::string rewritten = std::string(argv[2]) + "TestSDKSceneReload.stl";
+  auto writeTriangle = [&](const std::string& vertices)
+  {
+    std::ofstream rewrittenFile(rewritten);
+    rewrittenFile << "solid triangle\nfacet normal 0 0 1\nouter loop\n" << vertices
+                  << "endloop\nendfacet\nendsolid triangle\n";
+  };
+  writeTriangle("vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n");
+  test("add a file before rewriting it", [&]() { sce.clear().add(rewritten); });
+  f3d::image beforeReload = win.renderToImage();
+  writeTriangle("vertex 0 0 0\nvertex 1 0 0\nvertex 1 1 0\n");
+  test("reload a rewritten file", [&]() { sce.reload(rewritten); });
+  test("reload displays the new content", win.renderToImage() != beforeReload);
+
+  // a preloaded file modified before being added is read again
+  writeTriangle("vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n");
+  test("preload a file before rewriting it", [&]() { sce.preload({ fs::path(rewritten) }); });
+  writeTriangle("vertex 0 0 0\nvertex 1 0 0\nvertex 1 1 0\n");
+  fs::last_write_time(rewritten, fs::last_write_time(rewritten) + std::chrono::hours(1));
+  test("add a file modified after its preload", [&]() { sce.clear().add(rewritten); });
+  f3d::image afterPreload = win.renderToImage();
+  test("add a file without preload", [&]() { sce.clear().add(rewritten); });
+  test("stale preloaded file is discarded",
+    afterPreload != beforeReload && win.renderToImage() == afterPreload);
+
+  // an extensionless file identified from its content can be added
+  test("add an extensionless file", [&]() { sce.clear().add(sniffed); });
+
+  // a rewritten extensionless file is identified again
+  {
+    std::ofstream sniffedFile(sniffed);
+    sniffedFile << "not a supported format\n";
+  }
+  test("supported with rewritten extensionless file", !sce.supports(sniffed));
+
   return test.result();
 }
@@ -0,0 +1,95 @@
+#include <engine.h>
+#include <log.h>
+#include <options.h>
+#include <scene.h>
+#include <window.h>
+
+#include "TestSDKHelpers.h"
+
+#include <filesystem>
+#include <map>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+// Program binaries stored in the cache and their modification time
+std::map<fs::path, fs::file_time_type> ListProgramBinaries(const fs::path& shadersPath)
+{
+  std::map<fs::path, fs::file_time_type> binaries;
+  std::error_code ec;
+  for (const fs::directory_entry& entry : fs::directory_iterator(shadersPath, ec))
+  {
+    if (entry.path().extension() == ".bin")
+    {
+      binaries[entry.path()] = entry.last_write_time();
+    }
+  }
+  return binaries;
+}
+}
+
+int TestSDKShaderCache(int argc, char* argv[])
+{
+  // Generate a random cache path to avoid reusing any existing cache
+  std::random_device r;
+  std::default_random_engine e1(r());
+  std::uniform_int_distribution<int> dist(1, 100000);
+  std::string cachePath = std::string(argv[2]) + "/cache_" + std::to_string(dist(e1));
+
+  const std::string negativeShader = R"=(
+    vec4 pixel(vec2 uv)
+    {
+        vec3 value = texture(source, uv).rgb;
+        return vec4(vec3(1.0) - value, 1.0);
+    }
+  )=";
+
+  // Cache hits and misses are printed in the debug output, hits are checked by the test regex
+  f3d::log::setVerboseLevel(f3d::log::VerboseLevel::DEBUG);
+
+  // First engine compiles the programs and fills the cache,
+  // second engine loads them from the cache, both must render the same image
+  std::map<fs::path, fs::file_time_type> binaries;
+  for (const std::string& pass : { "fill", "reuse" })
+  {
+    f3d::engine eng = f3d::engine::create(true);
+    eng.setCachePath(cachePath);
+
+    f3d::options& options = eng.getOptions();
+    options.render.shader_cache = true;
+    options.render.effect.final_shader = negativeShader;
+
+    f3d::window& win = eng.getWindow();
+    win.setSize(300, 300);
+
+    f3d::scene& sce = eng.getScene();
+    sce.add(std::string(argv[1]) + "/data/cow.vtp");
+
+    if (!TestSDKHelpers::RenderTest(win, std::string(argv[1]) + "baselines/",
+          std::string(argv[2]), "TestSDKShaderCache"))
+    {
+      std::cerr << "Shader cache " << pass << " failure\n";
+      return EXIT_FAILURE;
+    }
+
+    if (binaries.empty())
+    {
+      binaries = ::ListProgramBinaries(fs::path(cachePath) / "shaders");
+      if (binaries.empty())
+      {
+        std::cerr << "Shader cache fill failure: no program binary in " << cachePath << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+    else if (::ListProgramBinaries(fs::path(cachePath) / "shaders") != binaries)
+    {
+      // a miss would have compiled a program and written its binary again
+      std::cerr << "Shader cache reuse failure: program binaries were written again\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
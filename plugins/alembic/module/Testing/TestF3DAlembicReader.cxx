@@ -1,9 +1,22 @@
 #include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 #include <vtkTestUtilities.h>
 
 #include "vtkF3DAlembicReader.h"
 
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#endif
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcGeom/All.h>
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
 #include <iostream>
+#include <vector>
 
 int TestF3DAlembicReader(int vtkNotUsed(argc), char* argv[])
 {
@@ -12,5 +25,87 @@ int TestF3DAlembicReader(int vtkNotUsed(argc), char* argv[])
   reader->SetFileName(filename);
   reader->Update();
   reader->Print(cout);
-  return reader->GetOutput() ? EXIT_SUCCESS : EXIT_FAILURE;
+  if (!reader->GetOutput())
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Write a triangle moving along X with a constant topology
+  std::string animFilename = std::string(argv[2]) + "/TestF3DAlembicReaderAnimated.abc";
+  {
+    Alembic::Abc::OArchive archive(Alembic::AbcCoreOgawa::WriteArchive(), animFilename);
+    uint32_t timeSampling = archive.addTimeSampling(Alembic::AbcGeom::TimeSampling(1.0, 0.0));
+    Alembic::AbcGeom::OPolyMesh mesh(archive.getTop(), "triangle", timeSampling);
+    Alembic::AbcGeom::OPolyMeshSchema& schema = mesh.getSchema();
+
+    const std::vector<int32_t> indices = { 0, 1, 2 };
+    const std::vector<int32_t> counts = { 3 };
+    for (int t = 0; t < 3; t++)
+    {
+      const float x = static_cast<float>(t);
+      const std::vector<Alembic::Abc::V3f> positions = { Alembic::Abc::V3f(x, 0, 0),
+        Alembic::Abc::V3f(x + 1, 0, 0), Alembic::Abc::V3f(x, 1, 0) };
+      Alembic::AbcGeom::OPolyMeshSchema::Sample sample(
+        Alembic::AbcGeom::P3fArraySample(positions));
+      if (t == 0)
+      {
+        sample.setFaceIndices(Alembic::AbcGeom::Int32ArraySample(indices));
+        sample.setFaceCounts(Alembic::AbcGeom::Int32ArraySample(counts));
+      }
+      schema.set(sample);
+    }
+  }
+
+  // Check that updating an animated file through time gives the same result as a fresh read
+  vtkNew<vtkF3DAlembicReader> animReader;
+  animReader->SetFileName(animFilename);
+  animReader->UpdateTimeStep(0.0);
+  vtkSmartPointer<vtkPolyData> firstOutput = vtkSmartPointer<vtkPolyData>::New();
+  firstOutput->ShallowCopy(animReader->GetOutput());
+  double firstPoint[3];
+  firstOutput->GetPoint(0, firstPoint);
+  animReader->UpdateTimeStep(1.0);
+
+  // The second time step only refills the positions
+  if (animReader->GetNumberOfPositionsUpdates() != 1)
+  {
+    std::cerr << "Positions were not updated in place of a full conversion" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The previous output is not modified
+  double point[3];
+  firstOutput->GetPoint(0, point);
+  if (point[0] != firstPoint[0] || point[0] != 0.0)
+  {
+    std::cerr << "Previous output was modified by a time change" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkF3DAlembicReader> freshReader;
+  freshReader->SetFileName(animFilename);
+  freshReader->UpdateTimeStep(1.0);
+
+  vtkPolyData* animOutput = animReader->GetOutput();
+  vtkPolyData* freshOutput = freshReader->GetOutput();
+  if (animOutput->GetNumberOfPoints() != freshOutput->GetNumberOfPoints() ||
+    animOutput->GetNumberOfCells() != freshOutput->GetNumberOfCells())
+  {
+    std::cerr << "Unexpected geometry after a time change" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (vtkIdType i = 0; i < animOutput->GetNumberOfPoints(); i++)
+  {
+    double p1[3], p2[3];
+    animOutput->GetPoint(i, p1);
+    freshOutput->GetPoint(i, p2);
+    if (p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2])
+    {
+      std::cerr << "Unexpected point position after a time change" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
 }
@@ -11,6 +11,8 @@
 #include <vtkSmartPointer.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 
+#include <numeric>
+
 #if defined(_MSC_VER)
 #pragma warning(push, 0)
 #endif
@@ -43,6 +45,21 @@ struct IntermediateGeometry
   bool nFaceVarying = false;
 };
 
+/**
+ * Per mesh data kept after a full conversion so that later time samples of a mesh
+ * with a constant topology only need their positions to be refilled.
+ */
+struct MeshCache
+{
+  Alembic::AbcGeom::IPolyMesh Mesh;
+
+  // Index in the sample positions of each output point, after face-varying expansion
+  IndicesContainer PointMap;
+
+  // First point of this mesh in the appended output
+  vtkIdType PointOffset = 0;
+};
+
 class vtkF3DAlembicReader::vtkInternals
 {
   void SetupIndicesStorage(const Alembic::AbcGeom::Int32ArraySamplePtr& faceVertexCounts,
@@ -238,9 +255,54 @@ class vtkF3DAlembicReader::vtkInternals
     }
   }
 
+  void FillPointMap(const IntermediateGeometry& data, IndicesContainer& pointMap)
+  {
+    pointMap.clear();
+    auto pMapIter = data.Attributes.find("P");
+    if (pMapIter == data.Attributes.end())
+    {
+      return;
+    }
+
+    if (data.uvFaceVarying || data.nFaceVarying)
+    {
+      // Points have been duplicated per face corner
+      for (const auto& faceIndices : data.Indices)
+      {
+        for (const auto& index : faceIndices)
+        {
+          pointMap.emplace_back(index.x);
+        }
+      }
+    }
+    else
+    {
+      pointMap.resize(pMapIter->second.size());
+      std::iota(pointMap.begin(), pointMap.end(), 0);
+    }
+  }
+
+  /**
+   * Check if only the positions of a mesh can change over time,
+   * meaning its topology and its attributes are constant.
+   */
+  static bool HasConstantTopology(const Alembic::AbcGeom::IPolyMesh& pmesh)
+  {
+    const Alembic::AbcGeom::IPolyMeshSchema& schema = pmesh.getSchema();
+    if (schema.getTopologyVariance() == Alembic::AbcGeom::kHeterogenousTopology)
+    {
+      return false;
+    }
+
+    Alembic::AbcGeom::IV2fGeomParam uvsParam = schema.getUVsParam();
+    Alembic::AbcGeom::IN3fGeomParam normalsParam = schema.getNormalsParam();
+    return (!uvsParam.valid() || uvsParam.isConstant()) &&
+      (!normalsParam.valid() || normalsParam.isConstant());
+  }
+
 public:
   vtkSmartPointer<vtkPolyData> ProcessIPolyMesh(
-    const Alembic::AbcGeom::IPolyMesh& pmesh, double time)
+    const Alembic::AbcGeom::IPolyMesh& pmesh, double time, IndicesContainer& pointMap)
   {
     vtkNew<vtkPolyData> polydata;
     IntermediateGeometry originalData;
@@ -340,6 +402,7 @@ public:
     this->PointDuplicateAccumulator(originalData, duplicatedData);
 
     this->FillPolyData(duplicatedData, polydata);
+    this->FillPointMap(originalData, pointMap);
 
     return polydata;
   }
@@ -377,8 +440,24 @@ public:
   {
     Alembic::Abc::IObject top = this->Archive.getTop();
 
+    this->MeshCaches.clear();
+    this->ConstantTopology = true;
+    vtkIdType pointOffset = 0;
+
     auto appendMesh = [&](const Alembic::AbcGeom::IPolyMesh& polymesh)
-    { append->AddInputData(ProcessIPolyMesh(polymesh, time)); };
+    {
+      MeshCache cache;
+      cache.Mesh = polymesh;
+      cache.PointOffset = pointOffset;
+
+      vtkSmartPointer<vtkPolyData> polydata =
+        this->ProcessIPolyMesh(polymesh, time, cache.PointMap);
+      pointOffset += polydata->GetNumberOfPoints();
+      append->AddInputData(polydata);
+
+      this->ConstantTopology = this->ConstantTopology && HasConstantTopology(polymesh);
+      this->MeshCaches.emplace_back(std::move(cache));
+    };
 
     for (size_t i = 0; i < top.getNumChildren(); ++i)
     {
@@ -386,6 +465,72 @@ public:
     }
   }
 
+  /**
+   * Update the positions of the previously converted meshes for the given time.
+   * The previous output may still be used downstream, so it is not modified: a new output
+   * sharing its topology and attributes is created with new points.
+   * Only possible if all meshes have a constant topology, return false otherwise.
+   */
+  bool UpdatePositions(double time)
+  {
+    if (!this->Output || !this->ConstantTopology)
+    {
+      return false;
+    }
+
+    vtkPoints* previousPoints = this->Output->GetPoints();
+    vtkFloatArray* previousArray =
+      previousPoints ? vtkFloatArray::SafeDownCast(previousPoints->GetData()) : nullptr;
+    if (!previousArray)
+    {
+      return false;
+    }
+
+    // constant meshes keep the previous positions
+    vtkNew<vtkFloatArray> pointsArray;
+    pointsArray->DeepCopy(previousArray);
+
+    Alembic::AbcGeom::ISampleSelector selector(time);
+    for (const MeshCache& cache : this->MeshCaches)
+    {
+      const Alembic::AbcGeom::IPolyMeshSchema& schema = cache.Mesh.getSchema();
+      if (schema.getNumSamples() == 0 || schema.isConstant() || cache.PointMap.empty())
+      {
+        continue;
+      }
+
+      Alembic::AbcGeom::P3fArraySamplePtr positions;
+      schema.getPositionsProperty().get(positions, selector);
+      if (!positions)
+      {
+        return false;
+      }
+
+      const Alembic::Abc::V3f* src = positions->get();
+      const size_t nbPositions = positions->size();
+      float* dst = pointsArray->GetPointer(3 * cache.PointOffset);
+      for (size_t i = 0; i < cache.PointMap.size(); i++)
+      {
+        const size_t index = static_cast<size_t>(cache.PointMap[i]);
+        if (index >= nbPositions)
+        {
+          return false;
+        }
+        dst[3 * i] = src[index].x;
+        dst[3 * i + 1] = src[index].y;
+        dst[3 * i + 2] = src[index].z;
+      }
+    }
+
+    vtkNew<vtkPoints> points;
+    points->SetData(pointsArray);
+    vtkNew<vtkPolyData> output;
+    output->ShallowCopy(this->Output);
+    output->SetPoints(points);
+    this->Output = output;
+    return true;
+  }
+
   void ExtendTimeRange(double& start, double& end)
   {
     Alembic::Abc::IObject top = this->Archive.getTop();
@@ -422,8 +567,16 @@ public:
     Alembic::AbcCoreFactory::IFactory::CoreType coreType;
 
     this->Archive = factory.getArchive(filePath, coreType);
+
+    this->MeshCaches.clear();
+    this->Output = nullptr;
   }
+
   Alembic::Abc::IArchive Archive;
+
+  std::vector<MeshCache> MeshCaches;
+  bool ConstantTopology = false;
+  vtkSmartPointer<vtkPolyData> Output;
 };
 
 vtkStandardNewMacro(vtkF3DAlembicReader);
@@ -472,11 +625,22 @@ int vtkF3DAlembicReader::RequestData(
     requestedTimeValue = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
   }
 
-  vtkNew<vtkAppendPolyData> append;
-  this->Internals->ImportRoot(append, requestedTimeValue);
-  append->Update();
+  // When the topology is constant, only the positions need to be refilled
+  if (this->Internals->UpdatePositions(requestedTimeValue))
+  {
+    this->NumberOfPositionsUpdates++;
+  }
+  else
+  {
+    vtkNew<vtkAppendPolyData> append;
+    this->Internals->ImportRoot(append, requestedTimeValue);
+    append->Update();
+
+    this->Internals->Output = vtkSmartPointer<vtkPolyData>::New();
+    this->Internals->Output->ShallowCopy(append->GetOutput());
+  }
 
-  output->ShallowCopy(append->GetOutput());
+  output->ShallowCopy(this->Internals->Output);
 
   return 1;
 }
@@ -486,4 +650,5 @@ void vtkF3DAlembicReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "FileName: " << this->FileName << "\n";
+  os << indent << "NumberOfPositionsUpdates: " << this->NumberOfPositionsUpdates << "\n";
 }
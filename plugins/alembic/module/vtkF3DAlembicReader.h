@@ -6,6 +6,8 @@
  * Currently, only polygonal points positions are retrieved
  * to build polygonal geometries. Vertex normals and texture
  * coordinates are not supported yet.
+ * When all meshes have a constant topology, the converted geometry
+ * is kept and only the positions are refilled on time change.
  *
  * @sa https://github.com/alembic/alembic/blob/master/README.txt
  *
@@ -32,6 +34,12 @@ public:
    */
   vtkSetMacro(FileName, std::string);
 
+  /**
+   * Get the number of updates that only refilled the positions of a previous output
+   * with a constant topology, instead of converting all meshes again.
+   */
+  vtkGetMacro(NumberOfPositionsUpdates, int);
+
 protected:
   vtkF3DAlembicReader();
   ~vtkF3DAlembicReader() override;
@@ -40,6 +48,7 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   std::string FileName;
+  int NumberOfPositionsUpdates = 0;
 
 private:
   vtkF3DAlembicReader(const vtkF3DAlembicReader&) = delete;
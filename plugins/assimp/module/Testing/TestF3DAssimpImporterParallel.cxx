@@ -0,0 +1,112 @@
+#include <vtkActor.h>
+#include <vtkActorCollection.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+#include <vtkSMPTools.h>
+#include <vtkTestUtilities.h>
+#include <vtkTexture.h>
+
+#include "vtkF3DAssimpImporter.h"
+
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkF3DAssimpImporter> Import(const std::string& filename)
+{
+  vtkSmartPointer<vtkF3DAssimpImporter> importer = vtkSmartPointer<vtkF3DAssimpImporter>::New();
+  importer->SetFileName(filename);
+  importer->Update();
+  return importer;
+}
+
+// Check that the parallel import gives the same geometries and textures as a serial one
+bool CompareImports(const std::string& filename)
+{
+  vtkSmartPointer<vtkF3DAssimpImporter> serialImporter;
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ 1 }, [&]() { serialImporter = ::Import(filename); });
+  vtkSmartPointer<vtkF3DAssimpImporter> importer = ::Import(filename);
+
+  vtkActorCollection* serialActors = serialImporter->GetRenderer()->GetActors();
+  vtkActorCollection* actors = importer->GetRenderer()->GetActors();
+  if (actors->GetNumberOfItems() == 0 ||
+    actors->GetNumberOfItems() != serialActors->GetNumberOfItems())
+  {
+    std::cerr << filename << ": unexpected number of actors\n";
+    return false;
+  }
+
+  vtkCollectionSimpleIterator serialIt;
+  vtkCollectionSimpleIterator it;
+  serialActors->InitTraversal(serialIt);
+  actors->InitTraversal(it);
+  while (vtkActor* actor = actors->GetNextActor(it))
+  {
+    vtkActor* serialActor = serialActors->GetNextActor(serialIt);
+
+    vtkPolyData* serialPolyData =
+      vtkPolyDataMapper::SafeDownCast(serialActor->GetMapper())->GetInput();
+    vtkPolyData* polyData = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
+    if (polyData->GetNumberOfPoints() != serialPolyData->GetNumberOfPoints() ||
+      polyData->GetNumberOfCells() != serialPolyData->GetNumberOfCells() ||
+      polyData->GetPointData()->GetNumberOfArrays() !=
+        serialPolyData->GetPointData()->GetNumberOfArrays())
+    {
+      std::cerr << filename << ": unexpected geometry\n";
+      return false;
+    }
+
+    for (vtkIdType i = 0; i < polyData->GetNumberOfPoints(); i++)
+    {
+      double p1[3], p2[3];
+      polyData->GetPoint(i, p1);
+      serialPolyData->GetPoint(i, p2);
+      if (p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2])
+      {
+        std::cerr << filename << ": unexpected point position\n";
+        return false;
+      }
+    }
+
+    auto& serialTextures = serialActor->GetProperty()->GetAllTextures();
+    auto& textures = actor->GetProperty()->GetAllTextures();
+    if (textures.size() != serialTextures.size())
+    {
+      std::cerr << filename << ": unexpected number of textures\n";
+      return false;
+    }
+
+    for (const auto& texture : textures)
+    {
+      // textures are decoded by the import, before any render
+      vtkImageData* image = texture.second->GetInput();
+      vtkImageData* serialImage = serialTextures[texture.first]->GetInput();
+      if (!image || !serialImage || image->GetNumberOfPoints() == 0 ||
+        image->GetNumberOfPoints() != serialImage->GetNumberOfPoints())
+      {
+        std::cerr << filename << ": texture " << texture.first << " is not decoded\n";
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+}
+
+int TestF3DAssimpImporterParallel(int vtkNotUsed(argc), char* argv[])
+{
+  // external and embedded textures
+  if (!::CompareImports(std::string(argv[1]) + "data/duck.fbx") ||
+    !::CompareImports(std::string(argv[1]) + "data/texturedCube.fbx"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
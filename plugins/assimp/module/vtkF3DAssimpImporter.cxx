@@ -5,6 +5,7 @@
 #include <vtkCamera.h>
 #include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkImageData.h>
 #include <vtkImageReader2.h>
 #include <vtkImageReader2Factory.h>
@@ -19,6 +20,7 @@
 #include <vtkProperty.h>
 #include <vtkQuaternion.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkShaderProperty.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
@@ -35,8 +37,11 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <regex>
+#include <unordered_map>
 
 vtkStandardNewMacro(vtkF3DAssimpImporter);
 
@@ -180,6 +185,14 @@ public:
 
     if (!vTexture)
     {
+      // textures referenced by several materials are only created and decoded once
+      vtkSmartPointer<vtkTexture>& cachedTexture =
+        this->TextureCache[std::string(path) + (sRGB ? "|sRGB" : "")];
+      if (cachedTexture)
+      {
+        return cachedTexture;
+      }
+
       // sometimes, embedded textures are indexed by filename
       const aiTexture* aTexture = this->Scene->GetEmbeddedTexture(path);
 
@@ -215,6 +228,7 @@ public:
 
           vTexture = vtkSmartPointer<vtkTexture>::New();
           vTexture->SetInputConnection(reader->GetOutputPort());
+          this->PendingReaders.emplace_back(reader);
         }
         else
         {
@@ -222,6 +236,8 @@ public:
           return nullptr;
         }
       }
+
+      cachedTexture = vTexture;
     }
 
     vTexture->MipmapOn();
@@ -253,6 +269,7 @@ public:
         reader->SetMemoryBuffer(aTexture->pcData);
         reader->SetMemoryBufferLength(aTexture->mWidth);
         vTexture->SetInputConnection(reader->GetOutputPort());
+        this->PendingReaders.emplace_back(reader);
       }
     }
     else
@@ -280,6 +297,53 @@ public:
     return vTexture;
   }
 
+  //----------------------------------------------------------------------------
+  /**
+   * Decode all the textures created so far in parallel
+   * instead of letting the first render decode them one by one
+   */
+  void DecodeTextures()
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->PendingReaders.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          this->PendingReaders[i]->Update();
+        }
+      });
+    this->PendingReaders.clear();
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+   * Copy an array of ASSIMP vectors or colors into a new float array in parallel
+   */
+  template<int NbComponents, typename T>
+  static vtkSmartPointer<vtkFloatArray> CreateFloatArray(
+    const T* values, unsigned int nbValues, const char* name)
+  {
+    vtkNew<vtkFloatArray> array;
+    array->SetNumberOfComponents(NbComponents);
+    array->SetName(name);
+    array->SetNumberOfTuples(nbValues);
+
+    float* ptr = array->GetPointer(0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(nbValues),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          for (int c = 0; c < NbComponents; c++)
+          {
+            ptr[NbComponents * i + c] = static_cast<float>(values[i][c]);
+          }
+        }
+      });
+
+    return array;
+  }
+
   //----------------------------------------------------------------------------
   /**
    * Generate a VTK property from ASSIMP material
@@ -389,105 +453,95 @@ public:
     vtkNew<vtkPolyData> polyData;
 
     vtkNew<vtkPoints> points;
-    points->SetNumberOfPoints(mesh->mNumVertices);
-    for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-    {
-      const aiVector3D& p = mesh->mVertices[i];
-      points->SetPoint(i, p.x, p.y, p.z);
-    }
+    points->SetData(CreateFloatArray<3>(mesh->mVertices, mesh->mNumVertices, nullptr));
     polyData->SetPoints(points);
 
     if (mesh->HasNormals())
     {
-      vtkNew<vtkFloatArray> normals;
-      normals->SetNumberOfComponents(3);
-      normals->SetName("Normal");
-      normals->SetNumberOfTuples(mesh->mNumVertices);
-      for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-      {
-        const aiVector3D& n = mesh->mNormals[i];
-        float tuple[3] = { n.x, n.y, n.z };
-        normals->SetTypedTuple(i, tuple);
-      }
-      polyData->GetPointData()->SetNormals(normals);
+      polyData->GetPointData()->SetNormals(
+        CreateFloatArray<3>(mesh->mNormals, mesh->mNumVertices, "Normal"));
     }
 
     // currently, VTK only supports 1 texture coordinates
     const unsigned int textureIndex = 0;
     if (mesh->HasTextureCoords(textureIndex) && mesh->mNumUVComponents[textureIndex] == 2)
     {
-      vtkNew<vtkFloatArray> tcoords;
-      tcoords->SetNumberOfComponents(2);
-      tcoords->SetName("UV");
-      tcoords->SetNumberOfTuples(mesh->mNumVertices);
-      for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-      {
-        const aiVector3D& t = mesh->mTextureCoords[textureIndex][i];
-        float tuple[2] = { t.x, t.y };
-        tcoords->SetTypedTuple(i, tuple);
-      }
-      polyData->GetPointData()->SetTCoords(tcoords);
+      polyData->GetPointData()->SetTCoords(
+        CreateFloatArray<2>(mesh->mTextureCoords[textureIndex], mesh->mNumVertices, "UV"));
     }
 
     if (mesh->HasTangentsAndBitangents())
     {
-      vtkNew<vtkFloatArray> tangents;
-      tangents->SetNumberOfComponents(3);
-      tangents->SetName("Tangents");
-      tangents->SetNumberOfTuples(mesh->mNumVertices);
-      for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-      {
-        const aiVector3D& t = mesh->mTangents[i];
-        float tuple[3] = { t.x, t.y, t.z };
-        tangents->SetTypedTuple(i, tuple);
-      }
-      polyData->GetPointData()->SetTangents(tangents);
+      polyData->GetPointData()->SetTangents(
+        CreateFloatArray<3>(mesh->mTangents, mesh->mNumVertices, "Tangents"));
     }
 
     if (mesh->HasVertexColors(0))
     {
-      vtkNew<vtkFloatArray> colors;
-      colors->SetNumberOfComponents(4);
-      colors->SetName("Colors");
-      colors->SetNumberOfTuples(mesh->mNumVertices);
-      for (unsigned int i = 0; i < mesh->mNumVertices; i++)
-      {
-        const aiColor4D& c = mesh->mColors[0][i];
-        float tuple[4] = { c.r, c.g, c.b, c.a };
-        colors->SetTypedTuple(i, tuple);
-      }
-      polyData->GetPointData()->SetScalars(colors);
+      polyData->GetPointData()->SetScalars(
+        CreateFloatArray<4>(mesh->mColors[0], mesh->mNumVertices, "Colors"));
     }
 
-    vtkNew<vtkCellArray> verticesCells;
-    vtkNew<vtkCellArray> linesCells;
-    vtkNew<vtkCellArray> polysCells;
-
+    // Faces are split into vertices, lines and polygons, first compute the location of each face
+    // in its cell array so that the connectivity can be filled in parallel
+    enum CellType
+    {
+      VERTEX = 0,
+      LINE = 1,
+      POLYGON = 2
+    };
+    auto GetCellType = [](const aiFace& face)
+    { return face.mNumIndices == 1 ? VERTEX : (face.mNumIndices == 2 ? LINE : POLYGON); };
+
+    std::array<vtkIdType, 3> nbCells = { 0, 0, 0 };
+    std::array<vtkIdType, 3> connectivitySize = { 0, 0, 0 };
+    std::vector<vtkIdType> faceCellIds(mesh->mNumFaces);
+    std::vector<vtkIdType> faceOffsets(mesh->mNumFaces);
     for (unsigned int i = 0; i < mesh->mNumFaces; i++)
     {
       const aiFace& face = mesh->mFaces[i];
+      const int type = GetCellType(face);
+      faceCellIds[i] = nbCells[type]++;
+      faceOffsets[i] = connectivitySize[type];
+      connectivitySize[type] += face.mNumIndices;
+    }
 
-      if (face.mNumIndices == 1)
-      {
-        vtkIdType vId = static_cast<vtkIdType>(face.mIndices[0]);
-        verticesCells->InsertNextCell(1, &vId);
-      }
-      else if (face.mNumIndices == 2)
-      {
-        vtkIdType fId[2] = { static_cast<vtkIdType>(face.mIndices[0]),
-          static_cast<vtkIdType>(face.mIndices[1]) };
-        linesCells->InsertNextCell(2, fId);
-      }
-      else
+    std::array<vtkSmartPointer<vtkIdTypeArray>, 3> offsets;
+    std::array<vtkSmartPointer<vtkIdTypeArray>, 3> connectivity;
+    std::array<vtkIdType*, 3> offsetsPtr;
+    std::array<vtkIdType*, 3> connectivityPtr;
+    for (int type = VERTEX; type <= POLYGON; type++)
+    {
+      offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      offsets[type]->SetNumberOfTuples(nbCells[type] + 1);
+      offsetsPtr[type] = offsets[type]->GetPointer(0);
+      offsetsPtr[type][nbCells[type]] = connectivitySize[type];
+
+      connectivity[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      connectivity[type]->SetNumberOfTuples(connectivitySize[type]);
+      connectivityPtr[type] = connectivity[type]->GetPointer(0);
+    }
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(mesh->mNumFaces),
+      [&](vtkIdType begin, vtkIdType end)
       {
-        vtkIdType fId[AI_MAX_FACE_INDICES];
-        for (unsigned int j = 0; j < face.mNumIndices; j++)
+        for (vtkIdType i = begin; i < end; i++)
         {
-          fId[j] = static_cast<vtkIdType>(face.mIndices[j]);
+          const aiFace& face = mesh->mFaces[i];
+          const int type = GetCellType(face);
+          offsetsPtr[type][faceCellIds[i]] = faceOffsets[i];
+          std::transform(face.mIndices, face.mIndices + face.mNumIndices,
+            connectivityPtr[type] + faceOffsets[i],
+            [](unsigned int index) { return static_cast<vtkIdType>(index); });
         }
-        polysCells->InsertNextCell(face.mNumIndices, fId);
-      }
-    }
+      });
+
+    vtkNew<vtkCellArray> verticesCells;
+    verticesCells->SetData(offsets[VERTEX], connectivity[VERTEX]);
+    vtkNew<vtkCellArray> linesCells;
+    linesCells->SetData(offsets[LINE], connectivity[LINE]);
+    vtkNew<vtkCellArray> polysCells;
+    polysCells->SetData(offsets[POLYGON], connectivity[POLYGON]);
 
     polyData->SetVerts(verticesCells);
     polyData->SetLines(linesCells);
@@ -603,14 +657,20 @@ public:
 
     if (this->Scene)
     {
-      // convert meshes to polyData
+      // convert meshes to polyData, meshes are independent so they are converted in parallel
       this->Meshes.resize(this->Scene->mNumMeshes);
-      for (unsigned int i = 0; i < this->Scene->mNumMeshes; i++)
-      {
-        this->Meshes[i] = this->CreateMesh(this->Scene->mMeshes[i]);
-      }
+      vtkSMPTools::For(0, static_cast<vtkIdType>(this->Scene->mNumMeshes),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            this->Meshes[i] = this->CreateMesh(this->Scene->mMeshes[i]);
+          }
+        });
 
-      // read embedded textures
+      // read embedded textures, the image readers are created serially as their factory is not
+      // thread-safe, compressed textures are decoded in parallel by DecodeTextures below and
+      // uncompressed textures only need a copy of their texels
       this->EmbeddedTextures.resize(this->Scene->mNumTextures);
       for (unsigned int i = 0; i < this->Scene->mNumTextures; i++)
       {
@@ -623,6 +683,9 @@ public:
       {
         this->Properties[i] = this->CreateMaterial(this->Scene->mMaterials[i]);
       }
+
+      // decode embedded and external textures
+      this->DecodeTextures();
       return true;
     }
     else
@@ -885,6 +948,8 @@ public:
   std::vector<vtkSmartPointer<vtkPolyData>> Meshes;
   std::vector<vtkSmartPointer<vtkProperty>> Properties;
   std::vector<vtkSmartPointer<vtkTexture>> EmbeddedTextures;
+  std::unordered_map<std::string, vtkSmartPointer<vtkTexture>> TextureCache;
+  std::vector<vtkSmartPointer<vtkImageReader2>> PendingReaders;
   vtkIdType ActiveAnimation = -1; // -1 means no animation enabled here
   std::vector<std::pair<std::string, vtkSmartPointer<vtkLight>>> Lights;
   std::vector<
@@ -0,0 +1,208 @@
+#include <vtkNew.h>
+#include <vtkSMPTools.h>
+#include <vtkTestUtilities.h>
+
+#include "vtkF3DGLTFDracoDocumentLoader.h"
+
+// clang-format off
+#include <vtk_nlohmannjson.h>
+#include VTK_NLOHMANN_JSON(json.hpp)
+// clang-format on
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+std::shared_ptr<vtkGLTFDocumentLoader::Model> LoadModel(const std::string& filename)
+{
+  vtkNew<vtkF3DGLTFDracoDocumentLoader> loader;
+  if (!loader->LoadModelMetaDataFromFile(filename) || !loader->LoadModelData({}))
+  {
+    return nullptr;
+  }
+  return loader->GetInternalModel();
+}
+
+// Write a copy of the single primitive Draco box with its primitive duplicated in several meshes,
+// each copy using its own accessors, so that multiple primitives are decoded
+constexpr int NumberOfMeshes = 3;
+constexpr int NumberOfPrimitivesPerMesh = 4;
+bool WriteMultiPrimitiveModel(const std::string& dataDir, const std::string& filename)
+{
+  std::ifstream input(dataDir + "Box_draco.gltf");
+  nlohmann::json root = nlohmann::json::parse(input, nullptr, false);
+  if (root.is_discarded())
+  {
+    return false;
+  }
+
+  for (nlohmann::json& buffer : root["buffers"])
+  {
+    buffer["uri"] = dataDir + buffer["uri"].get<std::string>();
+  }
+
+  const nlohmann::json sourcePrimitive = root["meshes"][0]["primitives"][0];
+  nlohmann::json& accessors = root["accessors"];
+  nlohmann::json meshes = nlohmann::json::array();
+  nlohmann::json& nodes = root["nodes"];
+  nlohmann::json& sceneNodes = root["scenes"][0]["nodes"];
+  for (int m = 0; m < ::NumberOfMeshes; m++)
+  {
+    nlohmann::json mesh;
+    for (int p = 0; p < ::NumberOfPrimitivesPerMesh; p++)
+    {
+      nlohmann::json primitive = sourcePrimitive;
+      for (auto& attribute : primitive["attributes"].items())
+      {
+        nlohmann::json accessor = accessors[attribute.value().get<int>()];
+        accessors.push_back(accessor);
+        attribute.value() = accessors.size() - 1;
+      }
+      if (primitive.contains("indices"))
+      {
+        nlohmann::json accessor = accessors[primitive["indices"].get<int>()];
+        accessors.push_back(accessor);
+        primitive["indices"] = accessors.size() - 1;
+      }
+      mesh["primitives"].push_back(primitive);
+    }
+    meshes.push_back(mesh);
+    nlohmann::json node;
+    node["mesh"] = m;
+    nodes.push_back(node);
+    sceneNodes.push_back(nodes.size() - 1);
+  }
+  root["meshes"] = meshes;
+
+  std::ofstream output(filename);
+  output << root.dump();
+  return output.good();
+}
+}
+
+int TestF3DGLTFDracoDocumentLoader(int vtkNotUsed(argc), char* argv[])
+{
+  std::string dataDir = std::string(argv[1]) + "data/";
+  std::string filename = std::string(argv[2]) + "Box_draco_multi_primitives.gltf";
+  if (!::WriteMultiPrimitiveModel(dataDir, filename))
+  {
+    std::cerr << "Failed to write " << filename << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Decode with the sequential backend first, then with the default one
+  std::string backend = vtkSMPTools::GetBackend();
+  vtkSMPTools::SetBackend("Sequential");
+  std::shared_ptr<vtkGLTFDocumentLoader::Model> serialModel = ::LoadModel(filename);
+  vtkSMPTools::SetBackend(backend.c_str());
+  std::shared_ptr<vtkGLTFDocumentLoader::Model> parallelModel = ::LoadModel(filename);
+
+  if (!serialModel || !parallelModel)
+  {
+    std::cerr << "Failed to load " << filename << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (serialModel->Buffers != parallelModel->Buffers)
+  {
+    std::cerr << "Decoded buffers differ between serial and parallel decoding" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (serialModel->BufferViews.size() != parallelModel->BufferViews.size())
+  {
+    std::cerr << "Number of buffer views differ between serial and parallel decoding"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < serialModel->BufferViews.size(); i++)
+  {
+    const auto& serialView = serialModel->BufferViews[i];
+    const auto& parallelView = parallelModel->BufferViews[i];
+    if (serialView.Buffer != parallelView.Buffer ||
+      serialView.ByteOffset != parallelView.ByteOffset ||
+      serialView.ByteLength != parallelView.ByteLength)
+    {
+      std::cerr << "Buffer view " << i << " differs between serial and parallel decoding"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (serialModel->Accessors.size() != parallelModel->Accessors.size())
+  {
+    std::cerr << "Number of accessors differ between serial and parallel decoding" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < serialModel->Accessors.size(); i++)
+  {
+    const auto& serialAccessor = serialModel->Accessors[i];
+    const auto& parallelAccessor = parallelModel->Accessors[i];
+    if (serialAccessor.BufferView != parallelAccessor.BufferView ||
+      serialAccessor.Count != parallelAccessor.Count ||
+      serialAccessor.ByteOffset != parallelAccessor.ByteOffset)
+    {
+      std::cerr << "Accessor " << i << " differs between serial and parallel decoding"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Decoded buffers are appended in primitive order, and every copy decodes to the same data
+  if (parallelModel->Meshes.size() != ::NumberOfMeshes)
+  {
+    std::cerr << "Unexpected number of meshes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const vtkGLTFDocumentLoader::Primitive& firstPrimitive =
+    parallelModel->Meshes[0].Primitives[0];
+  int previousBufferView = -1;
+  for (const vtkGLTFDocumentLoader::Mesh& mesh : parallelModel->Meshes)
+  {
+    if (mesh.Primitives.size() != ::NumberOfPrimitivesPerMesh)
+    {
+      std::cerr << "Unexpected number of primitives" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (const vtkGLTFDocumentLoader::Primitive& primitive : mesh.Primitives)
+    {
+      if (primitive.IndicesId < 0)
+      {
+        std::cerr << "Primitive is missing its indices" << std::endl;
+        return EXIT_FAILURE;
+      }
+      const auto& indices = parallelModel->Accessors[primitive.IndicesId];
+      const auto& firstIndices = parallelModel->Accessors[firstPrimitive.IndicesId];
+      if (indices.BufferView <= previousBufferView ||
+        parallelModel->Buffers[parallelModel->BufferViews[indices.BufferView].Buffer] !=
+          parallelModel->Buffers[parallelModel->BufferViews[firstIndices.BufferView].Buffer])
+      {
+        std::cerr << "Decoded indices are not ordered by primitive" << std::endl;
+        return EXIT_FAILURE;
+      }
+      int lastBufferView = indices.BufferView;
+
+      for (const auto& [name, accessorId] : primitive.AttributeIndices)
+      {
+        const auto& accessor = parallelModel->Accessors[accessorId];
+        const auto& firstAccessor =
+          parallelModel->Accessors[firstPrimitive.AttributeIndices.at(name)];
+        if (accessor.BufferView <= indices.BufferView ||
+          parallelModel->Buffers[parallelModel->BufferViews[accessor.BufferView].Buffer] !=
+            parallelModel->Buffers[parallelModel->BufferViews[firstAccessor.BufferView].Buffer])
+        {
+          std::cerr << "Decoded attribute " << name << " is not ordered by primitive"
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+        lastBufferView = std::max(lastBufferView, accessor.BufferView);
+      }
+      previousBufferView = lastBufferView;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
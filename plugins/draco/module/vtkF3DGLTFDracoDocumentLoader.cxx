@@ -1,6 +1,7 @@
 #include "vtkF3DGLTFDracoDocumentLoader.h"
 
 #include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
 
 #include <algorithm>
 
@@ -114,69 +115,137 @@ std::vector<std::string> vtkF3DGLTFDracoDocumentLoader::GetSupportedExtensions()
 //----------------------------------------------------------------------------
 void vtkF3DGLTFDracoDocumentLoader::PrepareData()
 {
+  this->Superclass::PrepareData();
+
   std::shared_ptr<Model> model = this->GetInternalModel();
 
-  for (size_t i = 0; i < model->Meshes.size(); i++)
+  // Collect Draco primitives and the accessors of their attributes in a deterministic order
+  struct DracoPrimitive
+  {
+    Primitive* Prim;
+    std::vector<int> AttributeAccessors;
+  };
+  std::vector<DracoPrimitive> dracoPrimitives;
+  for (Mesh& mesh : model->Meshes)
   {
-    for (Primitive& primitive : model->Meshes[i].Primitives)
+    for (Primitive& primitive : mesh.Primitives)
     {
       // check if Draco metadata is present
-      auto& dracoMetaData = primitive.ExtensionMetaData.KHRDracoMetaData;
+      const auto& dracoMetaData = primitive.ExtensionMetaData.KHRDracoMetaData;
       if (dracoMetaData.BufferView >= 0)
       {
-        auto& view = model->BufferViews[primitive.ExtensionMetaData.KHRDracoMetaData.BufferView];
-        auto& buffer = model->Buffers[view.Buffer];
+        DracoPrimitive dracoPrimitive{ &primitive, {} };
+        for (const auto& attrib : dracoMetaData.AttributeIndices)
+        {
+          dracoPrimitive.AttributeAccessors.emplace_back(
+            primitive.AttributeIndices[attrib.first]);
+        }
+        dracoPrimitives.emplace_back(std::move(dracoPrimitive));
+      }
+    }
+  }
+
+  // Primitives are independent, decode them in parallel into pre-allocated slots.
+  // The model is only read here, it is modified serially afterwards
+  struct DecodedPrimitive
+  {
+    bool Valid = false;
+    std::vector<char> IndexBuffer;
+    int IndexCount = 0;
+    std::vector<std::vector<char>> VertexBuffers;
+    int PointCount = 0;
+  };
+  std::vector<DecodedPrimitive> decodedPrimitives(dracoPrimitives.size());
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dracoPrimitives.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        const Primitive& primitive = *dracoPrimitives[i].Prim;
+        const auto& dracoMetaData = primitive.ExtensionMetaData.KHRDracoMetaData;
+        const auto& view = model->BufferViews[dracoMetaData.BufferView];
+        const auto& buffer = model->Buffers[view.Buffer];
 
         draco::DecoderBuffer decoderBuffer;
         decoderBuffer.Init(buffer.data() + view.ByteOffset, view.ByteLength);
         auto decodeResult = draco::Decoder().DecodeMeshFromBuffer(&decoderBuffer);
-        if (decodeResult.ok())
+        if (!decodeResult.ok())
+        {
+          continue;
+        }
+
+        const std::unique_ptr<draco::Mesh>& mesh = decodeResult.value();
+        DecodedPrimitive& decoded = decodedPrimitives[i];
+
+        // handle index buffer
+        if (primitive.IndicesId >= 0)
         {
-          const std::unique_ptr<draco::Mesh>& mesh = decodeResult.value();
-
-          // handle index buffer
-          if (primitive.IndicesId >= 0)
-          {
-            auto& accessor = model->Accessors[primitive.IndicesId];
-
-            model->Buffers.emplace_back(::DecodeIndexBuffer(mesh, accessor.ComponentTypeValue));
-
-            vtkGLTFDocumentLoader::BufferView decodedIndexBufferView;
-            decodedIndexBufferView.Buffer = static_cast<int>(model->Buffers.size() - 1);
-            decodedIndexBufferView.ByteLength = model->Buffers.back().size();
-            decodedIndexBufferView.ByteOffset = 0;
-            decodedIndexBufferView.ByteStride = 0;
-            decodedIndexBufferView.Target =
-              static_cast<int>(vtkGLTFDocumentLoader::Target::ARRAY_BUFFER);
-            model->BufferViews.emplace_back(std::move(decodedIndexBufferView));
-
-            accessor.BufferView = static_cast<int>(model->BufferViews.size() - 1);
-            accessor.Count = static_cast<int>(mesh->num_faces() * 3);
-          }
-
-          // handle vertex attributes
-          for (const auto& attrib : dracoMetaData.AttributeIndices)
-          {
-            auto& attrAccessor = model->Accessors[primitive.AttributeIndices[attrib.first]];
-
-            model->Buffers.emplace_back(
-              ::DecodeVertexBuffer(attrAccessor.ComponentTypeValue, mesh, attrib.second));
-
-            vtkGLTFDocumentLoader::BufferView decodedBufferView;
-            decodedBufferView.Buffer = static_cast<int>(model->Buffers.size() - 1);
-            decodedBufferView.ByteLength = model->Buffers.back().size();
-            decodedBufferView.ByteOffset = 0;
-            decodedBufferView.ByteStride = 0;
-            decodedBufferView.Target =
-              static_cast<int>(vtkGLTFDocumentLoader::Target::ELEMENT_ARRAY_BUFFER);
-            model->BufferViews.emplace_back(std::move(decodedBufferView));
-
-            attrAccessor.BufferView = static_cast<int>(model->BufferViews.size() - 1);
-            attrAccessor.Count = static_cast<int>(mesh->num_points());
-            attrAccessor.ByteOffset = 0;
-          }
+          const auto& accessor = model->Accessors[primitive.IndicesId];
+          decoded.IndexBuffer = ::DecodeIndexBuffer(mesh, accessor.ComponentTypeValue);
+          decoded.IndexCount = static_cast<int>(mesh->num_faces() * 3);
         }
+
+        // handle vertex attributes
+        size_t attribIndex = 0;
+        for (const auto& attrib : dracoMetaData.AttributeIndices)
+        {
+          const auto& attrAccessor =
+            model->Accessors[dracoPrimitives[i].AttributeAccessors[attribIndex++]];
+          decoded.VertexBuffers.emplace_back(
+            ::DecodeVertexBuffer(attrAccessor.ComponentTypeValue, mesh, attrib.second));
+        }
+        decoded.PointCount = static_cast<int>(mesh->num_points());
+        decoded.Valid = true;
       }
+    });
+
+  // Append decoded buffers in primitive order so that indexing does not depend on threading
+  for (size_t i = 0; i < dracoPrimitives.size(); i++)
+  {
+    Primitive& primitive = *dracoPrimitives[i].Prim;
+    DecodedPrimitive& decoded = decodedPrimitives[i];
+    if (!decoded.Valid)
+    {
+      continue;
+    }
+
+    if (primitive.IndicesId >= 0)
+    {
+      auto& accessor = model->Accessors[primitive.IndicesId];
+
+      model->Buffers.emplace_back(std::move(decoded.IndexBuffer));
+
+      vtkGLTFDocumentLoader::BufferView decodedIndexBufferView;
+      decodedIndexBufferView.Buffer = static_cast<int>(model->Buffers.size() - 1);
+      decodedIndexBufferView.ByteLength = model->Buffers.back().size();
+      decodedIndexBufferView.ByteOffset = 0;
+      decodedIndexBufferView.ByteStride = 0;
+      decodedIndexBufferView.Target = static_cast<int>(vtkGLTFDocumentLoader::Target::ARRAY_BUFFER);
+      model->BufferViews.emplace_back(std::move(decodedIndexBufferView));
+
+      accessor.BufferView = static_cast<int>(model->BufferViews.size() - 1);
+      accessor.Count = decoded.IndexCount;
+    }
+
+    for (size_t j = 0; j < decoded.VertexBuffers.size(); j++)
+    {
+      auto& attrAccessor = model->Accessors[dracoPrimitives[i].AttributeAccessors[j]];
+
+      model->Buffers.emplace_back(std::move(decoded.VertexBuffers[j]));
+
+      vtkGLTFDocumentLoader::BufferView decodedBufferView;
+      decodedBufferView.Buffer = static_cast<int>(model->Buffers.size() - 1);
+      decodedBufferView.ByteLength = model->Buffers.back().size();
+      decodedBufferView.ByteOffset = 0;
+      decodedBufferView.ByteStride = 0;
+      decodedBufferView.Target =
+        static_cast<int>(vtkGLTFDocumentLoader::Target::ELEMENT_ARRAY_BUFFER);
+      model->BufferViews.emplace_back(std::move(decodedBufferView));
+
+      attrAccessor.BufferView = static_cast<int>(model->BufferViews.size() - 1);
+      attrAccessor.Count = decoded.PointCount;
+      attrAccessor.ByteOffset = 0;
     }
   }
 }
@@ -2,19 +2,19 @@
  * @class   vtkF3DGLTFDracoDocumentLoader
  * @brief   Specialized GLTF document loader with Draco buffer decoding
  *
- * This class subclasses vtkGLTFDocumentLoader to handle Draco metadata
+ * This class subclasses vtkF3DGLTFDocumentLoader to handle Draco metadata
  */
 
 #ifndef vtkF3DGLTFDracoDocumentLoader_h
 #define vtkF3DGLTFDracoDocumentLoader_h
 
-#include <vtkGLTFDocumentLoader.h>
+#include <vtkF3DGLTFDocumentLoader.h>
 
-class vtkF3DGLTFDracoDocumentLoader : public vtkGLTFDocumentLoader
+class vtkF3DGLTFDracoDocumentLoader : public vtkF3DGLTFDocumentLoader
 {
 public:
   static vtkF3DGLTFDracoDocumentLoader* New();
-  vtkTypeMacro(vtkF3DGLTFDracoDocumentLoader, vtkGLTFDocumentLoader);
+  vtkTypeMacro(vtkF3DGLTFDracoDocumentLoader, vtkF3DGLTFDocumentLoader);
 
   /**
    * Overridden to add KHR_draco_mesh_compression support
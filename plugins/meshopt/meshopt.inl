@@ -0,0 +1,11 @@
+/*
+ * Only read glTF files that use EXT_meshopt_compression, other glTF readers are used otherwise
+ */
+bool canRead(const std::string& fileName) const override
+{
+  if (!f3d::reader::canRead(fileName))
+  {
+    return false;
+  }
+  return vtkF3DGLTFMeshoptImporter::UsesMeshoptCompression(fileName);
+}
@@ -0,0 +1,273 @@
+#include "vtkF3DGLTFMeshoptDocumentLoader.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
+
+// clang-format off
+#include <vtk_nlohmannjson.h>
+#include VTK_NLOHMANN_JSON(json.hpp)
+// clang-format on
+
+#include <meshoptimizer.h>
+
+#include <algorithm>
+
+namespace
+{
+constexpr const char* MESHOPT_EXTENSION = "EXT_meshopt_compression";
+
+//----------------------------------------------------------------------------
+enum class CompressionMode
+{
+  ATTRIBUTES,
+  TRIANGLES,
+  INDICES
+};
+
+enum class CompressionFilter
+{
+  NONE,
+  OCTAHEDRAL,
+  QUATERNION,
+  EXPONENTIAL
+};
+
+struct CompressedBufferView
+{
+  size_t ViewIndex;
+  size_t Buffer;
+  size_t ByteOffset;
+  size_t ByteLength;
+  size_t ByteStride;
+  size_t Count;
+  CompressionMode Mode;
+  CompressionFilter Filter;
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Parse and validate the EXT_meshopt_compression extension of a buffer view.
+ * Constraints are the ones of the extension specification, they are also
+ * asserted by meshoptimizer decoding functions.
+ */
+bool ParseCompressedBufferView(const nlohmann::json& extension,
+  const std::vector<std::vector<char>>& buffers, CompressedBufferView& view)
+{
+  view.Buffer = extension.value("buffer", buffers.size());
+  view.ByteOffset = extension.value("byteOffset", size_t(0));
+  view.ByteLength = extension.value("byteLength", size_t(0));
+  view.ByteStride = extension.value("byteStride", size_t(0));
+  view.Count = extension.value("count", size_t(0));
+
+  if (view.Buffer >= buffers.size() ||
+    view.ByteOffset + view.ByteLength > buffers[view.Buffer].size())
+  {
+    return false;
+  }
+
+  const std::string mode = extension.value("mode", "");
+  if (mode == "ATTRIBUTES" && view.ByteStride > 0 && view.ByteStride % 4 == 0 &&
+    view.ByteStride <= 256)
+  {
+    view.Mode = CompressionMode::ATTRIBUTES;
+  }
+  else if (mode == "TRIANGLES" && view.Count % 3 == 0 &&
+    (view.ByteStride == 2 || view.ByteStride == 4))
+  {
+    view.Mode = CompressionMode::TRIANGLES;
+  }
+  else if (mode == "INDICES" && (view.ByteStride == 2 || view.ByteStride == 4))
+  {
+    view.Mode = CompressionMode::INDICES;
+  }
+  else
+  {
+    return false;
+  }
+
+  const std::string filter = extension.value("filter", "NONE");
+  if (filter == "NONE")
+  {
+    view.Filter = CompressionFilter::NONE;
+  }
+  else if (filter == "OCTAHEDRAL" && (view.ByteStride == 4 || view.ByteStride == 8))
+  {
+    view.Filter = CompressionFilter::OCTAHEDRAL;
+  }
+  else if (filter == "QUATERNION" && view.ByteStride == 8)
+  {
+    view.Filter = CompressionFilter::QUATERNION;
+  }
+  else if (filter == "EXPONENTIAL" && view.ByteStride % 4 == 0)
+  {
+    view.Filter = CompressionFilter::EXPONENTIAL;
+  }
+  else
+  {
+    return false;
+  }
+
+  // filters are only defined for attributes
+  return view.Filter == CompressionFilter::NONE || view.Mode == CompressionMode::ATTRIBUTES;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Decode a compressed buffer view, return an empty buffer on failure
+ */
+std::vector<char> DecodeBufferView(
+  const CompressedBufferView& view, const std::vector<std::vector<char>>& buffers)
+{
+  std::vector<char> decoded(view.Count * view.ByteStride);
+  const unsigned char* source =
+    reinterpret_cast<const unsigned char*>(buffers[view.Buffer].data() + view.ByteOffset);
+
+  int result = -1;
+  switch (view.Mode)
+  {
+    case CompressionMode::ATTRIBUTES:
+      result = meshopt_decodeVertexBuffer(
+        decoded.data(), view.Count, view.ByteStride, source, view.ByteLength);
+      break;
+    case CompressionMode::TRIANGLES:
+      result = meshopt_decodeIndexBuffer(
+        decoded.data(), view.Count, view.ByteStride, source, view.ByteLength);
+      break;
+    case CompressionMode::INDICES:
+      result = meshopt_decodeIndexSequence(
+        decoded.data(), view.Count, view.ByteStride, source, view.ByteLength);
+      break;
+  }
+  if (result != 0)
+  {
+    return {};
+  }
+
+  switch (view.Filter)
+  {
+    case CompressionFilter::OCTAHEDRAL:
+      meshopt_decodeFilterOct(decoded.data(), view.Count, view.ByteStride);
+      break;
+    case CompressionFilter::QUATERNION:
+      meshopt_decodeFilterQuat(decoded.data(), view.Count, view.ByteStride);
+      break;
+    case CompressionFilter::EXPONENTIAL:
+      meshopt_decodeFilterExp(decoded.data(), view.Count, view.ByteStride);
+      break;
+    default:
+      break;
+  }
+  return decoded;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DGLTFMeshoptDocumentLoader);
+
+//----------------------------------------------------------------------------
+std::vector<std::string> vtkF3DGLTFMeshoptDocumentLoader::GetSupportedExtensions()
+{
+  std::vector<std::string> extensions = this->Superclass::GetSupportedExtensions();
+  extensions.emplace_back(::MESHOPT_EXTENSION);
+  return extensions;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGLTFMeshoptDocumentLoader::UsesMeshoptCompression(const std::string& fileName)
+{
+  // Only the JSON chunk of glb files is read, and most files are rejected by a plain search
+  const std::string json = vtkF3DGLTFDocumentLoader::ReadDocumentJSON(fileName);
+  if (json.find(::MESHOPT_EXTENSION) == std::string::npos)
+  {
+    return false;
+  }
+
+  // Only keep the top level extensionsUsed, other values are discarded while parsing
+  const nlohmann::json root = nlohmann::json::parse(
+    json,
+    [](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed)
+    {
+      return event != nlohmann::json::parse_event_t::key || depth != 1 ||
+        parsed == "extensionsUsed";
+    },
+    false);
+  if (root.is_discarded() || !root.contains("extensionsUsed") ||
+    !root["extensionsUsed"].is_array())
+  {
+    return false;
+  }
+  const nlohmann::json& extensionsUsed = root["extensionsUsed"];
+  return std::find(extensionsUsed.begin(), extensionsUsed.end(), ::MESHOPT_EXTENSION) !=
+    extensionsUsed.end();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGLTFMeshoptDocumentLoader::PrepareData()
+{
+  this->Superclass::PrepareData();
+
+  std::shared_ptr<Model> model = this->GetInternalModel();
+
+  // The buffer view extensions are not parsed by vtkGLTFDocumentLoader, read them from the file
+  const std::string json = vtkF3DGLTFDocumentLoader::ReadDocumentJSON(model->FileName);
+  if (json.find(::MESHOPT_EXTENSION) == std::string::npos)
+  {
+    return;
+  }
+  const nlohmann::json root = nlohmann::json::parse(json, nullptr, false);
+  if (root.is_discarded() || !root.contains("bufferViews") || !root["bufferViews"].is_array())
+  {
+    return;
+  }
+
+  const nlohmann::json& bufferViews = root["bufferViews"];
+  std::vector<::CompressedBufferView> compressedViews;
+  for (size_t i = 0; i < bufferViews.size() && i < model->BufferViews.size(); i++)
+  {
+    const nlohmann::json& bufferView = bufferViews[i];
+    if (!bufferView.contains("extensions") ||
+      !bufferView["extensions"].contains(::MESHOPT_EXTENSION))
+    {
+      continue;
+    }
+
+    ::CompressedBufferView view;
+    view.ViewIndex = i;
+    if (!::ParseCompressedBufferView(
+          bufferView["extensions"][::MESHOPT_EXTENSION], model->Buffers, view))
+    {
+      vtkWarningMacro("Invalid " << ::MESHOPT_EXTENSION << " in buffer view " << i);
+      continue;
+    }
+    compressedViews.emplace_back(view);
+  }
+
+  // Buffer views are independent, decode them in parallel into pre-allocated slots
+  std::vector<std::vector<char>> decodedBuffers(compressedViews.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(compressedViews.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        decodedBuffers[i] = ::DecodeBufferView(compressedViews[i], model->Buffers);
+      }
+    });
+
+  // Append decoded buffers in buffer view order so that indexing does not depend on threading
+  for (size_t i = 0; i < compressedViews.size(); i++)
+  {
+    const size_t viewIndex = compressedViews[i].ViewIndex;
+    if (decodedBuffers[i].empty() && compressedViews[i].Count > 0)
+    {
+      vtkWarningMacro("Failed to decode " << ::MESHOPT_EXTENSION << " buffer view " << viewIndex);
+      continue;
+    }
+
+    model->Buffers.emplace_back(std::move(decodedBuffers[i]));
+
+    vtkGLTFDocumentLoader::BufferView& view = model->BufferViews[viewIndex];
+    view.Buffer = static_cast<int>(model->Buffers.size() - 1);
+    view.ByteOffset = 0;
+    view.ByteLength = static_cast<int>(model->Buffers.back().size());
+  }
+}
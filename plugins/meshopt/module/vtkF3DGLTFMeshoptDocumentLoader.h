@@ -0,0 +1,50 @@
+/**
+ * @class   vtkF3DGLTFMeshoptDocumentLoader
+ * @brief   Specialized GLTF document loader with meshopt buffer view decoding
+ *
+ * This class subclasses vtkF3DGLTFDocumentLoader to handle EXT_meshopt_compression.
+ * Compressed buffer views are decoded using meshoptimizer, which uses SIMD
+ * instructions when available.
+ */
+
+#ifndef vtkF3DGLTFMeshoptDocumentLoader_h
+#define vtkF3DGLTFMeshoptDocumentLoader_h
+
+#include <vtkF3DGLTFDocumentLoader.h>
+
+#include <string>
+
+class vtkF3DGLTFMeshoptDocumentLoader : public vtkF3DGLTFDocumentLoader
+{
+public:
+  static vtkF3DGLTFMeshoptDocumentLoader* New();
+  vtkTypeMacro(vtkF3DGLTFMeshoptDocumentLoader, vtkF3DGLTFDocumentLoader);
+
+  /**
+   * Overridden to add EXT_meshopt_compression support
+   */
+  std::vector<std::string> GetSupportedExtensions() override;
+
+  /**
+   * Overridden to decode meshopt compressed buffer views.
+   * Each compressed buffer view is decoded into a new buffer
+   * and modified to point to it.
+   */
+  void PrepareData() override;
+
+  /**
+   * Return true if the provided glTF or glb file lists EXT_meshopt_compression
+   * in its used extensions. Only the JSON chunk of glb files is read.
+   */
+  static bool UsesMeshoptCompression(const std::string& fileName);
+
+protected:
+  vtkF3DGLTFMeshoptDocumentLoader() = default;
+  ~vtkF3DGLTFMeshoptDocumentLoader() override = default;
+
+private:
+  vtkF3DGLTFMeshoptDocumentLoader(const vtkF3DGLTFMeshoptDocumentLoader&) = delete;
+  void operator=(const vtkF3DGLTFMeshoptDocumentLoader&) = delete;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#include "vtkF3DGLTFMeshoptImporter.h"
+
+#include "vtkF3DGLTFMeshoptDocumentLoader.h"
+
+#include <vtkObjectFactory.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DGLTFMeshoptImporter);
+
+//----------------------------------------------------------------------------
+bool vtkF3DGLTFMeshoptImporter::UsesMeshoptCompression(const std::string& fileName)
+{
+  return vtkF3DGLTFMeshoptDocumentLoader::UsesMeshoptCompression(fileName);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGLTFMeshoptImporter::InitializeLoader()
+{
+  this->Loader = vtkSmartPointer<vtkF3DGLTFMeshoptDocumentLoader>::New();
+}
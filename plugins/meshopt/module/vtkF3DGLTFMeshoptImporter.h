@@ -0,0 +1,41 @@
+/**
+ * @class   vtkF3DGLTFMeshoptImporter
+ * @brief   VTK GLTF importer with EXT_meshopt_compression support
+ *
+ * Subclasses the default importer to initialize our own loader.
+ * @sa vtkF3DGLTFMeshoptDocumentLoader
+ */
+
+#ifndef vtkF3DGLTFMeshoptImporter_h
+#define vtkF3DGLTFMeshoptImporter_h
+
+#include <vtkF3DGLTFImporter.h>
+
+#include <string>
+
+class vtkF3DGLTFMeshoptImporter : public vtkF3DGLTFImporter
+{
+public:
+  static vtkF3DGLTFMeshoptImporter* New();
+  vtkTypeMacro(vtkF3DGLTFMeshoptImporter, vtkF3DGLTFImporter);
+
+  /**
+   * Return true if the provided glTF file uses EXT_meshopt_compression
+   */
+  static bool UsesMeshoptCompression(const std::string& fileName);
+
+protected:
+  vtkF3DGLTFMeshoptImporter() = default;
+  ~vtkF3DGLTFMeshoptImporter() override = default;
+
+  /**
+   * Overridden to instantiate our own document loader
+   */
+  void InitializeLoader() override;
+
+private:
+  vtkF3DGLTFMeshoptImporter(const vtkF3DGLTFMeshoptImporter&) = delete;
+  void operator=(const vtkF3DGLTFMeshoptImporter&) = delete;
+};
+
+#endif
@@ -10,7 +10,9 @@
 #include <vtkProperty.h>
 #include <vtkRenderer.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkF3DQuakeMDLImporter);
@@ -155,46 +157,53 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
   }
 
   //----------------------------------------------------------------------------
-  vtkSmartPointer<vtkPolyData> CreateMeshForSimpleFrame(const mdl_simpleframe_t* frame,
-    const mdl_header_t* header, const mdl_triangle_t* triangles, vtkCellArray* cells,
-    vtkFloatArray* textureCoordinates)
+  /**
+   * Store the quantized vertices of a frame, return the index of the frame
+   */
+  size_t AddFrame(const mdl_simpleframe_t* frame)
   {
-    vtkNew<vtkPoints> vertices;
-    vertices->Allocate(header->numTriangles * 3);
+    this->FrameVertices.insert(
+      this->FrameVertices.end(), frame->verts, frame->verts + this->NumberOfVertices);
+    return this->NumberOfFrames++;
+  }
 
-    vtkNew<vtkFloatArray> normals;
-    normals->SetNumberOfComponents(3);
-    normals->SetNumberOfTuples(header->numTriangles * 3);
+  //----------------------------------------------------------------------------
+  /**
+   * Decode the positions and normals of a frame into the shared mesh.
+   * Topology and texture coordinates are identical for all frames and are not touched.
+   */
+  void DecodeFrame(size_t frameIndex)
+  {
+    if (frameIndex == this->DecodedFrame)
+    {
+      return;
+    }
 
-    for (int i = 0; i < header->numTriangles; i++)
+    const mdl_vertex_t* frameVertices =
+      this->FrameVertices.data() + frameIndex * this->NumberOfVertices;
+    vtkPoints* points = this->Mesh->GetPoints();
+    vtkFloatArray* normals = vtkFloatArray::SafeDownCast(this->Mesh->GetPointData()->GetNormals());
+    float* pointsPtr = vtkFloatArray::SafeDownCast(points->GetData())->GetPointer(0);
+    float* normalsPtr = normals->GetPointer(0);
+
+    for (size_t i = 0; i < this->PointVertexIndices.size(); i++)
     {
-      vtkIdType vertexNum[3];
-      for (int j = 0; j < 3; j++)
-      {
-        // Recover XYZ
-        vertexNum[j] = triangles[i].vertex[j];
-        double xyz[3] = { static_cast<double>(frame->verts[vertexNum[j]].xyz[0]),
-          static_cast<double>(frame->verts[vertexNum[j]].xyz[1]),
-          static_cast<double>(frame->verts[vertexNum[j]].xyz[2]) };
-
-        // Calculate real vertex position
-        for (int k = 0; k < 3; k++)
-        {
-          xyz[k] = xyz[k] * header->scale[k] + header->translation[k];
-        }
-        vertices->InsertPoint(i * 3 + j, xyz);
+      const mdl_vertex_t& vertex = frameVertices[this->PointVertexIndices[i]];
 
-        // Normal vector
-        int normalIndex = frame->verts[vertexNum[j]].normalIndex;
-        normals->SetTypedTuple(i * 3 + j, F3DMDLNormalVectors[normalIndex]);
+      // Calculate real vertex position
+      for (int k = 0; k < 3; k++)
+      {
+        pointsPtr[i * 3 + k] = static_cast<float>(
+          static_cast<double>(vertex.xyz[k]) * this->Scale[k] + this->Translation[k]);
       }
+
+      // Normal vector
+      std::copy_n(F3DMDLNormalVectors[vertex.normalIndex], 3, normalsPtr + i * 3);
     }
-    vtkNew<vtkPolyData> mesh;
-    mesh->SetPoints(vertices);
-    mesh->SetPolys(cells);
-    mesh->GetPointData()->SetTCoords(textureCoordinates);
-    mesh->GetPointData()->SetNormals(normals);
-    return mesh;
+
+    points->Modified();
+    normals->Modified();
+    this->DecodedFrame = frameIndex;
   }
 
   //----------------------------------------------------------------------------
@@ -258,7 +267,12 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
       }
     }
 
-    // Draw cells and scale texture coordinates
+    this->NumberOfVertices = header->numVertices;
+    std::copy_n(header->scale, 3, this->Scale);
+    std::copy_n(header->translation, 3, this->Translation);
+
+    // Draw cells and scale texture coordinates, they are shared by all frames
+    this->PointVertexIndices.reserve(header->numTriangles * 3);
     vtkNew<vtkCellArray> cells;
     cells->Allocate(header->numTriangles);
     vtkNew<vtkFloatArray> textureCoordinates;
@@ -269,6 +283,8 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
     {
       for (int vertex : triangles[i].vertex)
       {
+        this->PointVertexIndices.emplace_back(vertex);
+
         float coord_s = texcoords[vertex].coord_s;
         float coord_t = texcoords[vertex].coord_t;
         if (!triangles[i].facesFront && texcoords[vertex].onseam)
@@ -287,6 +303,21 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
       cells->InsertNextCell(3, triangle);
     }
 
+    // Points and normals are decoded from the active frame
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(header->numTriangles * 3);
+
+    vtkNew<vtkFloatArray> normals;
+    normals->SetNumberOfComponents(3);
+    normals->SetNumberOfTuples(header->numTriangles * 3);
+
+    this->Mesh = vtkSmartPointer<vtkPolyData>::New();
+    this->Mesh->SetPoints(points);
+    this->Mesh->SetPolys(cells);
+    this->Mesh->GetPointData()->SetTCoords(textureCoordinates);
+    this->Mesh->GetPointData()->SetNormals(normals);
+
     // Extract animation name from frame name and recover animation index accordingly
     // Check if frame name respect standard naming scheme for single frames
     // eg: stand1, stand2, stand3, run1, run2, run3
@@ -308,7 +339,7 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
     {
       this->AnimationNames.emplace_back(animName);
       this->AnimationTimes.emplace_back(std::vector<double>());
-      this->AnimationFrames.emplace_back(std::vector<vtkSmartPointer<vtkPolyData>>());
+      this->AnimationFrames.emplace_back(std::vector<size_t>());
       return this->AnimationNames.size() - 1;
     };
 
@@ -341,17 +372,15 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
         // Single frames are 10 fps
         times.emplace_back(times.back() + 0.1);
 
-        // Create the animation frame
-        vtkSmartPointer<vtkPolyData> mesh =
-          this->CreateMeshForSimpleFrame(frame, header, triangles, cells, textureCoordinates);
-        this->AnimationFrames[singleFrameAnimIdx].emplace_back(mesh);
+        // Store the animation frame
+        this->AnimationFrames[singleFrameAnimIdx].emplace_back(this->AddFrame(frame));
       }
       else
       {
         // Group frame are expected to be a single animation
         std::string animationName;
         std::vector<double> times;
-        std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+        std::vector<size_t> frames;
 
         // groupFrames always start at 0.0
         times.emplace_back(0.0);
@@ -372,13 +401,12 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
           // Recover time for this frame from the dedicated table
           times.emplace_back(pluginFramePtr.time[groupFrameNum]);
 
-          // Recover mesh for this frame
-          meshes.emplace_back(
-            this->CreateMeshForSimpleFrame(frame, header, triangles, cells, textureCoordinates));
+          // Store this frame
+          frames.emplace_back(this->AddFrame(frame));
         }
         this->AnimationNames.emplace_back(animationName);
         this->AnimationTimes.emplace_back(times);
-        this->AnimationFrames.emplace_back(meshes);
+        this->AnimationFrames.emplace_back(frames);
       }
     }
     return true;
@@ -416,17 +444,31 @@ struct vtkF3DQuakeMDLImporter::vtkInternals
         this->Parent, "No frame read, there is nothing to display in this file.");
       return false;
     }
+    this->DecodeFrame(this->AnimationFrames.front().front());
     return ret;
   }
 
   //----------------------------------------------------------------------------
   vtkF3DQuakeMDLImporter* Parent;
-  vtkSmartPointer<vtkPolyDataMapper> Mapper;
   vtkSmartPointer<vtkTexture> Texture;
 
+  // Mesh shared by all frames, only points and normals change when decoding a frame
+  vtkSmartPointer<vtkPolyData> Mesh;
+  size_t DecodedFrame = std::numeric_limits<size_t>::max();
+
+  // Quantized vertices of all frames, NumberOfVertices per frame
+  std::vector<mdl_vertex_t> FrameVertices;
+  size_t NumberOfFrames = 0;
+  int NumberOfVertices = 0;
+  float Scale[3] = { 1.f, 1.f, 1.f };
+  float Translation[3] = { 0.f, 0.f, 0.f };
+
+  // Index of the MDL vertex of each mesh point
+  std::vector<int> PointVertexIndices;
+
   std::vector<std::string> AnimationNames;
   std::vector<std::vector<double>> AnimationTimes;
-  std::vector<std::vector<vtkSmartPointer<vtkPolyData>>> AnimationFrames;
+  std::vector<std::vector<size_t>> AnimationFrames;
 
   vtkIdType ActiveAnimation = -1;
 };
@@ -448,13 +490,12 @@ void vtkF3DQuakeMDLImporter::ImportActors(vtkRenderer* renderer)
 {
   vtkNew<vtkActor> actor;
   vtkNew<vtkPolyDataMapper> mapper;
-  mapper->SetInputData(this->Internals->AnimationFrames[0][0]);
+  mapper->SetInputData(this->Internals->Mesh);
   actor->SetMapper(mapper);
   actor->GetProperty()->SetInterpolationToPBR();
   actor->GetProperty()->SetBaseColorTexture(this->Internals->Texture);
   actor->GetProperty()->SetBaseIOR(1.0);
   renderer->AddActor(actor);
-  this->Internals->Mapper = mapper;
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
   this->ActorCollection->AddItem(actor);
@@ -482,7 +523,7 @@ bool vtkF3DQuakeMDLImporter::UpdateAtTimeValue(double timeValue)
     // If time at index i > timeValue, the choose the previous frame
     const size_t frameIndex = times[i] > timeValue && i > 0 ? i - 1 : i;
 
-    this->Internals->Mapper->SetInputData(
+    this->Internals->DecodeFrame(
       this->Internals->AnimationFrames[this->Internals->ActiveAnimation][frameIndex]);
   }
   return true;
@@ -16,6 +16,7 @@
 #include <Message_PrinterOStream.hxx>
 #include <Message_ProgressIndicator.hxx>
 #include <Poly.hxx>
+#include <Poly_Polygon3D.hxx>
 #include <Poly_Triangulation.hxx>
 #include <Quantity_Color.hxx>
 #include <STEPControl_Reader.hxx>
@@ -26,6 +27,7 @@
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Solid.hxx>
 
 #if F3D_PLUGIN_OCCT_XCAF
@@ -55,14 +57,17 @@
 #include <vtkCommand.h>
 #include <vtkDemandDrivenPipeline.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkPointData.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkTransform.h>
 #include <vtkTransformFilter.h>
 #include <vtkUnsignedCharArray.h>
@@ -70,7 +75,7 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <array>
-#include <numeric>
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -80,6 +85,33 @@ class vtkF3DOCCTReader::vtkInternals
   using StyleMap = XCAFPrs_IndexedDataMapOfShapeStyle;
 #endif
 
+  /* An edge polygon to convert and its location in the output arrays */
+  struct EdgeEntry
+  {
+    Handle(Poly_Polygon3D) Polygon;
+    gp_Trsf Transformation;
+    Standard_Integer NbNodes = 0;
+    vtkIdType PointOffset = 0;
+#if F3D_PLUGIN_OCCT_XCAF
+    std::array<unsigned char, 3> Color = { 0, 0, 0 };
+#endif
+  };
+
+  /* A face triangulation to convert and its location in the output arrays */
+  struct FaceEntry
+  {
+    Handle(Poly_Triangulation) Triangulation;
+    gp_Trsf Transformation;
+    TopAbs_Orientation Orientation = TopAbs_FORWARD;
+    Standard_Integer NbNodes = 0;
+    Standard_Integer NbTriangles = 0;
+    vtkIdType PointOffset = 0;
+    vtkIdType TriangleOffset = 0;
+#if F3D_PLUGIN_OCCT_XCAF
+    std::array<unsigned char, 3> Color = { 255, 255, 255 };
+#endif
+  };
+
 public:
   //----------------------------------------------------------------------------
   explicit vtkInternals(vtkF3DOCCTReader* parent)
@@ -94,23 +126,6 @@ public:
   vtkSmartPointer<vtkPolyData> CreateShape(const TopoDS_Shape& shape)
 #endif
   {
-    vtkNew<vtkPoints> points;
-    vtkNew<vtkFloatArray> normals;
-    normals->SetNumberOfComponents(3);
-    normals->SetName("Normal");
-    vtkNew<vtkFloatArray> uvs;
-    uvs->SetNumberOfComponents(2);
-    uvs->SetName("UV");
-#if F3D_PLUGIN_OCCT_XCAF
-    vtkNew<vtkUnsignedCharArray> colors;
-    colors->SetNumberOfComponents(3);
-    colors->SetName("Colors");
-#endif
-    vtkNew<vtkCellArray> trianglesCells;
-    vtkNew<vtkCellArray> linesCells;
-
-    Standard_Integer shift = 0;
-
 #if F3D_PLUGIN_OCCT_XCAF
     const StyleMap inheritedStyles = this->CollectInheritedStyles(label, shape);
 #endif
@@ -119,6 +134,18 @@ public:
     BRepMesh_IncrementalMesh(shape, this->Parent->GetLinearDeflection(),
       this->Parent->GetRelativeDeflection(), this->Parent->GetAngularDeflection(), Standard_True);
 
+    /*
+     * The conversion is done in two phases: a serial pass collects every edge and face with its
+     * number of nodes and cells and computes its offsets in the output arrays (prefix sum),
+     * then the arrays are filled in parallel. The output ordering is the same as a serial append:
+     * edges first then faces, in explorer order.
+     */
+    std::vector<EdgeEntry> edgeEntries;
+    std::vector<FaceEntry> faceEntries;
+    vtkIdType nbPoints = 0;
+    vtkIdType nbLineConnectivity = 0;
+    vtkIdType nbTriangles = 0;
+
     if (this->Parent->GetReadWire())
     {
       std::vector<TopoDS_Edge> edges;
@@ -138,7 +165,7 @@ public:
           Standard_True);
       }
 
-      // Add all edges to polydata
+      edgeEntries.reserve(edges.size());
       for (const TopoDS_Edge& edge : edges)
       {
         TopLoc_Location location;
@@ -149,51 +176,33 @@ public:
           continue;
         }
 
-        Standard_Integer nbV = poly->NbNodes();
-
-        // Points
-        const TColgp_Array1OfPnt& aNodes = poly->Nodes();
-        for (Standard_Integer i = 1; i <= nbV; i++)
-        {
-          gp_Pnt pt = aNodes(i).Transformed(location);
-          points->InsertNextPoint(pt.X(), pt.Y(), pt.Z());
-
-          // normals and uvs make no sense for lines
-          float fn[3] = { 0.0, 0.0, 1.0 };
-          normals->InsertNextTypedTuple(fn);
-          uvs->InsertNextTypedTuple(fn);
-        }
-
-        std::vector<vtkIdType> polyline(nbV);
-        std::iota(polyline.begin(), polyline.end(), shift);
-        linesCells->InsertNextCell(polyline.size(), polyline.data());
+        EdgeEntry entry;
+        entry.Polygon = poly;
+        entry.Transformation = location.Transformation();
+        entry.NbNodes = poly->NbNodes();
+        entry.PointOffset = nbPoints;
 
 #if F3D_PLUGIN_OCCT_XCAF
-        std::array<unsigned char, 3> rgb = { 0, 0, 0 };
         try
         {
           const auto& style = inheritedStyles.FindFromKey(edge);
           if (style.IsSetColorCurv())
           {
-            Quantity_Color color = style.GetColorCurv();
-            rgb[0] = static_cast<unsigned char>(255.0 * color.Red());
-            rgb[1] = static_cast<unsigned char>(255.0 * color.Green());
-            rgb[2] = static_cast<unsigned char>(255.0 * color.Blue());
+            entry.Color = ToRGB(style.GetColorCurv());
           }
         }
         catch (Standard_NoSuchObject&)
         {
           /* edge has no style, safe to ignore */
         }
-
-        colors->InsertNextTypedTuple(rgb.data());
 #endif
 
-        shift += nbV;
+        nbPoints += entry.NbNodes;
+        edgeEntries.emplace_back(std::move(entry));
       }
+      nbLineConnectivity = nbPoints;
     }
 
-    // Add all faces to polydata
     for (TopExp_Explorer exFace(shape, TopAbs_FACE); exFace.More(); exFace.Next())
     {
       TopoDS_Face face = TopoDS::Face(exFace.Current());
@@ -206,99 +215,207 @@ public:
         continue;
       }
 
+      // Triangulations can be shared between faces, so normals are computed serially
       Poly::ComputeNormals(poly);
-      TopAbs_Orientation faceOrientation = face.Orientation();
-
-      Standard_Integer nbT = poly->NbTriangles();
-      Standard_Integer nbV = poly->NbNodes();
 
-      // Points
-      for (Standard_Integer i = 1; i <= nbV; i++)
-      {
-        gp_Pnt pt = poly->Node(i).Transformed(location);
-        points->InsertNextPoint(pt.X(), pt.Y(), pt.Z());
-      }
+      FaceEntry entry;
+      entry.Triangulation = poly;
+      entry.Transformation = location.Transformation();
+      entry.Orientation = face.Orientation();
+      entry.NbNodes = poly->NbNodes();
+      entry.NbTriangles = poly->NbTriangles();
+      entry.PointOffset = nbPoints;
+      entry.TriangleOffset = nbTriangles;
 
-      // Normals
-      if (poly->HasNormals())
+#if F3D_PLUGIN_OCCT_XCAF
+      try
       {
-        for (Standard_Integer i = 1; i <= nbV; i++)
+        const auto& style = inheritedStyles.FindFromKey(face);
+        if (style.IsSetColorSurf())
         {
-          gp_Dir n = poly->Normal(i);
-          float fn[3] = { static_cast<float>(n.X()), static_cast<float>(n.Y()),
-            static_cast<float>(n.Z()) };
-          if (faceOrientation == TopAbs_Orientation::TopAbs_REVERSED)
-          {
-            vtkMath::MultiplyScalar(fn, -1.f);
-          }
-          normals->InsertNextTypedTuple(fn);
+          entry.Color = ToRGB(style.GetColorSurf());
         }
       }
-      else
+      catch (Standard_NoSuchObject&)
       {
-        // just in case a face does not have normals, add a dummy normal
-        float fn[3] = { 0.0, 0.0, 1.0 };
-        for (Standard_Integer i = 1; i <= nbV; i++)
-        {
-          normals->InsertNextTypedTuple(fn);
-        }
+        /* face has no style, safe to ignore */
       }
+#endif
 
-      // UVs
-      if (poly->HasUVNodes())
-      {
-        for (Standard_Integer i = 1; i <= nbV; i++)
-        {
-          gp_Pnt2d uv = poly->UVNode(i);
-          float fn[2] = { static_cast<float>(uv.X()), static_cast<float>(uv.Y()) };
-          uvs->InsertNextTypedTuple(fn);
-        }
-      }
-      else
-      {
-        uvs->SetNumberOfTuples(nbV);
-        uvs->Fill(0.0);
-      }
+      nbPoints += entry.NbNodes;
+      nbTriangles += entry.NbTriangles;
+      faceEntries.emplace_back(std::move(entry));
+    }
 
-      for (int i = 1; i <= nbT; i++)
-      {
-        int n1, n2, n3;
-        poly->Triangle(i).Get(n1, n2, n3);
+    const vtkIdType nbLines = static_cast<vtkIdType>(edgeEntries.size());
 
-        vtkIdType cell[3] = { shift + n1 - 1, shift + n2 - 1, shift + n3 - 1 };
-        if (faceOrientation != TopAbs_Orientation::TopAbs_FORWARD)
-        {
-          std::swap(cell[0], cell[2]);
-        }
-        trianglesCells->InsertNextCell(3, cell);
-      }
+    vtkNew<vtkFloatArray> pointsArray;
+    pointsArray->SetNumberOfComponents(3);
+    pointsArray->SetNumberOfTuples(nbPoints);
+    vtkNew<vtkFloatArray> normals;
+    normals->SetNumberOfComponents(3);
+    normals->SetNumberOfTuples(nbPoints);
+    normals->SetName("Normal");
+    vtkNew<vtkFloatArray> uvs;
+    uvs->SetNumberOfComponents(2);
+    uvs->SetNumberOfTuples(nbPoints);
+    uvs->SetName("UV");
+#if F3D_PLUGIN_OCCT_XCAF
+    vtkNew<vtkUnsignedCharArray> colors;
+    colors->SetNumberOfComponents(3);
+    colors->SetNumberOfTuples(nbLines + nbTriangles);
+    colors->SetName("Colors");
+#endif
 
+    vtkNew<vtkIdTypeArray> linesOffsets;
+    linesOffsets->SetNumberOfTuples(nbLines + 1);
+    vtkNew<vtkIdTypeArray> linesConnectivity;
+    linesConnectivity->SetNumberOfTuples(nbLineConnectivity);
+    vtkNew<vtkIdTypeArray> trianglesOffsets;
+    trianglesOffsets->SetNumberOfTuples(nbTriangles + 1);
+    vtkNew<vtkIdTypeArray> trianglesConnectivity;
+    trianglesConnectivity->SetNumberOfTuples(3 * nbTriangles);
+
+    float* pointsPtr = pointsArray->GetPointer(0);
+    float* normalsPtr = normals->GetPointer(0);
+    float* uvsPtr = uvs->GetPointer(0);
 #if F3D_PLUGIN_OCCT_XCAF
-      std::array<unsigned char, 3> rgb = { 255, 255, 255 };
-      try
+    unsigned char* colorsPtr = colors->GetPointer(0);
+#endif
+    vtkIdType* linesOffsetsPtr = linesOffsets->GetPointer(0);
+    vtkIdType* linesConnectivityPtr = linesConnectivity->GetPointer(0);
+    vtkIdType* trianglesOffsetsPtr = trianglesOffsets->GetPointer(0);
+    vtkIdType* trianglesConnectivityPtr = trianglesConnectivity->GetPointer(0);
+
+    // Add all edges to polydata
+    linesOffsetsPtr[nbLines] = nbLineConnectivity;
+    vtkSMPTools::For(0, nbLines,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        const auto& style = inheritedStyles.FindFromKey(face);
-        if (style.IsSetColorSurf())
+        for (vtkIdType e = begin; e < end; e++)
         {
-          Quantity_Color color = style.GetColorSurf();
-          rgb[0] = static_cast<unsigned char>(255.0 * color.Red());
-          rgb[1] = static_cast<unsigned char>(255.0 * color.Green());
-          rgb[2] = static_cast<unsigned char>(255.0 * color.Blue());
+          const EdgeEntry& entry = edgeEntries[e];
+          const TColgp_Array1OfPnt& nodes = entry.Polygon->Nodes();
+          const vtkIdType shift = entry.PointOffset;
+
+          for (Standard_Integer i = 0; i < entry.NbNodes; i++)
+          {
+            const vtkIdType id = shift + i;
+            const gp_Pnt pt = nodes(nodes.Lower() + i).Transformed(entry.Transformation);
+            float* p = pointsPtr + 3 * id;
+            p[0] = static_cast<float>(pt.X());
+            p[1] = static_cast<float>(pt.Y());
+            p[2] = static_cast<float>(pt.Z());
+
+            // normals and uvs make no sense for lines
+            float* n = normalsPtr + 3 * id;
+            n[0] = 0.f;
+            n[1] = 0.f;
+            n[2] = 1.f;
+            uvsPtr[2 * id] = 0.f;
+            uvsPtr[2 * id + 1] = 0.f;
+
+            linesConnectivityPtr[id] = id;
+          }
+          linesOffsetsPtr[e] = shift;
+
+#if F3D_PLUGIN_OCCT_XCAF
+          std::copy(entry.Color.begin(), entry.Color.end(), colorsPtr + 3 * e);
+#endif
         }
-      }
-      catch (Standard_NoSuchObject&)
-      {
-        /* face has no style, safe to ignore */
-      }
+      });
 
-      for (int i = 1; i <= nbT; i++)
+    // Add all faces to polydata
+    trianglesOffsetsPtr[nbTriangles] = 3 * nbTriangles;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(faceEntries.size()),
+      [&](vtkIdType begin, vtkIdType end)
       {
-        colors->InsertNextTypedTuple(rgb.data());
-      }
+        for (vtkIdType f = begin; f < end; f++)
+        {
+          const FaceEntry& entry = faceEntries[f];
+          const Handle(Poly_Triangulation)& poly = entry.Triangulation;
+          const vtkIdType shift = entry.PointOffset;
+          const bool reversed = entry.Orientation == TopAbs_Orientation::TopAbs_REVERSED;
+          const bool hasNormals = poly->HasNormals();
+          const bool hasUVs = poly->HasUVNodes();
+
+          for (Standard_Integer i = 1; i <= entry.NbNodes; i++)
+          {
+            const vtkIdType id = shift + i - 1;
+
+            // Points
+            const gp_Pnt pt = poly->Node(i).Transformed(entry.Transformation);
+            float* p = pointsPtr + 3 * id;
+            p[0] = static_cast<float>(pt.X());
+            p[1] = static_cast<float>(pt.Y());
+            p[2] = static_cast<float>(pt.Z());
+
+            // Normals, just in case a face does not have normals, add a dummy normal
+            float* n = normalsPtr + 3 * id;
+            if (hasNormals)
+            {
+              const gp_Dir dir = poly->Normal(i);
+              n[0] = static_cast<float>(dir.X());
+              n[1] = static_cast<float>(dir.Y());
+              n[2] = static_cast<float>(dir.Z());
+              if (reversed)
+              {
+                vtkMath::MultiplyScalar(n, -1.f);
+              }
+            }
+            else
+            {
+              n[0] = 0.f;
+              n[1] = 0.f;
+              n[2] = 1.f;
+            }
+
+            // UVs
+            float* uv = uvsPtr + 2 * id;
+            if (hasUVs)
+            {
+              const gp_Pnt2d uvNode = poly->UVNode(i);
+              uv[0] = static_cast<float>(uvNode.X());
+              uv[1] = static_cast<float>(uvNode.Y());
+            }
+            else
+            {
+              uv[0] = 0.f;
+              uv[1] = 0.f;
+            }
+          }
+
+          for (Standard_Integer i = 1; i <= entry.NbTriangles; i++)
+          {
+            const vtkIdType cellId = entry.TriangleOffset + i - 1;
+
+            int n1, n2, n3;
+            poly->Triangle(i).Get(n1, n2, n3);
+
+            vtkIdType* cell = trianglesConnectivityPtr + 3 * cellId;
+            cell[0] = shift + n1 - 1;
+            cell[1] = shift + n2 - 1;
+            cell[2] = shift + n3 - 1;
+            if (entry.Orientation != TopAbs_Orientation::TopAbs_FORWARD)
+            {
+              std::swap(cell[0], cell[2]);
+            }
+            trianglesOffsetsPtr[cellId] = 3 * cellId;
+
+#if F3D_PLUGIN_OCCT_XCAF
+            std::copy(entry.Color.begin(), entry.Color.end(), colorsPtr + 3 * (nbLines + cellId));
 #endif
+          }
+        }
+      });
 
-      shift += nbV;
-    }
+    vtkNew<vtkPoints> points;
+    points->SetData(pointsArray);
+
+    vtkNew<vtkCellArray> linesCells;
+    linesCells->SetData(linesOffsets, linesConnectivity);
+    vtkNew<vtkCellArray> trianglesCells;
+    trianglesCells->SetData(trianglesOffsets, trianglesConnectivity);
 
     vtkNew<vtkPolyData> polydata;
     polydata->SetPoints(points);
@@ -316,6 +433,15 @@ public:
   }
 
 #if F3D_PLUGIN_OCCT_XCAF
+  //----------------------------------------------------------------------------
+  static std::array<unsigned char, 3> ToRGB(const Quantity_Color& color)
+  {
+    return { static_cast<unsigned char>(255.0 * color.Red()),
+      static_cast<unsigned char>(255.0 * color.Green()),
+      static_cast<unsigned char>(255.0 * color.Blue()) };
+  }
+
+  //----------------------------------------------------------------------------
   StyleMap CollectInheritedStyles(const TDF_Label& rootLabel, const TopoDS_Shape& rootShape)
   {
     StyleMap inheritedStyles;
@@ -8,6 +8,7 @@
 #include <vtkCylinderSource.h>
 #include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
+#include <vtkGlyph3DMapper.h>
 #include <vtkImageAppendComponents.h>
 #include <vtkImageData.h>
 #include <vtkImageExtractComponents.h>
@@ -16,6 +17,7 @@
 #include <vtkImageResize.h>
 #include <vtkInformation.h>
 #include <vtkInformationStringKey.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
@@ -26,6 +28,7 @@
 #include <vtkPolyDataTangents.h>
 #include <vtkProperty.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkSphereSource.h>
 #include <vtkTexture.h>
@@ -38,6 +41,11 @@
 #include <vtkCapsuleSource.h>
 #endif
 
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <unordered_set>
+
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Weverything"
@@ -235,9 +243,36 @@ public:
       renderer->AddActor(actor);
     }
 
+    if (this->CurrentInstancing)
+    {
+      this->SetInstancedMapper(actor, actorPath.GetAsString(), mat, polydata);
+      return;
+    }
+
+    // keep the existing mapper if the geometry did not change, only the transform is updated
+    vtkSmartPointer<vtkPolyData>& actorInput = this->ActorInputMap[actorPath.GetAsString()];
+    if (actor->GetMapper() && actorInput == polydata)
+    {
+      actor->SetUserMatrix(mat);
+      return;
+    }
+    actorInput = polydata;
+
     // set mapper
     vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputData(this->PrepareGeometry(actor, polydata));
 
+    if (!this->HasTimeCode())
+    {
+      mapper->StaticOn();
+    }
+
+    actor->SetMapper(mapper);
+    actor->SetUserMatrix(mat);
+  }
+
+  vtkSmartPointer<vtkPolyData> PrepareGeometry(vtkActor* actor, vtkPolyData* polydata)
+  {
     if (actor->GetProperty()->GetTexture("normalTex"))
     {
       vtkNew<vtkTriangleFilter> triangulate;
@@ -249,472 +284,767 @@ public:
       vtkNew<vtkPolyDataTangents> tangents;
       tangents->SetInputConnection(normals->GetOutputPort());
       tangents->Update();
-      mapper->SetInputData(tangents->GetOutput());
+      return tangents->GetOutput();
     }
-    else
+
+    return polydata;
+  }
+
+  void SetInstancedMapper(
+    vtkActor* actor, const std::string& actorPath, vtkMatrix4x4* mat, vtkPolyData* polydata)
+  {
+    // the instances polydata is updated in place, so if the prototype geometry did not change
+    // the existing mapper only has to upload the new instance transforms
+    InstancedSource& source = this->InstancedSourceMap[actorPath];
+    vtkGlyph3DMapper* existingMapper = vtkGlyph3DMapper::SafeDownCast(actor->GetMapper());
+    if (existingMapper && source.Geometry == polydata &&
+      std::equal(source.Matrix.cbegin(), source.Matrix.cend(), mat->GetData()))
+    {
+      existingMapper->SetInputData(this->CurrentInstancing->Instances);
+      actor->SetUserMatrix(this->CurrentInstancing->Matrix);
+      return;
+    }
+
+    source.Geometry = polydata;
+    std::copy(mat->GetData(), mat->GetData() + 16, source.Matrix.begin());
+
+    // the transform of the prototype is baked into the glyph source
+    vtkSmartPointer<vtkPolyData> geometry = this->PrepareGeometry(actor, polydata);
+    if (!mat->IsIdentity())
     {
-      mapper->SetInputData(polydata);
+      vtkNew<vtkTransform> transform;
+      transform->SetMatrix(mat);
+
+      vtkNew<vtkTransformFilter> transformFilter;
+      transformFilter->SetTransform(transform);
+      transformFilter->SetInputData(geometry);
+      transformFilter->Update();
+      geometry = vtkPolyData::SafeDownCast(transformFilter->GetOutput());
     }
 
+    vtkNew<vtkGlyph3DMapper> mapper;
+    mapper->SetInputData(this->CurrentInstancing->Instances);
+    mapper->SetSourceData(geometry);
+    mapper->OrientOn();
+    mapper->SetOrientationModeToQuaternion();
+    mapper->SetOrientationArray("Orientation");
+    mapper->ScalingOn();
+    mapper->SetScaleModeToScaleByVectorComponents();
+    mapper->SetScaleArray("Scale");
+
     if (!this->HasTimeCode())
     {
       mapper->StaticOn();
     }
 
     actor->SetMapper(mapper);
-    actor->SetUserMatrix(mat);
+    actor->SetUserMatrix(this->CurrentInstancing->Matrix);
   }
 
-  void ImportNode(vtkRenderer* renderer, const pxr::UsdPrim& node, const pxr::SdfPath& path,
-    vtkMatrix4x4* currentMatrix)
+  /**
+   * Decompose an instance transform into a position, a quaternion and a scale.
+   * Point instancer transforms are composed of a scale, a rotation and a translation,
+   * only a shear coming from a prototype transform would be lost.
+   */
+  static void DecomposeInstanceMatrix(
+    const pxr::GfMatrix4d& mat, double position[3], double orientation[4], double scale[3])
   {
-    pxr::UsdTimeCode timeCode = this->CurrentTime * this->Stage->GetTimeCodesPerSecond();
+    // USD matrices are row-major and transform row vectors
+    double rotation[3][3];
+    for (int j = 0; j < 3; j++)
+    {
+      position[j] = mat[3][j];
 
-    // simple range-for iteration
-    for (pxr::UsdPrim prim : pxr::UsdPrimSiblingRange(node.GetAllChildren()))
+      scale[j] = std::sqrt(mat[j][0] * mat[j][0] + mat[j][1] * mat[j][1] + mat[j][2] * mat[j][2]);
+      for (int i = 0; i < 3; i++)
+      {
+        rotation[i][j] = scale[j] > 0.0 ? mat[j][i] / scale[j] : (i == j ? 1.0 : 0.0);
+      }
+    }
+
+    if (vtkMath::Determinant3x3(rotation) < 0.0)
     {
-      if (prim.IsA<pxr::UsdGeomImageable>())
+      scale[0] = -scale[0];
+      for (int i = 0; i < 3; i++)
       {
-        pxr::UsdGeomImageable imageable = pxr::UsdGeomImageable(prim);
+        rotation[i][0] = -rotation[i][0];
+      }
+    }
 
-        pxr::TfToken visibility;
-        pxr::UsdAttribute visAttr = imageable.GetVisibilityAttr();
-        if (visAttr && visAttr.HasAuthoredValue() && visAttr.Get(&visibility, timeCode) &&
-          visibility == pxr::UsdGeomTokens->invisible)
+    vtkMath::Matrix3x3ToQuaternion(rotation, orientation);
+  }
+
+  void FillInstances(vtkPolyData* instances, const pxr::VtMatrix4dArray& xforms,
+    const std::vector<size_t>& instanceIds)
+  {
+    const vtkIdType nbInstances = static_cast<vtkIdType>(instanceIds.size());
+
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToDouble();
+    points->SetNumberOfPoints(nbInstances);
+
+    vtkNew<vtkDoubleArray> orientations;
+    orientations->SetName("Orientation");
+    orientations->SetNumberOfComponents(4);
+    orientations->SetNumberOfTuples(nbInstances);
+
+    vtkNew<vtkDoubleArray> scales;
+    scales->SetName("Scale");
+    scales->SetNumberOfComponents(3);
+    scales->SetNumberOfTuples(nbInstances);
+
+    double* positionsPtr = vtkDoubleArray::SafeDownCast(points->GetData())->GetPointer(0);
+    double* orientationsPtr = orientations->GetPointer(0);
+    double* scalesPtr = scales->GetPointer(0);
+
+    vtkSMPTools::For(0, nbInstances,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
         {
-          // not visible, skip
-          continue;
+          DecomposeInstanceMatrix(xforms[instanceIds[i]], positionsPtr + 3 * i,
+            orientationsPtr + 4 * i, scalesPtr + 3 * i);
         }
+      });
+
+    instances->SetPoints(points);
+    instances->GetPointData()->AddArray(orientations);
+    instances->GetPointData()->AddArray(scales);
+  }
 
-        pxr::TfToken purpose;
-        pxr::UsdAttribute purpAttr = imageable.GetPurposeAttr();
-        if (purpAttr && purpAttr.HasAuthoredValue() && purpAttr.Get(&purpose, timeCode) &&
-          (purpose == pxr::UsdGeomTokens->proxy || purpose == pxr::UsdGeomTokens->guide))
+  void ImportNode(vtkRenderer* renderer, const pxr::UsdPrim& node, const pxr::SdfPath& path,
+    vtkMatrix4x4* currentMatrix)
+  {
+    // simple range-for iteration
+    for (const pxr::UsdPrim& prim : pxr::UsdPrimSiblingRange(node.GetAllChildren()))
+    {
+      this->ImportPrim(renderer, prim, path, currentMatrix);
+    }
+  }
+
+  void ImportPrim(vtkRenderer* renderer, const pxr::UsdPrim& prim, const pxr::SdfPath& path,
+    vtkMatrix4x4* currentMatrix)
+  {
+    pxr::SdfPath primPath = path.AppendChild(prim.GetName());
+
+    if (!this->Classified)
+    {
+      // first import, classify the prims that can change over time
+      if (this->IsPrimTimeVarying(prim))
+      {
+        this->MarkAnimated(primPath);
+      }
+      this->ImportPrimContent(renderer, prim, path, currentMatrix);
+    }
+    else if (this->ImportingAnimatedSubtree)
+    {
+      this->ImportPrimContent(renderer, prim, path, currentMatrix);
+    }
+    else
+    {
+      // on time change, only the animated prims and their ancestors are traversed,
+      // static prims keep the actors created by the first import
+      const std::string primPathString = primPath.GetAsString();
+      if (this->AnimatedPaths.count(primPathString) > 0)
+      {
+        this->ImportingAnimatedSubtree = true;
+        this->ImportPrimContent(renderer, prim, path, currentMatrix);
+        this->ImportingAnimatedSubtree = false;
+      }
+      else if (this->AnimatedAncestorPaths.count(primPathString) > 0)
+      {
+        this->ImportPrimContent(renderer, prim, path, currentMatrix);
+      }
+    }
+  }
+
+  /**
+   * Check if any attribute of a prim, or of its geom subsets, might be time-varying.
+   * This covers transforms, visibility, mesh attributes, primvars and point instancer attributes.
+   */
+  static bool IsPrimTimeVarying(const pxr::UsdPrim& prim)
+  {
+    auto TimeVarying = [](const pxr::UsdAttribute& a) { return a.ValueMightBeTimeVarying(); };
+
+    std::vector<pxr::UsdAttribute> attributes = prim.GetAttributes();
+    if (std::any_of(attributes.cbegin(), attributes.cend(), TimeVarying))
+    {
+      return true;
+    }
+
+    if (prim.IsA<pxr::UsdGeomGprim>())
+    {
+      for (const pxr::UsdGeomSubset& subset :
+        pxr::UsdGeomSubset::GetGeomSubsets(pxr::UsdGeomGprim(prim)))
+      {
+        if (TimeVarying(subset.GetIndicesAttr()))
         {
-          // proxy, skip
-          continue;
+          return true;
         }
       }
+    }
 
-      if (prim.IsInstance())
+    return false;
+  }
+
+  /**
+   * Check if any of the given attributes of a prim might be time-varying
+   */
+  static bool IsAnyTimeVarying(const pxr::UsdPrim& prim, std::initializer_list<pxr::TfToken> names)
+  {
+    return std::any_of(names.begin(), names.end(),
+      [&](const pxr::TfToken& name)
       {
-        pxr::UsdGeomXform xform = pxr::UsdGeomXform(prim);
+        pxr::UsdAttribute attr = prim.GetAttribute(name);
+        return attr && attr.ValueMightBeTimeVarying();
+      });
+  }
 
-        auto mat = this->GetLocalTransform(xform, timeCode);
-        vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+  void MarkAnimated(const pxr::SdfPath& primPath)
+  {
+    this->AnimatedPaths.insert(primPath.GetAsString());
+    for (pxr::SdfPath parent = primPath.GetParentPath(); !parent.IsEmpty();
+         parent = parent.GetParentPath())
+    {
+      this->AnimatedAncestorPaths.insert(parent.GetAsString());
+    }
+  }
 
-        this->ImportNode(renderer, prim.GetPrototype(), path.AppendChild(prim.GetName()), mat);
+  void ImportPrimContent(vtkRenderer* renderer, const pxr::UsdPrim& prim,
+    const pxr::SdfPath& path, vtkMatrix4x4* currentMatrix)
+  {
+    pxr::UsdTimeCode timeCode = this->CurrentTime * this->Stage->GetTimeCodesPerSecond();
+
+    if (prim.IsA<pxr::UsdGeomImageable>())
+    {
+      pxr::UsdGeomImageable imageable = pxr::UsdGeomImageable(prim);
+
+      pxr::TfToken visibility;
+      pxr::UsdAttribute visAttr = imageable.GetVisibilityAttr();
+      if (visAttr && visAttr.HasAuthoredValue() && visAttr.Get(&visibility, timeCode) &&
+        visibility == pxr::UsdGeomTokens->invisible)
+      {
+        // not visible, skip
+        return;
       }
-      else if (prim.IsA<pxr::UsdGeomPointInstancer>())
+
+      pxr::TfToken purpose;
+      pxr::UsdAttribute purpAttr = imageable.GetPurposeAttr();
+      if (purpAttr && purpAttr.HasAuthoredValue() && purpAttr.Get(&purpose, timeCode) &&
+        (purpose == pxr::UsdGeomTokens->proxy || purpose == pxr::UsdGeomTokens->guide))
       {
-        pxr::UsdGeomPointInstancer glyphs = pxr::UsdGeomPointInstancer(prim);
+        // proxy, skip
+        return;
+      }
+    }
 
-        // TODO: Ideally, we should use the 3D glyph mapper, but it's left for future work
-        // See https://github.com/f3d-app/f3d/issues/1075
-        pxr::VtMatrix4dArray xforms;
+    if (prim.IsInstance())
+    {
+      pxr::UsdGeomXform xform = pxr::UsdGeomXform(prim);
 
-        if (glyphs.ComputeInstanceTransformsAtTime(&xforms, timeCode, timeCode))
+      auto mat = this->GetLocalTransform(xform, timeCode);
+      vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+
+      this->ImportNode(renderer, prim.GetPrototype(), path.AppendChild(prim.GetName()), mat);
+    }
+    else if (prim.IsA<pxr::UsdGeomPointInstancer>())
+    {
+      pxr::UsdGeomPointInstancer instancer = pxr::UsdGeomPointInstancer(prim);
+      pxr::SdfPath instancerPath = path.AppendChild(prim.GetName());
+
+      // the mask is applied separately so that transforms and prototype indices stay aligned
+      pxr::VtMatrix4dArray xforms;
+      pxr::VtIntArray protoIndices;
+      pxr::SdfPathVector protoPaths;
+      if (!instancer.ComputeInstanceTransformsAtTime(&xforms, timeCode, timeCode,
+            pxr::UsdGeomPointInstancer::IncludeProtoXform,
+            pxr::UsdGeomPointInstancer::IgnoreMask) ||
+        !instancer.GetProtoIndicesAttr().Get(&protoIndices, timeCode) ||
+        !instancer.GetPrototypesRel().GetTargets(&protoPaths))
+      {
+        return;
+      }
+
+      const std::vector<bool> mask = instancer.ComputeMaskAtTime(timeCode);
+      const size_t nbInstances = std::min(xforms.size(), protoIndices.size());
+
+      for (size_t protoIndex = 0; protoIndex < protoPaths.size(); protoIndex++)
+      {
+        pxr::UsdPrim proto = this->Stage->GetPrimAtPath(protoPaths[protoIndex]);
+        if (!proto)
+        {
+          continue;
+        }
+
+        std::vector<size_t> instanceIds;
+        for (size_t i = 0; i < nbInstances; i++)
+        {
+          if (protoIndices[i] == static_cast<int>(protoIndex) && (mask.empty() || mask[i]))
+          {
+            instanceIds.emplace_back(i);
+          }
+        }
+
+        if (this->CurrentInstancing)
         {
-          int i = 0;
-          for (const pxr::GfMatrix4d& currInstMatrix : xforms)
+          // nested point instancer, expand the instances inside the prototype of the outer one
+          for (size_t i : instanceIds)
           {
-            auto mat = this->ConvertMatrix(currInstMatrix);
+            auto mat = this->ConvertMatrix(xforms[i]);
             vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
 
-            pxr::TfToken tok(std::string("instance_") + std::to_string(i++));
+            pxr::TfToken tok(std::string("instance_") + std::to_string(i));
 
-            this->ImportNode(
-              renderer, prim, path.AppendChild(prim.GetName()).AppendChild(tok), mat);
+            this->ImportPrim(renderer, proto, instancerPath.AppendChild(tok), mat);
+          }
+        }
+        else
+        {
+          // all instances of a prototype are rendered at once by a glyph mapper
+          vtkSmartPointer<vtkPolyData>& instances =
+            this->InstancesMap[instancerPath.AppendChild(proto.GetName()).GetAsString()];
+          if (!instances)
+          {
+            instances = vtkSmartPointer<vtkPolyData>::New();
           }
+          this->FillInstances(instances, xforms, instanceIds);
+
+          InstancingContext context{ instances, currentMatrix };
+          this->CurrentInstancing = &context;
+
+          vtkNew<vtkMatrix4x4> identity;
+          this->ImportPrim(renderer, proto, instancerPath, identity);
+
+          this->CurrentInstancing = nullptr;
         }
       }
-      else if (prim.IsA<pxr::UsdGeomGprim>())
+    }
+    else if (prim.IsA<pxr::UsdGeomGprim>())
+    {
+      pxr::UsdGeomGprim geomPrim = pxr::UsdGeomGprim(prim);
+
+      vtkSmartPointer<vtkPolyData> polydata;
+
+      if (prim.IsA<pxr::UsdGeomMesh>())
       {
-        pxr::UsdGeomGprim geomPrim = pxr::UsdGeomGprim(prim);
+        pxr::UsdGeomMesh meshPrim = pxr::UsdGeomMesh(prim);
 
-        vtkSmartPointer<vtkPolyData> polydata;
+        vtkSmartPointer<vtkPolyData>& mappedPolydata =
+          this->MeshMap[meshPrim.GetPath().GetAsString()];
+        bool meshAlreadyExists = (mappedPolydata != nullptr);
 
-        if (prim.IsA<pxr::UsdGeomMesh>())
-        {
-          pxr::UsdGeomMesh meshPrim = pxr::UsdGeomMesh(prim);
+        // attributes
+        pxr::UsdAttribute normalsAttr = meshPrim.GetNormalsAttr();
+        pxr::UsdAttribute pointsAttr = meshPrim.GetPointsAttr();
+        pxr::UsdAttribute facesCountAttr = meshPrim.GetFaceVertexCountsAttr();
+        pxr::UsdAttribute facesIndicesAttr = meshPrim.GetFaceVertexIndicesAttr();
 
-          vtkSmartPointer<vtkPolyData>& mappedPolydata =
-            this->MeshMap[meshPrim.GetPath().GetAsString()];
-          bool meshAlreadyExists = (mappedPolydata != nullptr);
+        std::vector<pxr::UsdGeomPrimvar> primVars =
+          pxr::UsdGeomPrimvarsAPI(meshPrim).GetPrimvars();
 
-          // attributes
-          pxr::UsdAttribute normalsAttr = meshPrim.GetNormalsAttr();
-          pxr::UsdAttribute pointsAttr = meshPrim.GetPointsAttr();
-          pxr::UsdAttribute facesCountAttr = meshPrim.GetFaceVertexCountsAttr();
-          pxr::UsdAttribute facesIndicesAttr = meshPrim.GetFaceVertexIndicesAttr();
+        auto TimeVarying = [](const auto& a) { return a.ValueMightBeTimeVarying(); };
 
-          std::vector<pxr::UsdGeomPrimvar> primVars =
-            pxr::UsdGeomPrimvarsAPI(meshPrim).GetPrimvars();
+        bool animatedAttribute = std::any_of(primVars.cbegin(), primVars.cend(), TimeVarying);
+        animatedAttribute = animatedAttribute || TimeVarying(pointsAttr);
+        animatedAttribute = animatedAttribute || TimeVarying(normalsAttr);
+        animatedAttribute = animatedAttribute || TimeVarying(facesCountAttr);
+        animatedAttribute = animatedAttribute || TimeVarying(facesIndicesAttr);
 
-          auto TimeVarying = [](const auto& a) { return a.ValueMightBeTimeVarying(); };
+        // Check if the mesh has to be rebuilt
+        if (!meshAlreadyExists || animatedAttribute)
+        {
+          vtkNew<vtkPolyData> newPolyData;
 
-          bool animatedAttribute = std::any_of(primVars.cbegin(), primVars.cend(), TimeVarying);
-          animatedAttribute = animatedAttribute || TimeVarying(pointsAttr);
-          animatedAttribute = animatedAttribute || TimeVarying(normalsAttr);
-          animatedAttribute = animatedAttribute || TimeVarying(facesCountAttr);
-          animatedAttribute = animatedAttribute || TimeVarying(facesIndicesAttr);
+          // normals
+          pxr::VtArray<pxr::GfVec3f> normals;
+          normalsAttr.Get(&normals, timeCode);
 
-          // Check if the mesh has to be rebuilt
-          if (!meshAlreadyExists || animatedAttribute)
+          if (normals.size() > 0)
           {
-            vtkNew<vtkPolyData> newPolyData;
+            vtkNew<vtkFloatArray> vNormals;
+            vNormals->SetName("Normals");
+            vNormals->SetNumberOfComponents(3);
+            vNormals->Allocate(normals.size());
 
-            // normals
-            pxr::VtArray<pxr::GfVec3f> normals;
-            normalsAttr.Get(&normals, timeCode);
-
-            if (normals.size() > 0)
+            for (const pxr::GfVec3f& n : normals)
             {
-              vtkNew<vtkFloatArray> vNormals;
-              vNormals->SetName("Normals");
-              vNormals->SetNumberOfComponents(3);
-              vNormals->Allocate(normals.size());
-
-              for (const pxr::GfVec3f& n : normals)
-              {
-                vNormals->InsertNextTuple3(n[0], n[1], n[2]);
-              }
+              vNormals->InsertNextTuple3(n[0], n[1], n[2]);
+            }
 
-              vtkInformation* info = vNormals->GetInformation();
-              info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
-                meshPrim.GetNormalsInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
+            vtkInformation* info = vNormals->GetInformation();
+            info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
+              meshPrim.GetNormalsInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
 
-              newPolyData->GetPointData()->SetNormals(vNormals);
-            }
+            newPolyData->GetPointData()->SetNormals(vNormals);
+          }
 
-            // texture coordinates
-            bool firstArray = true;
-            for (const pxr::UsdGeomPrimvar& primVar : primVars)
+          // texture coordinates
+          bool firstArray = true;
+          for (const pxr::UsdGeomPrimvar& primVar : primVars)
+          {
+            if (primVar.GetTypeName() == "texCoord2f[]" || primVar.GetTypeName() == "float2[]")
             {
-              if (primVar.GetTypeName() == "texCoord2f[]" || primVar.GetTypeName() == "float2[]")
+              pxr::VtArray<pxr::GfVec2f> uvs;
+              primVar.Get(&uvs, timeCode);
+
+              if (uvs.size() > 0)
               {
-                pxr::VtArray<pxr::GfVec2f> uvs;
-                primVar.Get(&uvs, timeCode);
+                std::string name = primVar.GetPrimvarName();
 
-                if (uvs.size() > 0)
-                {
-                  std::string name = primVar.GetPrimvarName();
+                vtkNew<vtkFloatArray> texCoords;
+                texCoords->SetName(name.c_str());
+                texCoords->SetNumberOfComponents(2);
 
-                  vtkNew<vtkFloatArray> texCoords;
-                  texCoords->SetName(name.c_str());
-                  texCoords->SetNumberOfComponents(2);
+                if (primVar.IsIndexed())
+                {
+                  pxr::UsdAttribute indicesAttr = primVar.GetIndicesAttr();
 
-                  if (primVar.IsIndexed())
+                  pxr::VtArray<int> indices;
+                  if (indicesAttr.Get(&indices) && indices.size() > 0)
                   {
-                    pxr::UsdAttribute indicesAttr = primVar.GetIndicesAttr();
+                    texCoords->Allocate(indices.size());
 
-                    pxr::VtArray<int> indices;
-                    if (indicesAttr.Get(&indices) && indices.size() > 0)
+                    for (int index : indices)
                     {
-                      texCoords->Allocate(indices.size());
-
-                      for (int index : indices)
-                      {
-                        const pxr::GfVec2f& uv = uvs[index];
-                        texCoords->InsertNextTuple2(uv[0], uv[1]);
-                      }
+                      const pxr::GfVec2f& uv = uvs[index];
+                      texCoords->InsertNextTuple2(uv[0], uv[1]);
                     }
                   }
-                  else
-                  {
-                    texCoords->Allocate(uvs.size());
+                }
+                else
+                {
+                  texCoords->Allocate(uvs.size());
 
-                    for (const pxr::GfVec2f& uv : uvs)
-                    {
-                      texCoords->InsertNextTuple2(uv[0], uv[1]);
-                    }
+                  for (const pxr::GfVec2f& uv : uvs)
+                  {
+                    texCoords->InsertNextTuple2(uv[0], uv[1]);
                   }
+                }
 
-                  vtkInformation* info = texCoords->GetInformation();
-                  info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
-                    primVar.GetInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
+                vtkInformation* info = texCoords->GetInformation();
+                info->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(),
+                  primVar.GetInterpolation() == pxr::UsdGeomTokens->faceVarying ? 1 : 0);
 
-                  // the size of the array can be larger than the number of points if the attribute
-                  // interpolation is face-varying.
-                  // It will be normalized by the vtkF3DFaceVaryingPointDispatcher later
-                  newPolyData->GetPointData()->AddArray(texCoords);
+                // the size of the array can be larger than the number of points if the attribute
+                // interpolation is face-varying.
+                // It will be normalized by the vtkF3DFaceVaryingPointDispatcher later
+                newPolyData->GetPointData()->AddArray(texCoords);
 
-                  if (firstArray)
-                  {
-                    // sometimes we are enable to fetch the array name to use for texture mapping
-                    // so we fallback to the first UV set added
-                    // see https://github.com/f3d-app/f3d/issues/1184
-                    firstArray = false;
-                    newPolyData->GetPointData()->SetTCoords(texCoords);
-                  }
+                if (firstArray)
+                {
+                  // sometimes we are enable to fetch the array name to use for texture mapping
+                  // so we fallback to the first UV set added
+                  // see https://github.com/f3d-app/f3d/issues/1184
+                  firstArray = false;
+                  newPolyData->GetPointData()->SetTCoords(texCoords);
                 }
               }
             }
+          }
 
-            // points
-            pxr::VtArray<pxr::GfVec3f> positions;
-            pointsAttr.Get(&positions, timeCode);
-
-            vtkNew<vtkPoints> points;
-            points->Allocate(positions.size());
-            for (const pxr::GfVec3f& p : positions)
-            {
-              points->InsertNextPoint(p[0], p[1], p[2]);
-            }
+          // points
+          pxr::VtArray<pxr::GfVec3f> positions;
+          pointsAttr.Get(&positions, timeCode);
 
-            newPolyData->SetPoints(points);
+          vtkNew<vtkPoints> points;
+          points->Allocate(positions.size());
+          for (const pxr::GfVec3f& p : positions)
+          {
+            points->InsertNextPoint(p[0], p[1], p[2]);
+          }
 
-            // faces
-            pxr::VtArray<int> counts;
-            facesCountAttr.Get(&counts, timeCode);
+          newPolyData->SetPoints(points);
 
-            pxr::VtArray<int> indices;
-            facesIndicesAttr.Get(&indices, timeCode);
+          // faces
+          pxr::VtArray<int> counts;
+          facesCountAttr.Get(&counts, timeCode);
 
-            // add polygons
-            vtkNew<vtkCellArray> cells;
-            auto currentCellIt = indices.cbegin();
-            std::vector<vtkIdType> indexArr;
-            for (int c : counts)
-            {
-              indexArr.clear();
-              indexArr.insert(indexArr.begin(), currentCellIt, std::next(currentCellIt, c));
-              cells->InsertNextCell(c, indexArr.data());
-              std::advance(currentCellIt, c);
-            }
+          pxr::VtArray<int> indices;
+          facesIndicesAttr.Get(&indices, timeCode);
 
-            newPolyData->SetPolys(cells);
+          // add polygons
+          vtkNew<vtkCellArray> cells;
+          auto currentCellIt = indices.cbegin();
+          std::vector<vtkIdType> indexArr;
+          for (int c : counts)
+          {
+            indexArr.clear();
+            indexArr.insert(indexArr.begin(), currentCellIt, std::next(currentCellIt, c));
+            cells->InsertNextCell(c, indexArr.data());
+            std::advance(currentCellIt, c);
+          }
 
-            vtkNew<vtkF3DFaceVaryingPointDispatcher> faceVaryingFilter;
-            faceVaryingFilter->SetInputData(newPolyData);
-            faceVaryingFilter->Update();
+          newPolyData->SetPolys(cells);
 
-            mappedPolydata = faceVaryingFilter->GetOutput();
-          }
+          vtkNew<vtkF3DFaceVaryingPointDispatcher> faceVaryingFilter;
+          faceVaryingFilter->SetInputData(newPolyData);
+          faceVaryingFilter->Update();
 
-          polydata = mappedPolydata;
+          mappedPolydata = faceVaryingFilter->GetOutput();
         }
-        else if (prim.IsA<pxr::UsdGeomSphere>())
+
+        polydata = mappedPolydata;
+      }
+      else
+      {
+        // primitives are only rebuilt if their shape is animated
+        vtkSmartPointer<vtkPolyData>& mappedPolydata =
+          this->MeshMap[prim.GetPath().GetAsString()];
+        if (!mappedPolydata ||
+          this->IsAnyTimeVarying(prim,
+            { pxr::UsdGeomTokens->radius, pxr::UsdGeomTokens->size, pxr::UsdGeomTokens->height,
+              pxr::UsdGeomTokens->axis }))
         {
-          pxr::UsdGeomSphere spherePrim = pxr::UsdGeomSphere(prim);
+          mappedPolydata = this->CreatePrimitive(prim);
+        }
 
-          vtkNew<vtkSphereSource> sphere;
-          sphere->SetThetaResolution(20);
-          sphere->SetPhiResolution(20);
+        polydata = mappedPolydata;
+      }
 
-          double radius;
-          if (spherePrim.GetRadiusAttr().Get(&radius))
-          {
-            sphere->SetRadius(radius);
-          }
+      if (!polydata)
+      {
+        // unsupported gprim
+        return;
+      }
 
-          sphere->Update();
-          polydata = sphere->GetOutput();
-        }
-        else if (prim.IsA<pxr::UsdGeomCube>())
-        {
-          pxr::UsdGeomCube cubePrim = pxr::UsdGeomCube(prim);
+      // create actors
 
-          vtkNew<vtkCubeSource> cube;
+      // get xform
+      auto mat = this->GetLocalTransform(geomPrim, timeCode);
+      vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
 
-          double length;
-          if (cubePrim.GetSizeAttr().Get(&length))
-          {
-            cube->SetXLength(length);
-            cube->SetYLength(length);
-            cube->SetZLength(length);
-          }
+      std::vector<pxr::UsdGeomSubset> subsets = pxr::UsdGeomSubset::GetGeomSubsets(geomPrim);
 
-          cube->Update();
-          polydata = cube->GetOutput();
-        }
-        else if (prim.IsA<pxr::UsdGeomCapsule>())
+      if (subsets.empty())
+      {
+        this->AddActor(renderer, path, geomPrim, prim, mat, polydata);
+      }
+      else
+      {
+        // split subsets
+        for (const pxr::UsdGeomSubset& subset : subsets)
         {
-          pxr::UsdGeomCapsule capsulePrim = pxr::UsdGeomCapsule(prim);
+          pxr::UsdAttribute indicesAttr = subset.GetIndicesAttr();
 
-          // See https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10531
-#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 0)
-          vtkNew<vtkCylinderSource> capsule;
-          capsule->CapsuleCapOn();
-
-          double height;
-          if (capsulePrim.GetHeightAttr().Get(&height))
+          // the subset is only rebuilt if the mesh or the indices changed
+          vtkSmartPointer<vtkPolyData>& polydataSubset =
+            this->MeshMap[subset.GetPath().GetAsString()];
+          if (!polydataSubset || polydataSubset->GetPoints() != polydata->GetPoints() ||
+            indicesAttr.ValueMightBeTimeVarying())
           {
-            capsule->SetHeight(height);
-          }
-#else
-          vtkNew<vtkCapsuleSource> capsule;
-
-          double height;
-          if (capsulePrim.GetHeightAttr().Get(&height))
-          {
-            capsule->SetCylinderLength(height);
-          }
-#endif
+            pxr::VtArray<int> indices;
+            indicesAttr.Get(&indices, timeCode);
 
-          double radius;
-          if (capsulePrim.GetRadiusAttr().Get(&radius))
-          {
-            capsule->SetRadius(radius);
-          }
+            polydataSubset = vtkSmartPointer<vtkPolyData>::New();
+            polydataSubset->SetPoints(polydata->GetPoints());
+            polydataSubset->GetPointData()->ShallowCopy(polydata->GetPointData());
 
-          // In VTK, the capsule is aligned with the Y axis
-          // In USD, the default is aligned with Z, but can be modified
-          // Let's rotate it if needed
-          vtkNew<vtkTransformFilter> transform;
-          vtkNew<vtkTransform> t;
-          transform->SetTransform(t);
+            vtkCellArray* mainPolys = polydata->GetPolys();
 
-          pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
-          capsulePrim.GetAxisAttr().Get(&axisToken);
+            // add polygons
+            vtkNew<vtkCellArray> cells;
+            for (int cellId : indices)
+            {
+              vtkIdType cellSize;
+              const vtkIdType* cellPoints;
+              mainPolys->GetCellAtId(cellId, cellSize, cellPoints);
+              cells->InsertNextCell(cellSize, cellPoints);
+            }
 
-          if (axisToken == pxr::UsdGeomTokens->x)
-          {
-            t->RotateZ(90.0);
-          }
-          else if (axisToken == pxr::UsdGeomTokens->z)
-          {
-            t->RotateX(90.0);
+            polydataSubset->SetPolys(cells);
           }
 
-          transform->SetInputConnection(capsule->GetOutputPort());
-          transform->Update();
-          polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
+          this->AddActor(renderer, path.AppendChild(pxr::TfToken(prim.GetName())), geomPrim,
+            subset.GetPrim(), mat, polydataSubset);
         }
-        else if (prim.IsA<pxr::UsdGeomCylinder>())
-        {
-          pxr::UsdGeomCylinder cylinderPrim = pxr::UsdGeomCylinder(prim);
-          vtkNew<vtkCylinderSource> cylinder;
-          cylinder->SetResolution(20);
+      }
+    }
+    else
+    {
+      // just traverse the node
+      this->ImportNode(renderer, prim, path.AppendChild(prim.GetName()), currentMatrix);
+    }
+  }
 
-          double height;
-          if (cylinderPrim.GetHeightAttr().Get(&height))
-          {
-            cylinder->SetHeight(height);
-          }
+  /**
+   * Create the geometry of a primitive gprim (sphere, cube, capsule, cylinder, cone),
+   * return nullptr for other gprims.
+   */
+  vtkSmartPointer<vtkPolyData> CreatePrimitive(const pxr::UsdPrim& prim)
+  {
+    vtkSmartPointer<vtkPolyData> polydata;
 
-          double radius;
-          if (cylinderPrim.GetRadiusAttr().Get(&radius))
-          {
-            cylinder->SetRadius(radius);
-          }
+    if (prim.IsA<pxr::UsdGeomSphere>())
+    {
+      pxr::UsdGeomSphere spherePrim = pxr::UsdGeomSphere(prim);
 
-          // In VTK, the cylinder is aligned with the Y axis
-          // In USD, the default is aligned with Z, but can be modified
-          // Let's rotate it if needed
-          vtkNew<vtkTransformFilter> transform;
-          vtkNew<vtkTransform> t;
-          transform->SetTransform(t);
+      vtkNew<vtkSphereSource> sphere;
+      sphere->SetThetaResolution(20);
+      sphere->SetPhiResolution(20);
 
-          pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
-          cylinderPrim.GetAxisAttr().Get(&axisToken);
+      double radius;
+      if (spherePrim.GetRadiusAttr().Get(&radius))
+      {
+        sphere->SetRadius(radius);
+      }
 
-          if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->x))
-          {
-            t->RotateZ(90.0);
-          }
-          else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
-          {
-            t->RotateX(90.0);
-          }
+      sphere->Update();
+      polydata = sphere->GetOutput();
+    }
+    else if (prim.IsA<pxr::UsdGeomCube>())
+    {
+      pxr::UsdGeomCube cubePrim = pxr::UsdGeomCube(prim);
 
-          transform->SetInputConnection(cylinder->GetOutputPort());
-          transform->Update();
-          polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
-        }
-        else if (prim.IsA<pxr::UsdGeomCone>())
-        {
-          pxr::UsdGeomCone conePrim = pxr::UsdGeomCone(prim);
-          vtkNew<vtkConeSource> cone;
-          cone->SetResolution(20);
+      vtkNew<vtkCubeSource> cube;
 
-          double height;
-          if (conePrim.GetHeightAttr().Get(&height))
-          {
-            cone->SetHeight(height);
-          }
+      double length;
+      if (cubePrim.GetSizeAttr().Get(&length))
+      {
+        cube->SetXLength(length);
+        cube->SetYLength(length);
+        cube->SetZLength(length);
+      }
 
-          double radius;
-          if (conePrim.GetRadiusAttr().Get(&radius))
-          {
-            cone->SetRadius(radius);
-          }
+      cube->Update();
+      polydata = cube->GetOutput();
+    }
+    else if (prim.IsA<pxr::UsdGeomCapsule>())
+    {
+      pxr::UsdGeomCapsule capsulePrim = pxr::UsdGeomCapsule(prim);
 
-          // In VTK, the cylinder is aligned with the X axis
-          // In USD, the default is aligned with Z, but can be modified
-          // Let's rotate it if needed
-          vtkNew<vtkTransformFilter> transform;
-          vtkNew<vtkTransform> t;
-          transform->SetTransform(t);
+      // See https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10531
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 0)
+      vtkNew<vtkCylinderSource> capsule;
+      capsule->CapsuleCapOn();
 
-          pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
-          conePrim.GetAxisAttr().Get(&axisToken);
+      double height;
+      if (capsulePrim.GetHeightAttr().Get(&height))
+      {
+        capsule->SetHeight(height);
+      }
+#else
+      vtkNew<vtkCapsuleSource> capsule;
 
-          if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->y))
-          {
-            t->RotateZ(90.0);
-          }
-          else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
-          {
-            t->RotateY(90.0);
-          }
+      double height;
+      if (capsulePrim.GetHeightAttr().Get(&height))
+      {
+        capsule->SetCylinderLength(height);
+      }
+#endif
 
-          transform->SetInputConnection(cone->GetOutputPort());
-          transform->Update();
-          polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
-        }
+      double radius;
+      if (capsulePrim.GetRadiusAttr().Get(&radius))
+      {
+        capsule->SetRadius(radius);
+      }
 
-        // create actors
+      // In VTK, the capsule is aligned with the Y axis
+      // In USD, the default is aligned with Z, but can be modified
+      // Let's rotate it if needed
+      vtkNew<vtkTransformFilter> transform;
+      vtkNew<vtkTransform> t;
+      transform->SetTransform(t);
 
-        // get xform
-        auto mat = this->GetLocalTransform(geomPrim, timeCode);
-        vtkMatrix4x4::Multiply4x4(currentMatrix, mat, mat);
+      pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
+      capsulePrim.GetAxisAttr().Get(&axisToken);
 
-        std::vector<pxr::UsdGeomSubset> subsets = pxr::UsdGeomSubset::GetGeomSubsets(geomPrim);
+      if (axisToken == pxr::UsdGeomTokens->x)
+      {
+        t->RotateZ(90.0);
+      }
+      else if (axisToken == pxr::UsdGeomTokens->z)
+      {
+        t->RotateX(90.0);
+      }
 
-        if (subsets.empty())
-        {
-          this->AddActor(renderer, path, geomPrim, prim, mat, polydata);
-        }
-        else
-        {
-          // split subsets
-          for (const pxr::UsdGeomSubset& subset : subsets)
-          {
-            pxr::UsdAttribute indicesAttr = subset.GetIndicesAttr();
+      transform->SetInputConnection(capsule->GetOutputPort());
+      transform->Update();
+      polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
+    }
+    else if (prim.IsA<pxr::UsdGeomCylinder>())
+    {
+      pxr::UsdGeomCylinder cylinderPrim = pxr::UsdGeomCylinder(prim);
+      vtkNew<vtkCylinderSource> cylinder;
+      cylinder->SetResolution(20);
 
-            pxr::VtArray<int> indices;
-            indicesAttr.Get(&indices, timeCode);
+      double height;
+      if (cylinderPrim.GetHeightAttr().Get(&height))
+      {
+        cylinder->SetHeight(height);
+      }
 
-            vtkNew<vtkPolyData> polydataSubset;
-            polydataSubset->SetPoints(polydata->GetPoints());
-            polydataSubset->GetPointData()->ShallowCopy(polydata->GetPointData());
+      double radius;
+      if (cylinderPrim.GetRadiusAttr().Get(&radius))
+      {
+        cylinder->SetRadius(radius);
+      }
 
-            vtkCellArray* mainPolys = polydata->GetPolys();
+      // In VTK, the cylinder is aligned with the Y axis
+      // In USD, the default is aligned with Z, but can be modified
+      // Let's rotate it if needed
+      vtkNew<vtkTransformFilter> transform;
+      vtkNew<vtkTransform> t;
+      transform->SetTransform(t);
 
-            // add polygons
-            vtkNew<vtkCellArray> cells;
-            for (int cellId : indices)
-            {
-              vtkIdType cellSize;
-              const vtkIdType* cellPoints;
-              mainPolys->GetCellAtId(cellId, cellSize, cellPoints);
-              cells->InsertNextCell(cellSize, cellPoints);
-            }
+      pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
+      cylinderPrim.GetAxisAttr().Get(&axisToken);
 
-            polydataSubset->SetPolys(cells);
+      if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->x))
+      {
+        t->RotateZ(90.0);
+      }
+      else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
+      {
+        t->RotateX(90.0);
+      }
 
-            this->AddActor(renderer, path.AppendChild(pxr::TfToken(prim.GetName())), geomPrim,
-              subset.GetPrim(), mat, polydataSubset);
-          }
-        }
+      transform->SetInputConnection(cylinder->GetOutputPort());
+      transform->Update();
+      polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
+    }
+    else if (prim.IsA<pxr::UsdGeomCone>())
+    {
+      pxr::UsdGeomCone conePrim = pxr::UsdGeomCone(prim);
+      vtkNew<vtkConeSource> cone;
+      cone->SetResolution(20);
+
+      double height;
+      if (conePrim.GetHeightAttr().Get(&height))
+      {
+        cone->SetHeight(height);
       }
-      else
+
+      double radius;
+      if (conePrim.GetRadiusAttr().Get(&radius))
       {
-        // just traverse the node
-        this->ImportNode(renderer, prim, path.AppendChild(prim.GetName()), currentMatrix);
+        cone->SetRadius(radius);
       }
+
+      // In VTK, the cylinder is aligned with the X axis
+      // In USD, the default is aligned with Z, but can be modified
+      // Let's rotate it if needed
+      vtkNew<vtkTransformFilter> transform;
+      vtkNew<vtkTransform> t;
+      transform->SetTransform(t);
+
+      pxr::TfToken axisToken(pxr::UsdGeomTokens->z);
+      conePrim.GetAxisAttr().Get(&axisToken);
+
+      if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->y))
+      {
+        t->RotateZ(90.0);
+      }
+      else if (axisToken == pxr::TfToken(pxr::UsdGeomTokens->z))
+      {
+        t->RotateY(90.0);
+      }
+
+      transform->SetInputConnection(cone->GetOutputPort());
+      transform->Update();
+      polydata = vtkPolyData::SafeDownCast(transform->GetOutput());
     }
+
+    return polydata;
   }
 
   bool ImportRoot(vtkRenderer* renderer)
@@ -725,22 +1055,29 @@ public:
       return false;
     }
 
-    vtkNew<vtkMatrix4x4> rootTransform;
+    if (!this->RootTransform)
+    {
+      this->RootTransform = vtkSmartPointer<vtkMatrix4x4>::New();
 
-    pxr::TfToken up = pxr::UsdGeomGetStageUpAxis(this->Stage);
+      pxr::TfToken up = pxr::UsdGeomGetStageUpAxis(this->Stage);
 
-    if (up == pxr::UsdGeomTokens->z)
-    {
-      vtkWarningWithObjectMacro(
-        renderer, << "This USD file up axis is +Z, internally rotate it to align with +Y axis");
-      rootTransform->Zero();
-      rootTransform->SetElement(0, 0, 1.0);
-      rootTransform->SetElement(1, 2, 1.0);
-      rootTransform->SetElement(2, 1, -1.0);
-      rootTransform->SetElement(3, 3, 1.0);
+      if (up == pxr::UsdGeomTokens->z)
+      {
+        vtkWarningWithObjectMacro(
+          renderer, << "This USD file up axis is +Z, internally rotate it to align with +Y axis");
+        this->RootTransform->Zero();
+        this->RootTransform->SetElement(0, 0, 1.0);
+        this->RootTransform->SetElement(1, 2, 1.0);
+        this->RootTransform->SetElement(2, 1, -1.0);
+        this->RootTransform->SetElement(3, 3, 1.0);
+      }
     }
 
-    this->ImportNode(renderer, this->Stage->GetPseudoRoot(), pxr::SdfPath("/"), rootTransform);
+    this->ImportNode(
+      renderer, this->Stage->GetPseudoRoot(), pxr::SdfPath("/"), this->RootTransform);
+
+    // next imports, on time change, only update the time-varying prims
+    this->Classified = true;
     return true;
   }
 
@@ -1176,7 +1513,39 @@ public:
   pxr::UsdStageRefPtr Stage = nullptr;
 
 private:
+  /**
+   * Set while importing the prototype of a point instancer, the geometries are then rendered
+   * using the instances as glyphs, and the matrix is the transform of the point instancer
+   */
+  struct InstancingContext
+  {
+    vtkSmartPointer<vtkPolyData> Instances;
+    vtkSmartPointer<vtkMatrix4x4> Matrix;
+  };
+
+  /**
+   * The geometry and transform used to build the glyph source of an instanced actor
+   */
+  struct InstancedSource
+  {
+    vtkPolyData* Geometry = nullptr;
+    std::array<double, 16> Matrix;
+  };
+
+  InstancingContext* CurrentInstancing = nullptr;
+
+  // Import paths of the prims with time-varying attributes, their subtree is imported again on
+  // time change, and import paths of their ancestors, which are only traversed
+  std::unordered_set<std::string> AnimatedPaths;
+  std::unordered_set<std::string> AnimatedAncestorPaths;
+  bool Classified = false;
+  bool ImportingAnimatedSubtree = false;
+  vtkSmartPointer<vtkMatrix4x4> RootTransform;
+  std::unordered_map<std::string, vtkSmartPointer<vtkPolyData>> InstancesMap;
+  std::unordered_map<std::string, InstancedSource> InstancedSourceMap;
+
   std::unordered_map<std::string, vtkSmartPointer<vtkActor>> ActorMap;
+  std::unordered_map<std::string, vtkSmartPointer<vtkPolyData>> ActorInputMap;
   std::unordered_map<std::string, vtkSmartPointer<vtkPolyData>> MeshMap;
   std::unordered_map<std::string, vtkSmartPointer<vtkProperty>> ShaderMap;
   std::unordered_map<std::string, vtkSmartPointer<vtkImageData>> TextureMap;
@@ -1270,6 +1639,8 @@ bool vtkF3DUSDImporter::GetTemporalInformation(vtkIdType vtkNotUsed(animationInd
 bool vtkF3DUSDImporter::UpdateAtTimeValue(double timeValue)
 {
   this->Internals->SetCurrentTime(timeValue);
+
+  // After the first import, only the time-varying prims are imported again
   this->Update();
   return this->Superclass::UpdateAtTimeValue(timeValue);
 }
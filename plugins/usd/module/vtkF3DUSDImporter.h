@@ -6,7 +6,9 @@
  * It supports .usd, .usda, .usdc and .usdz formats.
  *
  * This importer should cover a large part of the features including
- * instancing and materials but there are known limitations including:
+ * instancing and materials. Point instancers are rendered with one glyph mapper
+ * per prototype so that instances share their geometry.
+ * There are known limitations including:
  * - Only supports preview materials
  * - Does not support UV transforms
  * - Do not support lights and cameras
@@ -342,6 +342,8 @@ PYBIND11_MODULE(pyf3d, module)
   scene //
     .def("supports", &f3d::scene::supports)
     .def("clear", &f3d::scene::clear)
+    .def("preload", &f3d::scene::preload, "Preload files in the background",
+      py::arg("file_path_vector"))
     .def("add", py::overload_cast<const std::filesystem::path&>(&f3d::scene::add),
       "Add a file the scene", py::arg("file_path"))
     .def("add", py::overload_cast<const std::vector<std::filesystem::path>&>(&f3d::scene::add),
@@ -350,6 +352,8 @@ PYBIND11_MODULE(pyf3d, module)
       "Add multiple filenames to the scene", py::arg("file_name_vector"))
     .def("add", py::overload_cast<const f3d::mesh_t&>(&f3d::scene::add),
       "Add a surfacic mesh from memory into the scene", py::arg("mesh"))
+    .def("reload", &f3d::scene::reload, "Reload a file previously added to the scene",
+      py::arg("file_path"))
     .def("load_animation_time", &f3d::scene::loadAnimationTime)
     .def("animation_time_range", &f3d::scene::animationTimeRange)
     .def("available_animations", &f3d::scene::availableAnimations);
@@ -42,6 +42,7 @@ def test_scene():
     engine.scene.add([world, logo])
     engine.scene.add(sphere1)
     engine.scene.add([sphere2, cube])
+    engine.scene.reload(cube)
 
     assert engine.scene.animation_time_range() == (0.0, 4.0)
     engine.scene.load_animation_time(2)
@@ -52,3 +53,26 @@ def test_scene():
     img.save(output)
 
     assert img.compare(f3d.Image(reference)) < 0.05
+
+
+def test_scene_reload():
+    rewritten = Path(tempfile.gettempdir()) / "TestPythonSceneReload.stl"
+
+    def write_triangle(vertices):
+        rewritten.write_text(
+            "solid triangle\nfacet normal 0 0 1\nouter loop\n"
+            + vertices
+            + "endloop\nendfacet\nendsolid triangle\n"
+        )
+
+    engine = f3d.Engine.create(True)
+    engine.window.size = 300, 300
+
+    write_triangle("vertex 0 0 0\nvertex 1 0 0\nvertex 0 1 0\n")
+    engine.scene.add(rewritten)
+    before_reload = engine.window.render_to_image()
+
+    # reloading a file rewritten on disk displays its new content
+    write_triangle("vertex 0 0 0\nvertex 1 0 0\nvertex 1 1 0\n")
+    engine.scene.reload(rewritten)
+    assert engine.window.render_to_image().compare(before_reload) > 0.05
@@ -68,3 +68,20 @@ void F3DLog::SetStandardStream(StandardStream mode)
       break;
   }
 }
+
+//----------------------------------------------------------------------------
+void F3DLog::FlushDeferredMessages()
+{
+  vtkOutputWindow* win = vtkOutputWindow::GetInstance();
+  vtkF3DConsoleOutputWindow* consoleWin = vtkF3DConsoleOutputWindow::SafeDownCast(win);
+  if (consoleWin)
+  {
+    consoleWin->FlushDeferredMessages();
+  }
+}
+
+//----------------------------------------------------------------------------
+void F3DLog::SetDeferMessages(bool defer)
+{
+  vtkF3DConsoleOutputWindow::SetDeferMessages(defer);
+}
@@ -56,6 +56,20 @@ void SetUseColoring(bool use);
  * are written to stdout.
  */
 void SetStandardStream(StandardStream mode);
+
+/**
+ * If output window is a vtkF3DConsoleOutputWindow,
+ * display the messages deferred by other threads since the last call.
+ * Must be called from the main thread.
+ */
+void FlushDeferredMessages();
+
+/**
+ * Set if the messages printed from the calling thread are deferred until FlushDeferredMessages
+ * is called. Only meant for threads that run concurrently with the main thread for a long time,
+ * messages of other threads are printed immediately.
+ */
+void SetDeferMessages(bool defer);
 };
 
 #endif
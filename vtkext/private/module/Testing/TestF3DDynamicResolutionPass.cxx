@@ -0,0 +1,161 @@
+#include <vtkActor.h>
+#include <vtkGenericRenderWindowInteractor.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+#include <vtkXMLPolyDataReader.h>
+
+#include "vtkF3DDynamicResolutionPass.h"
+#include "vtkF3DRenderPass.h"
+#include "vtkF3DSolidBackgroundPass.h"
+#include "vtkF3DUserRenderPass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> Capture(vtkRenderWindow* renWin)
+{
+  renWin->Render();
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->ReadFrontBufferOff();
+  w2i->Update();
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->DeepCopy(w2i->GetOutput());
+  return image;
+}
+
+// Compare the average colors of 10x10 pixels blocks, so that the blur of the upsampling
+// is ignored while a misplaced or cropped rendering is not
+double ComputeBlockDifference(vtkImageData* a, vtkImageData* b)
+{
+  const int* dims = a->GetDimensions();
+  vtkUnsignedCharArray* pa = vtkUnsignedCharArray::SafeDownCast(a->GetPointData()->GetScalars());
+  vtkUnsignedCharArray* pb = vtkUnsignedCharArray::SafeDownCast(b->GetPointData()->GetScalars());
+  const int nbComp = pa->GetNumberOfComponents();
+  constexpr int blockSize = 10;
+
+  double maxDifference = 0.0;
+  for (int by = 0; by < dims[1] / blockSize; by++)
+  {
+    for (int bx = 0; bx < dims[0] / blockSize; bx++)
+    {
+      for (int c = 0; c < 3; c++)
+      {
+        double sum = 0.0;
+        for (int y = by * blockSize; y < (by + 1) * blockSize; y++)
+        {
+          for (int x = bx * blockSize; x < (bx + 1) * blockSize; x++)
+          {
+            vtkIdType id = static_cast<vtkIdType>(y) * dims[0] + x;
+            sum += pa->GetValue(id * nbComp + c) - pb->GetValue(id * nbComp + c);
+          }
+        }
+        maxDifference = std::max(maxDifference, std::abs(sum) / (blockSize * blockSize));
+      }
+    }
+  }
+  return maxDifference;
+}
+}
+
+int TestF3DDynamicResolutionPass(int argc, char* argv[])
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName((std::string(argv[1]) + "data/cow.vtp").c_str());
+
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(reader->GetOutputPort());
+
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  // the passes between the scene and the dynamic resolution pass in vtkF3DRenderer
+  vtkNew<vtkF3DRenderPass> f3dPass;
+  vtkNew<vtkF3DSolidBackgroundPass> backgroundPass;
+  backgroundPass->SetDelegatePass(f3dPass);
+  vtkNew<vtkF3DUserRenderPass> userPass;
+  userPass->SetUserShader("vec4 pixel(vec2 uv) { return texture(source, uv); }");
+  userPass->SetDelegatePass(backgroundPass);
+
+  vtkNew<vtkF3DDynamicResolutionPass> pass;
+  pass->SetDelegatePass(userPass);
+  pass->SetMinimumScale(0.5);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetBackground(0.2, 0.3, 0.4);
+  renderer->AddActor(actor);
+  renderer->SetPass(pass);
+  renderer->ResetCamera();
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->OffScreenRenderingOn();
+  renWin->AddRenderer(renderer);
+
+  // the resolution is only reduced when an interactor raises the desired update rate
+  vtkNew<vtkGenericRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+
+  renWin->SetDesiredUpdateRate(iren->GetStillUpdateRate());
+  vtkSmartPointer<vtkImageData> still = ::Capture(renWin);
+
+  // an unreachable target frame time lowers the scale down to the minimum
+  renWin->SetDesiredUpdateRate(iren->GetDesiredUpdateRate());
+  pass->SetTargetFrameTime(1e-9);
+  for (int i = 0; i < 50 && pass->GetScale() > pass->GetMinimumScale(); i++)
+  {
+    renWin->Render();
+  }
+  if (pass->GetScale() != pass->GetMinimumScale())
+  {
+    std::cerr << "Scale did not decrease to the minimum: " << pass->GetScale() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // the whole chain must render in the reduced framebuffer, only the sharpness differs
+  double difference = ::ComputeBlockDifference(::Capture(renWin), still);
+  if (difference > 16.0)
+  {
+    std::cerr << "Reduced resolution rendering does not match the full resolution one: "
+              << difference << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // a target frame time always met makes the scale recover during the motion
+  pass->SetTargetFrameTime(10.0);
+  for (int i = 0; i < 50 && pass->GetScale() < 1.0; i++)
+  {
+    renWin->Render();
+  }
+  if (pass->GetScale() != 1.0)
+  {
+    std::cerr << "Scale did not recover during the motion: " << pass->GetScale() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // the scale is reset once the motion stops
+  pass->SetTargetFrameTime(1e-9);
+  for (int i = 0; i < 50 && pass->GetScale() > pass->GetMinimumScale(); i++)
+  {
+    renWin->Render();
+  }
+  renWin->SetDesiredUpdateRate(iren->GetStillUpdateRate());
+  renWin->Render();
+  if (pass->GetScale() != 1.0)
+  {
+    std::cerr << "Scale was not reset when the motion stopped: " << pass->GetScale() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
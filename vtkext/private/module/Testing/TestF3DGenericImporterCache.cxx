@@ -0,0 +1,78 @@
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkXMLUnstructuredGridReader.h>
+#include <vtksys/SystemTools.hxx>
+
+#include "vtkF3DGenericImporter.h"
+
+#include <iostream>
+
+int TestF3DGenericImporterCache(int argc, char* argv[])
+{
+  std::string filename = std::string(argv[1]) + "data/dragon.vtu";
+  std::string cacheDirectory = std::string(argv[2]) + "/geometry_cache";
+  vtksys::SystemTools::RemoveADirectory(cacheDirectory);
+
+  // a cancelled import fails and never writes the cache
+  vtkNew<vtkXMLUnstructuredGridReader> cancelledReader;
+  cancelledReader->SetFileName(filename.c_str());
+  vtkNew<vtkF3DGenericImporter> cancelledImporter;
+  cancelledImporter->SetInternalReader(cancelledReader);
+  cancelledImporter->SetCacheDirectory(cacheDirectory);
+  cancelledImporter->CancelUpdate();
+  if (cancelledImporter->PreUpdate() ||
+    vtksys::SystemTools::FileIsDirectory(cacheDirectory))
+  {
+    std::cerr << "Cancelled import was not aborted\n";
+    return EXIT_FAILURE;
+  }
+
+  // the first import executes the reader and writes the cache
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->SetFileName(filename.c_str());
+  vtkNew<vtkF3DGenericImporter> importer;
+  importer->SetInternalReader(reader);
+  importer->SetCacheDirectory(cacheDirectory);
+  importer->Update();
+  if (!vtksys::SystemTools::FileIsDirectory(cacheDirectory))
+  {
+    std::cerr << "Geometry cache was not written\n";
+    return EXIT_FAILURE;
+  }
+
+  // the second import reads the cache without executing the reader
+  vtkNew<vtkXMLUnstructuredGridReader> cachedReader;
+  cachedReader->SetFileName(filename.c_str());
+  vtkNew<vtkF3DGenericImporter> cachedImporter;
+  cachedImporter->SetInternalReader(cachedReader);
+  cachedImporter->SetCacheDirectory(cacheDirectory);
+  if (!cachedImporter->PreUpdate())
+  {
+    std::cerr << "Geometry cache could not be read\n";
+    return EXIT_FAILURE;
+  }
+  cachedImporter->Update();
+
+  vtkUnstructuredGrid* readerOutput = cachedReader->GetOutput();
+  if (readerOutput && readerOutput->GetNumberOfPoints() != 0)
+  {
+    std::cerr << "Reader was executed despite the geometry cache\n";
+    return EXIT_FAILURE;
+  }
+
+  if (cachedImporter->GetImportedPoints()->GetNumberOfPoints() !=
+    importer->GetImportedPoints()->GetNumberOfPoints())
+  {
+    std::cerr << "Unexpected number of points in the cached geometry\n";
+    return EXIT_FAILURE;
+  }
+
+  if (cachedImporter->GetOutputsDescription() != importer->GetOutputsDescription())
+  {
+    std::cerr << "Unexpected description of the cached geometry\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
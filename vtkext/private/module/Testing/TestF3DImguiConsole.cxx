@@ -0,0 +1,40 @@
+#include <vtkNew.h>
+
+#include "vtkF3DImguiConsole.h"
+
+#include <iostream>
+
+int TestF3DImguiConsole(int argc, char* argv[])
+{
+  vtkNew<vtkF3DImguiConsole> console;
+  console->SetUseColoring(false);
+  console->SetMaxNumberOfLogs(3);
+
+  for (int i = 0; i < 5; i++)
+  {
+    console->DisplayText("Test Console\n");
+  }
+
+  if (console->GetNumberOfLogs() != 3)
+  {
+    std::cerr << "Console should keep only the 3 most recent logs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // reducing the capacity must discard the oldest logs immediately
+  console->SetMaxNumberOfLogs(2);
+  if (console->GetNumberOfLogs() != 2)
+  {
+    std::cerr << "Console should keep only the 2 most recent logs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  console->Clear();
+  if (console->GetNumberOfLogs() != 0)
+  {
+    std::cerr << "Console should be empty after clearing it" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+#include "vtkF3DKTXReader.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+int TestF3DKTXReader(int argc, char* argv[])
+{
+  vtkNew<vtkF3DKTXReader> reader;
+
+  std::string filename = std::string(argv[1]) + "data/checker_rgba8.ktx2";
+  if (!reader->CanReadFile(filename.c_str()))
+  {
+    std::cerr << "KTX2 file not recognized.\n";
+    return EXIT_FAILURE;
+  }
+
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+
+  reader->Print(cout);
+
+  vtkImageData* img = reader->GetOutput();
+
+  const int* dims = img->GetDimensions();
+  if (dims[0] != 4 || dims[1] != 2 || img->GetNumberOfScalarComponents() != 4)
+  {
+    std::cerr << "Incorrect KTX2 image size: " << dims[0] << ":" << dims[1] << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // KTX2 images are stored top to bottom, the first row of the file is the top one
+  if (img->GetScalarComponentAsDouble(0, 0, 0, 2) != 255 ||
+    img->GetScalarComponentAsDouble(0, 1, 0, 0) != 255)
+  {
+    std::cerr << "Incorrect KTX2 image orientation.\n";
+    return EXIT_FAILURE;
+  }
+
+  // read the same file from memory
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<char> buff(size);
+  if (!file.read(buff.data(), size))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkF3DKTXReader> memReader;
+  memReader->SetFileName("readFromMem.ktx2");
+  memReader->SetMemoryBuffer(buff.data());
+  memReader->SetMemoryBufferLength(buff.size());
+  memReader->Update();
+
+  dims = memReader->GetOutput()->GetDimensions();
+  if (dims[0] != 4 || dims[1] != 2)
+  {
+    std::cerr << "Incorrect KTX2 image size from memory: " << dims[0] << ":" << dims[1] << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // UASTC texture made of four solid 4x4 blocks, transcoded to RGBA
+  vtkNew<vtkF3DKTXReader> uastcReader;
+  uastcReader->SetFileName((std::string(argv[1]) + "data/checker_uastc.ktx2").c_str());
+  uastcReader->Update();
+  img = uastcReader->GetOutput();
+  dims = img->GetDimensions();
+  if (dims[0] != 8 || dims[1] != 8 || img->GetNumberOfScalarComponents() != 4)
+  {
+    std::cerr << "Incorrect UASTC image size: " << dims[0] << ":" << dims[1] << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // top left is red, top right is green, bottom left is blue, bottom right is white
+  const int expected[4][6] = { { 0, 7, 255, 0, 0, 255 }, { 7, 7, 0, 255, 0, 255 },
+    { 0, 0, 0, 0, 255, 255 }, { 7, 0, 255, 255, 255, 255 } };
+  for (const auto& pixel : expected)
+  {
+    for (int c = 0; c < 4; c++)
+    {
+      if (img->GetScalarComponentAsDouble(pixel[0], pixel[1], 0, c) != pixel[2 + c])
+      {
+        std::cerr << "Incorrect UASTC pixel " << pixel[0] << ":" << pixel[1] << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Not a KTX2 file
+  filename = std::string(argv[1]) + "data/Rec709.exr";
+  if (reader->CanReadFile(filename.c_str()))
+  {
+    std::cerr << "EXR file wrongly recognized as KTX2.\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+#include "vtkF3DGenericImporter.h"
+#include "vtkF3DMetaImporter.h"
+
+#include <vtkNew.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkXMLImageDataReader.h>
+
+#include <cstdio>
+#include <iostream>
+
+namespace
+{
+struct Memory
+{
+  unsigned long Geometry = 0;
+  unsigned long Textures = 0;
+  unsigned long Surfaces = 0;
+  unsigned long PointSprites = 0;
+  unsigned long Volume = 0;
+};
+
+// Import the volume dataset with the provided memory limit,
+// return false if the import failed or the memory usage of the file could not be read
+bool Import(const std::string& filename, unsigned long limit, vtkF3DMetaImporter* importer,
+  Memory& memory)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(filename.c_str());
+  vtkNew<vtkF3DGenericImporter> genericImporter;
+  genericImporter->SetInternalReader(reader);
+
+  vtkNew<vtkRenderWindow> window;
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  importer->SetRenderWindow(window);
+  importer->SetMemoryLimit(limit);
+  importer->AddImporter(genericImporter);
+  if (!importer->Update())
+  {
+    return false;
+  }
+
+  std::string description = importer->GetOutputsDescription();
+  size_t pos = description.find("File 1: ");
+  return pos != std::string::npos &&
+    std::sscanf(description.c_str() + pos,
+      "File 1: geometry %lu KiB, textures %lu KiB, surfaces %lu KiB, point sprites %lu KiB, "
+      "volume %lu KiB",
+      &memory.Geometry, &memory.Textures, &memory.Surfaces, &memory.PointSprites,
+      &memory.Volume) == 5;
+}
+}
+
+int TestF3DMetaImporterMemoryLimit(int argc, char* argv[])
+{
+  std::string filename = std::string(argv[1]) + "data/waveletArrays.vti";
+
+  // without a limit, all the structures are created
+  vtkNew<vtkF3DMetaImporter> importer;
+  Memory memory;
+  if (!::Import(filename, 0, importer, memory))
+  {
+    std::cerr << "Import without memory limit failed\n";
+    return EXIT_FAILURE;
+  }
+  if (memory.Geometry == 0 || memory.Surfaces == 0 || memory.Volume == 0 ||
+    importer->GetVolumePropsAndMappers().empty() ||
+    importer->GetPointSpritesActorsAndMappers().empty())
+  {
+    std::cerr << "Unexpected memory usage or structures without memory limit\n";
+    return EXIT_FAILURE;
+  }
+
+  // with a limit between the required memory and the total,
+  // the point sprites and volume structures are not created
+  unsigned long required = memory.Geometry + memory.Textures + memory.Surfaces;
+  unsigned long optional = memory.PointSprites + memory.Volume;
+  vtkNew<vtkF3DMetaImporter> degradedImporter;
+  Memory degradedMemory;
+  if (!::Import(filename, required + optional / 2, degradedImporter, degradedMemory))
+  {
+    std::cerr << "Import with a memory limit above the required memory failed\n";
+    return EXIT_FAILURE;
+  }
+  if (degradedMemory.Geometry != memory.Geometry || degradedMemory.Surfaces != memory.Surfaces ||
+    degradedMemory.PointSprites != 0 || degradedMemory.Volume != 0 ||
+    !degradedImporter->GetVolumePropsAndMappers().empty() ||
+    !degradedImporter->GetPointSpritesActorsAndMappers().empty() ||
+    degradedImporter->GetColoringActorsAndMappers().empty())
+  {
+    std::cerr << "Point sprites and volume were not disabled by the memory limit\n";
+    return EXIT_FAILURE;
+  }
+
+  // with a limit below the required memory, the import fails
+  vtkNew<vtkF3DMetaImporter> failingImporter;
+  Memory failingMemory;
+  if (::Import(filename, required - 1, failingImporter, failingMemory))
+  {
+    std::cerr << "Import with a memory limit below the required memory did not fail\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+#include <vtkCamera.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+
+#include "vtkF3DPointCloudOctree.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+// Poll the octree like the renderer does until its background build is finished
+bool WaitForOctree(vtkF3DPointCloudOctree* octree)
+{
+  while (!octree->IsReady() && octree->IsBuilding())
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return octree->IsReady();
+}
+}
+
+int TestF3DPointCloudOctree(int argc, char* argv[])
+{
+  // random point cloud in a unit cube with a scalar array
+  constexpr vtkIdType nbPoints = 100000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(nbPoints);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(nbPoints);
+  for (vtkIdType i = 0; i < nbPoints; i++)
+  {
+    double p[3];
+    for (double& c : p)
+    {
+      c = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(i, p);
+    scalars->SetValue(i, static_cast<float>(i));
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+  cloud->GetPointData()->SetScalars(scalars);
+
+  std::string cacheDirectory = std::string(argv[2]) + "/octree";
+
+  vtkNew<vtkF3DPointCloudOctree> octree;
+  octree->SetMaximumPointsPerNode(1000);
+  octree->SetGridResolution(8);
+  if (!octree->Initialize(cloud, cacheDirectory))
+  {
+    std::cerr << "Octree building could not start\n";
+    return EXIT_FAILURE;
+  }
+
+  // the octree is built in the background and is not usable until polled once finished
+  if (!octree->IsBuilding() || octree->GetNumberOfNodes() != 0)
+  {
+    std::cerr << "Octree was not built in the background\n";
+    return EXIT_FAILURE;
+  }
+  if (!::WaitForOctree(octree) || octree->GetNumberOfNodes() < 9)
+  {
+    std::cerr << "Octree building failed with " << octree->GetNumberOfNodes() << " nodes\n";
+    return EXIT_FAILURE;
+  }
+
+  // a second octree with the same build parameters reuses the cached nodes
+  vtkNew<vtkF3DPointCloudOctree> cachedOctree;
+  cachedOctree->SetMaximumPointsPerNode(1000);
+  cachedOctree->SetGridResolution(8);
+  if (cachedOctree->ComputeKey(cloud) != octree->ComputeKey(cloud) ||
+    !cachedOctree->Initialize(cloud, cacheDirectory) || cachedOctree->IsBuilding() ||
+    cachedOctree->GetNumberOfNodes() != octree->GetNumberOfNodes())
+  {
+    std::cerr << "Octree loading failed with " << cachedOctree->GetNumberOfNodes() << " nodes\n";
+    return EXIT_FAILURE;
+  }
+
+  // different build parameters do not reuse the cached nodes
+  vtkNew<vtkF3DPointCloudOctree> otherOctree;
+  otherOctree->SetMaximumPointsPerNode(100);
+  otherOctree->SetGridResolution(8);
+  if (otherOctree->ComputeKey(cloud) == octree->ComputeKey(cloud) ||
+    !otherOctree->Initialize(cloud, cacheDirectory) || !::WaitForOctree(otherOctree) ||
+    otherOctree->GetNumberOfNodes() <= octree->GetNumberOfNodes())
+  {
+    std::cerr << "Octree with different build parameters reused the cache\n";
+    return EXIT_FAILURE;
+  }
+
+  // modified point data changes the key even if the points are the same
+  vtkNew<vtkPolyData> modifiedCloud;
+  modifiedCloud->DeepCopy(cloud);
+  modifiedCloud->GetPointData()->GetScalars()->SetComponent(0, 0, -1.0);
+  if (octree->ComputeKey(modifiedCloud) == octree->ComputeKey(cloud))
+  {
+    std::cerr << "Point data modification did not change the octree key\n";
+    return EXIT_FAILURE;
+  }
+
+  // so does a different type of point data
+  vtkNew<vtkDoubleArray> doubleScalars;
+  doubleScalars->DeepCopy(scalars);
+  modifiedCloud->DeepCopy(cloud);
+  modifiedCloud->GetPointData()->SetScalars(doubleScalars);
+  if (octree->ComputeKey(modifiedCloud) == octree->ComputeKey(cloud))
+  {
+    std::cerr << "Point data type did not change the octree key\n";
+    return EXIT_FAILURE;
+  }
+
+  // an octree destroyed during its build cancels it without leaving a cached octree behind
+  vtkNew<vtkPolyData> canceledCloud;
+  canceledCloud->DeepCopy(modifiedCloud);
+  {
+    vtkNew<vtkF3DPointCloudOctree> canceledOctree;
+    canceledOctree->SetMaximumPointsPerNode(10);
+    canceledOctree->Initialize(canceledCloud, cacheDirectory);
+  }
+  vtkNew<vtkF3DPointCloudOctree> reloadedOctree;
+  reloadedOctree->SetMaximumPointsPerNode(10);
+  if (!reloadedOctree->Initialize(canceledCloud, cacheDirectory) ||
+    !reloadedOctree->IsBuilding() || !::WaitForOctree(reloadedOctree))
+  {
+    std::cerr << "Octree was not built again after a canceled build\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  vtkNew<vtkRenderer> renderer;
+  renWin->AddRenderer(renderer);
+  double bounds[6] = { 0.0, 1.0, 0.0, 1.0, 0.0, 1.0 };
+  renderer->ResetCamera(bounds);
+
+  // with a tiny budget, only the root node is selected
+  vtkPolyData* coarse = octree->Update(renderer, nullptr, 1, false);
+  vtkIdType nbCoarsePoints = coarse->GetNumberOfPoints();
+  if (nbCoarsePoints == 0 || nbCoarsePoints > 8 * 8 * 8)
+  {
+    std::cerr << "Unexpected number of points in the root node: " << nbCoarsePoints << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // with a large budget, the selection is refined and keeps the point data
+  vtkPolyData* fine = octree->Update(renderer, nullptr, VTK_ID_MAX, false);
+  vtkIdType nbFinePoints = fine->GetNumberOfPoints();
+  if (nbFinePoints <= nbCoarsePoints || nbFinePoints > nbPoints)
+  {
+    std::cerr << "Unexpected number of points after refinement: " << nbFinePoints << "\n";
+    return EXIT_FAILURE;
+  }
+  if (!fine->GetPointData()->GetArray("scalars"))
+  {
+    std::cerr << "Point data is missing in the streamed points\n";
+    return EXIT_FAILURE;
+  }
+
+  // nodes outside the view frustum are not selected
+  vtkCamera* camera = renderer->GetActiveCamera();
+  double position[3];
+  camera->GetPosition(position);
+  camera->SetFocalPoint(2 * position[0] - 0.5, 2 * position[1] - 0.5, 2 * position[2] - 0.5);
+  vtkPolyData* culled = octree->Update(renderer, nullptr, VTK_ID_MAX, false);
+  if (culled->GetNumberOfPoints() != 0)
+  {
+    std::cerr << "Points outside the view frustum were selected\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+#include <vtkActor.h>
+#include <vtkGenericRenderWindowInteractor.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkWindowToImageFilter.h>
+#include <vtkXMLPolyDataReader.h>
+
+#include "vtkF3DPolyDataMapper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+vtkSmartPointer<vtkUnsignedCharArray> Capture(vtkRenderWindow* renWin)
+{
+  renWin->Render();
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(renWin);
+  w2i->ReadFrontBufferOff();
+  w2i->Update();
+  vtkSmartPointer<vtkUnsignedCharArray> pixels = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  pixels->DeepCopy(w2i->GetOutput()->GetPointData()->GetScalars());
+  return pixels;
+}
+
+bool IsSame(vtkUnsignedCharArray* a, vtkUnsignedCharArray* b)
+{
+  return a->GetNumberOfValues() == b->GetNumberOfValues() &&
+    std::equal(a->Begin(), a->End(), b->Begin());
+}
+}
+
+int TestF3DPolyDataMapperLOD(int argc, char* argv[])
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName((std::string(argv[1]) + "data/cow.vtp").c_str());
+
+  vtkNew<vtkF3DPolyDataMapper> mapper;
+  mapper->SetInputConnection(reader->GetOutputPort());
+  mapper->SetLODTriangleBudget(100);
+
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->OffScreenRenderingOn();
+  renWin->AddRenderer(renderer);
+
+  // the level of detail is only used when an interactor raises the desired update rate
+  vtkNew<vtkGenericRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+
+  renderer->ResetCamera();
+  renWin->SetDesiredUpdateRate(iren->GetStillUpdateRate());
+  vtkSmartPointer<vtkUnsignedCharArray> still = ::Capture(renWin);
+
+  // the proxy is computed in the background, it is rendered during motion once available
+  renWin->SetDesiredUpdateRate(iren->GetDesiredUpdateRate());
+  bool proxyRendered = false;
+  for (int i = 0; i < 100 && !proxyRendered; i++)
+  {
+    proxyRendered = !::IsSame(::Capture(renWin), still);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  if (!proxyRendered)
+  {
+    std::cerr << "Level of detail was not rendered during motion\n";
+    return EXIT_FAILURE;
+  }
+
+  // while the input is modified on every frame, as during an animation, the outdated proxy
+  // is not rendered and no new one is computed
+  for (int i = 0; i < 10; i++)
+  {
+    reader->GetOutput()->Modified();
+    if (!::IsSame(::Capture(renWin), still))
+    {
+      std::cerr << "Level of detail was rendered while the input changes\n";
+      return EXIT_FAILURE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  // the proxy is computed again once the input does not change anymore
+  proxyRendered = false;
+  for (int i = 0; i < 100 && !proxyRendered; i++)
+  {
+    proxyRendered = !::IsSame(::Capture(renWin), still);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  if (!proxyRendered)
+  {
+    std::cerr << "Level of detail was not rendered after the input changes\n";
+    return EXIT_FAILURE;
+  }
+
+  // the full geometry is rendered again once the motion stops
+  renWin->SetDesiredUpdateRate(iren->GetStillUpdateRate());
+  if (!::IsSame(::Capture(renWin), still))
+  {
+    std::cerr << "Full geometry was not rendered when still\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,304 @@
+#include "vtkF3DAccumulationPass.h"
+
+#include "vtkF3DRenderPass.h"
+
+#include <vtkCamera.h>
+#include <vtkInformation.h>
+#include <vtkInformationIntegerKey.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLError.h>
+#include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLQuadHelper.h>
+#include <vtkOpenGLRenderUtilities.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkOpenGLState.h>
+#include <vtkRenderState.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+
+#include <initializer_list>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Low discrepancy sequence used to distribute the sub-pixel offsets
+double Halton(int index, int base)
+{
+  double result = 0.0;
+  double f = 1.0;
+  for (int i = index; i > 0; i /= base)
+  {
+    f /= base;
+    result += f * (i % base);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+std::shared_ptr<vtkOpenGLQuadHelper> CreateQuadHelper(
+  vtkOpenGLRenderWindow* renWin, const std::string& decl, const std::string& impl)
+{
+  std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+  vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", decl);
+  vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Impl", impl);
+  return std::make_shared<vtkOpenGLQuadHelper>(renWin, nullptr, FSSource.c_str(), nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkTextureObject> CreateFloatTexture(vtkOpenGLRenderWindow* renWin)
+{
+  vtkSmartPointer<vtkTextureObject> texture = vtkSmartPointer<vtkTextureObject>::New();
+  texture->SetContext(renWin);
+  texture->SetMinificationFilter(vtkTextureObject::Nearest);
+  texture->SetMagnificationFilter(vtkTextureObject::Nearest);
+  texture->SetWrapS(vtkTextureObject::ClampToEdge);
+  texture->SetWrapT(vtkTextureObject::ClampToEdge);
+  return texture;
+}
+}
+
+vtkStandardNewMacro(vtkF3DAccumulationPass);
+
+vtkInformationKeyMacro(vtkF3DAccumulationPass, ACCUMULATE, Integer);
+
+//------------------------------------------------------------------------------
+void vtkF3DAccumulationPass::Render(const vtkRenderState* s)
+{
+  vtkOpenGLClearErrorMacro();
+
+  assert(this->DelegatePass != nullptr);
+
+  vtkRenderer* r = s->GetRenderer();
+  vtkInformation* info = r->GetInformation();
+  bool uiOnly = info->Has(vtkF3DRenderPass::RENDER_UI_ONLY());
+  bool accumulate = info->Has(vtkF3DAccumulationPass::ACCUMULATE());
+
+  // inside another pass framebuffer, such as the dynamic resolution one, use its size
+  int pos[2] = { 0, 0 };
+  int size[2];
+  vtkFrameBufferObjectBase* fbo = s->GetFrameBuffer();
+  if (fbo)
+  {
+    fbo->GetLastSize(size);
+  }
+  else
+  {
+    r->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+  }
+
+  // the accumulated frames are invalidated by a resize
+  if (this->AccumulationTexture &&
+    (static_cast<int>(this->AccumulationTexture->GetWidth()) != size[0] ||
+      static_cast<int>(this->AccumulationTexture->GetHeight()) != size[1]))
+  {
+    this->NumberOfSamples = 0;
+  }
+
+  if (this->NumberOfSamples == 0 || (!uiOnly && !accumulate))
+  {
+    // any other render means the camera or the scene may have changed, start over
+    this->NumberOfSamples = 0;
+    const double jitter[2] = { 0.0, 0.0 };
+    this->AddSample(s, size, jitter);
+  }
+  else if (accumulate && this->NumberOfSamples < this->MaximumSamples)
+  {
+    // offsets in [-0.5, 0.5] pixel, the first sample is centered
+    const double jitter[2] = { ::Halton(this->NumberOfSamples, 2) - 0.5,
+      ::Halton(this->NumberOfSamples, 3) - 0.5 };
+    this->AddSample(s, size, jitter);
+  }
+
+  this->Display(s, pos, size);
+
+  this->NumberOfRenderedProps = this->DelegatePass->GetNumberOfRenderedProps();
+
+  vtkOpenGLCheckErrorMacro("failed after Render");
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DAccumulationPass::AddSample(
+  const vtkRenderState* s, const int size[2], const double jitter[2])
+{
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+  vtkOpenGLState* ostate = renWin->GetState();
+
+  if (this->ColorTexture == nullptr)
+  {
+    this->ColorTexture = ::CreateFloatTexture(renWin);
+    this->ColorTexture->Allocate2D(size[0], size[1], 4, VTK_FLOAT);
+  }
+  this->ColorTexture->Resize(size[0], size[1]);
+
+  if (this->AccumulationTexture == nullptr)
+  {
+    this->AccumulationTexture = ::CreateFloatTexture(renWin);
+    this->AccumulationTexture->Allocate2D(size[0], size[1], 4, VTK_FLOAT);
+  }
+  this->AccumulationTexture->Resize(size[0], size[1]);
+
+  if (this->FrameBufferObject == nullptr)
+  {
+    this->FrameBufferObject = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->FrameBufferObject->SetContext(renWin);
+  }
+
+  if (this->AccumulationFrameBufferObject == nullptr)
+  {
+    this->AccumulationFrameBufferObject = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->AccumulationFrameBufferObject->SetContext(renWin);
+  }
+
+  // shift the projection by a fraction of pixel, the window center is in [-1, 1]
+  vtkCamera* camera = r->GetActiveCamera();
+  double center[2];
+  camera->GetWindowCenter(center);
+  camera->SetWindowCenter(
+    center[0] + 2.0 * jitter[0] / size[0], center[1] + 2.0 * jitter[1] / size[1]);
+
+  ostate->PushFramebufferBindings();
+  this->RenderDelegate(
+    s, size[0], size[1], size[0], size[1], this->FrameBufferObject, this->ColorTexture);
+  ostate->PopFramebufferBindings();
+
+  camera->SetWindowCenter(center);
+
+  if (!this->AccumulateQuadHelper)
+  {
+    this->AccumulateQuadHelper = ::CreateQuadHelper(
+      renWin, "uniform sampler2D source;\n", "gl_FragData[0] = texture(source, texCoord);\n");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->AccumulateQuadHelper->Program);
+  }
+
+  if (!this->AccumulateQuadHelper->Program ||
+    !this->AccumulateQuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the accumulation shader program.");
+    return;
+  }
+
+  vtkOpenGLState::ScopedglEnableDisable bsaver(ostate, GL_BLEND);
+  vtkOpenGLState::ScopedglEnableDisable dsaver(ostate, GL_DEPTH_TEST);
+  vtkOpenGLState::ScopedglBlendFuncSeparate bfsaver(ostate);
+  vtkOpenGLState::ScopedglClearColor ccsaver(ostate);
+
+  ostate->PushFramebufferBindings();
+  this->AccumulationFrameBufferObject->Bind();
+  this->AccumulationFrameBufferObject->AddColorAttachment(0, this->AccumulationTexture);
+  this->AccumulationFrameBufferObject->ActivateDrawBuffer(0);
+  this->AccumulationFrameBufferObject->StartNonOrtho(size[0], size[1]);
+
+  ostate->vtkglViewport(0, 0, size[0], size[1]);
+  ostate->vtkglScissor(0, 0, size[0], size[1]);
+  if (this->NumberOfSamples == 0)
+  {
+    ostate->vtkglClearColor(0.0, 0.0, 0.0, 0.0);
+    ostate->vtkglClear(GL_COLOR_BUFFER_BIT);
+  }
+
+  // sum the samples, the average is computed when displaying
+  ostate->vtkglDisable(GL_DEPTH_TEST);
+  ostate->vtkglEnable(GL_BLEND);
+  ostate->vtkglBlendFunc(GL_ONE, GL_ONE);
+
+  this->ColorTexture->Activate();
+  this->AccumulateQuadHelper->Program->SetUniformi(
+    "source", this->ColorTexture->GetTextureUnit());
+  this->AccumulateQuadHelper->Render();
+  this->ColorTexture->Deactivate();
+
+  ostate->PopFramebufferBindings();
+
+  this->NumberOfSamples++;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DAccumulationPass::Display(const vtkRenderState* s, const int pos[2], const int size[2])
+{
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+  vtkOpenGLState* ostate = renWin->GetState();
+
+  if (!this->AccumulationTexture || this->NumberOfSamples == 0)
+  {
+    return;
+  }
+
+  if (!this->DisplayQuadHelper)
+  {
+    this->DisplayQuadHelper = ::CreateQuadHelper(renWin,
+      "uniform sampler2D accumulation;\n"
+      "uniform float invNumberOfSamples;\n",
+      "gl_FragData[0] = texture(accumulation, texCoord) * invNumberOfSamples;\n");
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->DisplayQuadHelper->Program);
+  }
+
+  if (!this->DisplayQuadHelper->Program || !this->DisplayQuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the display shader program.");
+    return;
+  }
+
+  vtkOpenGLState::ScopedglEnableDisable bsaver(ostate, GL_BLEND);
+  vtkOpenGLState::ScopedglEnableDisable dsaver(ostate, GL_DEPTH_TEST);
+
+  this->AccumulationTexture->Activate();
+  this->DisplayQuadHelper->Program->SetUniformi(
+    "accumulation", this->AccumulationTexture->GetTextureUnit());
+  this->DisplayQuadHelper->Program->SetUniformf(
+    "invNumberOfSamples", 1.f / static_cast<float>(this->NumberOfSamples));
+
+  ostate->vtkglDisable(GL_BLEND);
+  ostate->vtkglDisable(GL_DEPTH_TEST);
+  ostate->vtkglClear(GL_DEPTH_BUFFER_BIT);
+  ostate->vtkglViewport(pos[0], pos[1], size[0], size[1]);
+  ostate->vtkglScissor(pos[0], pos[1], size[0], size[1]);
+
+  this->DisplayQuadHelper->Render();
+
+  this->AccumulationTexture->Deactivate();
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DAccumulationPass::ReleaseGraphicsResources(vtkWindow* w)
+{
+  this->Superclass::ReleaseGraphicsResources(w);
+
+  for (std::shared_ptr<vtkOpenGLQuadHelper>* helper :
+    { &this->AccumulateQuadHelper, &this->DisplayQuadHelper })
+  {
+    if (*helper)
+    {
+      (*helper)->ReleaseGraphicsResources(w);
+      *helper = nullptr;
+    }
+  }
+  for (vtkOpenGLFramebufferObject* fbo :
+    { this->FrameBufferObject.GetPointer(), this->AccumulationFrameBufferObject.GetPointer() })
+  {
+    if (fbo)
+    {
+      fbo->ReleaseGraphicsResources(w);
+    }
+  }
+  for (vtkTextureObject* texture :
+    { this->ColorTexture.GetPointer(), this->AccumulationTexture.GetPointer() })
+  {
+    if (texture)
+    {
+      texture->ReleaseGraphicsResources(w);
+    }
+  }
+
+  // the accumulation buffer content is lost
+  this->NumberOfSamples = 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * @class   vtkF3DAccumulationPass
+ * @brief   Progressive anti-aliasing by accumulation of jittered frames
+ *
+ * Image processing pass averaging successive renderings of its delegate with a sub-pixel
+ * jitter of the camera, using a float accumulation buffer.
+ * A regular render restarts the accumulation from a single non-jittered frame.
+ * A render with the ACCUMULATE key set in the renderer information adds one jittered frame to the
+ * accumulation buffer, until the maximum number of samples is reached.
+ * A render with the vtkF3DRenderPass::RENDER_UI_ONLY key set only displays the current average.
+ *
+ * @sa
+ * vtkImageProcessingPass
+ */
+
+#ifndef vtkF3DAccumulationPass_h
+#define vtkF3DAccumulationPass_h
+
+#include <vtkImageProcessingPass.h>
+#include <vtkSmartPointer.h>
+
+#include <memory>
+
+class vtkInformationIntegerKey;
+class vtkOpenGLFramebufferObject;
+class vtkOpenGLQuadHelper;
+class vtkTextureObject;
+
+class vtkF3DAccumulationPass : public vtkImageProcessingPass
+{
+public:
+  static vtkF3DAccumulationPass* New();
+  vtkTypeMacro(vtkF3DAccumulationPass, vtkImageProcessingPass);
+
+  /**
+   * Perform rendering according to a render state.
+   */
+  void Render(const vtkRenderState* s) override;
+
+  /**
+   * Release graphics resources and ask components to release their own resources.
+   */
+  void ReleaseGraphicsResources(vtkWindow* w) override;
+
+  ///@{
+  /**
+   * Set/Get the number of frames after which the accumulation stops.
+   * Default is 64.
+   */
+  vtkSetClampMacro(MaximumSamples, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumSamples, int);
+  ///@}
+
+  /**
+   * Get the number of frames currently accumulated.
+   */
+  vtkGetMacro(NumberOfSamples, int);
+
+  /**
+   * Return true if a frame has been rendered and the maximum number of samples is not reached.
+   */
+  bool NeedsAccumulation() const
+  {
+    return this->NumberOfSamples > 0 && this->NumberOfSamples < this->MaximumSamples;
+  }
+
+  /**
+   * Forbidden copies.
+   */
+  vtkF3DAccumulationPass(const vtkF3DAccumulationPass&) = delete;
+  void operator=(const vtkF3DAccumulationPass&) = delete;
+
+  static vtkInformationIntegerKey* ACCUMULATE();
+
+private:
+  vtkF3DAccumulationPass() = default;
+  ~vtkF3DAccumulationPass() override = default;
+
+  /**
+   * Render the delegate with the given sub-pixel offset and add it to the accumulation buffer.
+   */
+  void AddSample(const vtkRenderState* s, const int size[2], const double jitter[2]);
+
+  /**
+   * Draw the average of the accumulated frames in the current framebuffer.
+   */
+  void Display(const vtkRenderState* s, const int pos[2], const int size[2]);
+
+  vtkSmartPointer<vtkOpenGLFramebufferObject> FrameBufferObject;
+  vtkSmartPointer<vtkTextureObject> ColorTexture;
+  vtkSmartPointer<vtkOpenGLFramebufferObject> AccumulationFrameBufferObject;
+  vtkSmartPointer<vtkTextureObject> AccumulationTexture;
+
+  std::shared_ptr<vtkOpenGLQuadHelper> AccumulateQuadHelper;
+  std::shared_ptr<vtkOpenGLQuadHelper> DisplayQuadHelper;
+
+  int MaximumSamples = 64;
+  int NumberOfSamples = 0;
+};
+
+#endif
@@ -5,6 +5,11 @@
 
 vtkStandardNewMacro(vtkF3DConsoleOutputWindow);
 
+namespace
+{
+thread_local bool DeferMessagesOnThread = false;
+}
+
 //----------------------------------------------------------------------------
 #ifdef WIN32
 vtkF3DConsoleOutputWindow::vtkF3DConsoleOutputWindow()
@@ -22,6 +27,11 @@ vtkF3DConsoleOutputWindow::vtkF3DConsoleOutputWindow() = default;
 //----------------------------------------------------------------------------
 void vtkF3DConsoleOutputWindow::DisplayText(const char* txt)
 {
+  if (this->DeferMessage(vtkOutputWindow::MESSAGE_TYPE_TEXT, txt))
+  {
+    return;
+  }
+
   std::string fmtText;
   switch (this->GetCurrentMessageType())
   {
@@ -53,3 +63,95 @@ void vtkF3DConsoleOutputWindow::DisplayText(const char* txt)
       break;
   }
 }
+
+//----------------------------------------------------------------------------
+void vtkF3DConsoleOutputWindow::DisplayErrorText(const char* txt)
+{
+  if (!this->DeferMessage(vtkOutputWindow::MESSAGE_TYPE_ERROR, txt))
+  {
+    this->Superclass::DisplayErrorText(txt);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DConsoleOutputWindow::DisplayWarningText(const char* txt)
+{
+  if (!this->DeferMessage(vtkOutputWindow::MESSAGE_TYPE_WARNING, txt))
+  {
+    this->Superclass::DisplayWarningText(txt);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DConsoleOutputWindow::DisplayGenericWarningText(const char* txt)
+{
+  if (!this->DeferMessage(vtkOutputWindow::MESSAGE_TYPE_GENERIC_WARNING, txt))
+  {
+    this->Superclass::DisplayGenericWarningText(txt);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DConsoleOutputWindow::DisplayDebugText(const char* txt)
+{
+  if (!this->DeferMessage(vtkOutputWindow::MESSAGE_TYPE_DEBUG, txt))
+  {
+    this->Superclass::DisplayDebugText(txt);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DConsoleOutputWindow::SetDeferMessages(bool defer)
+{
+  ::DeferMessagesOnThread = defer;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DConsoleOutputWindow::DeferMessage(MessageTypes type, const char* txt)
+{
+  if (!::DeferMessagesOnThread || std::this_thread::get_id() == this->OwnerThreadId)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->DeferredMessagesMutex);
+  this->DeferredMessages.emplace_back(type, txt ? txt : "");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DConsoleOutputWindow::FlushDeferredMessages()
+{
+  if (std::this_thread::get_id() != this->OwnerThreadId)
+  {
+    return;
+  }
+
+  std::vector<std::pair<MessageTypes, std::string>> messages;
+  {
+    std::lock_guard<std::mutex> lock(this->DeferredMessagesMutex);
+    messages.swap(this->DeferredMessages);
+  }
+
+  for (const auto& [type, txt] : messages)
+  {
+    switch (type)
+    {
+      case vtkOutputWindow::MESSAGE_TYPE_ERROR:
+        this->DisplayErrorText(txt.c_str());
+        break;
+      case vtkOutputWindow::MESSAGE_TYPE_WARNING:
+        this->DisplayWarningText(txt.c_str());
+        break;
+      case vtkOutputWindow::MESSAGE_TYPE_GENERIC_WARNING:
+        this->DisplayGenericWarningText(txt.c_str());
+        break;
+      case vtkOutputWindow::MESSAGE_TYPE_DEBUG:
+        this->DisplayDebugText(txt.c_str());
+        break;
+      default:
+        this->DisplayText(txt.c_str());
+        break;
+    }
+  }
+}
@@ -10,6 +10,12 @@
 
 #include <vtkCommand.h>
 
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 class vtkF3DConsoleOutputWindow : public vtkOutputWindow
 {
 public:
@@ -31,6 +37,32 @@ public:
    */
   void DisplayText(const char*) override;
 
+  ///@{
+  /**
+   * Reimplemented to defer the messages displayed from a thread that enabled
+   * SetDeferMessages, as displaying them from a thread that can run concurrently with the main
+   * one for a long time is not thread safe.
+   */
+  void DisplayErrorText(const char*) override;
+  void DisplayWarningText(const char*) override;
+  void DisplayGenericWarningText(const char*) override;
+  void DisplayDebugText(const char*) override;
+  ///@}
+
+  /**
+   * Display the messages deferred from other threads.
+   * Does nothing if not called from the thread that created this output window.
+   */
+  void FlushDeferredMessages();
+
+  /**
+   * Set if the messages displayed from the calling thread are deferred until
+   * FlushDeferredMessages is called. Other threads, including the SMP workers,
+   * are not impacted and display their messages immediately.
+   * Default is false.
+   */
+  static void SetDeferMessages(bool defer);
+
   //@{
   /**
    * Set/Get the coloring usage.
@@ -47,8 +79,19 @@ protected:
   vtkF3DConsoleOutputWindow();
   ~vtkF3DConsoleOutputWindow() override = default;
 
+  /**
+   * Store the message to display it with FlushDeferredMessages if called from a thread that
+   * enabled SetDeferMessages.
+   * Return true if the message was deferred.
+   */
+  bool DeferMessage(MessageTypes type, const char* txt);
+
 private:
   bool UseColoring = true;
+
+  std::thread::id OwnerThreadId = std::this_thread::get_id();
+  std::mutex DeferredMessagesMutex;
+  std::vector<std::pair<MessageTypes, std::string>> DeferredMessages;
 };
 
 #endif
@@ -0,0 +1,252 @@
+#include "vtkF3DDynamicResolutionPass.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLError.h>
+#include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLQuadHelper.h>
+#include <vtkOpenGLRenderTimer.h>
+#include <vtkOpenGLRenderUtilities.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkOpenGLState.h>
+#include <vtkRenderState.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+vtkStandardNewMacro(vtkF3DDynamicResolutionPass);
+
+//------------------------------------------------------------------------------
+vtkF3DDynamicResolutionPass::vtkF3DDynamicResolutionPass()
+  : Timer(new vtkOpenGLRenderTimer())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkF3DDynamicResolutionPass::~vtkF3DDynamicResolutionPass() = default;
+
+//------------------------------------------------------------------------------
+void vtkF3DDynamicResolutionPass::Render(const vtkRenderState* s)
+{
+  vtkOpenGLClearErrorMacro();
+
+  assert(this->DelegatePass != nullptr);
+
+  vtkRenderer* r = s->GetRenderer();
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(r->GetRenderWindow());
+
+  // the interactor styles raise the desired update rate of the window during motion
+  vtkRenderWindowInteractor* iren = renWin->GetInteractor();
+  bool interactive = iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+  if (interactive)
+  {
+    this->UpdateScale();
+  }
+  else
+  {
+    // the next motion starts at full resolution, a pending measurement is obsolete
+    this->Scale = 1.0;
+    this->Timer->Reset();
+    this->MeasuredTime = 0.0;
+  }
+
+  // inside another pass framebuffer, such as the overlay one, use its size
+  int pos[2] = { 0, 0 };
+  int size[2];
+  vtkFrameBufferObjectBase* fbo = s->GetFrameBuffer();
+  if (fbo)
+  {
+    fbo->GetLastSize(size);
+  }
+  else
+  {
+    r->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+  }
+
+  // quantize the scaled size so that the framebuffer is not reallocated on every frame
+  double scale = std::round(this->Scale * 20.0) / 20.0;
+  int scaledSize[2] = { std::max(1, static_cast<int>(size[0] * scale)),
+    std::max(1, static_cast<int>(size[1] * scale)) };
+
+  if (!interactive || scale >= 1.0)
+  {
+    if (interactive)
+    {
+      this->StartTiming(1.0);
+    }
+    this->DelegatePass->Render(s);
+    this->StopTiming(renWin);
+    this->NumberOfRenderedProps = this->DelegatePass->GetNumberOfRenderedProps();
+    return;
+  }
+
+  this->NumberOfRenderedProps = 0;
+
+  vtkOpenGLState* ostate = renWin->GetState();
+  vtkOpenGLState::ScopedglEnableDisable bsaver(ostate, GL_BLEND);
+  vtkOpenGLState::ScopedglEnableDisable dsaver(ostate, GL_DEPTH_TEST);
+
+  // create FBO and texture
+  if (this->ColorTexture == nullptr)
+  {
+    this->ColorTexture = vtkSmartPointer<vtkTextureObject>::New();
+    this->ColorTexture->SetContext(renWin);
+    this->ColorTexture->SetMinificationFilter(vtkTextureObject::Linear);
+    this->ColorTexture->SetMagnificationFilter(vtkTextureObject::Linear);
+    this->ColorTexture->SetWrapS(vtkTextureObject::ClampToEdge);
+    this->ColorTexture->SetWrapT(vtkTextureObject::ClampToEdge);
+    this->ColorTexture->Allocate2D(scaledSize[0], scaledSize[1], 4, VTK_UNSIGNED_CHAR);
+  }
+  this->ColorTexture->Resize(scaledSize[0], scaledSize[1]);
+
+  if (this->FrameBufferObject == nullptr)
+  {
+    this->FrameBufferObject = vtkSmartPointer<vtkOpenGLFramebufferObject>::New();
+    this->FrameBufferObject->SetContext(renWin);
+  }
+
+  // the camera must not be adjusted by RenderDelegate, only the framebuffer size differs
+  renWin->GetState()->PushFramebufferBindings();
+  this->StartTiming(scale);
+  this->RenderDelegate(s, scaledSize[0], scaledSize[1], scaledSize[0], scaledSize[1],
+    this->FrameBufferObject, this->ColorTexture);
+  this->StopTiming(renWin);
+  renWin->GetState()->PopFramebufferBindings();
+
+  if (!this->QuadHelper)
+  {
+    std::string FSSource = vtkOpenGLRenderUtilities::GetFullScreenQuadFragmentShaderTemplate();
+
+    vtkShaderProgram::Substitute(FSSource, "//VTK::FSQ::Decl", "uniform sampler2D source;\n");
+
+    // upsample using the linear filtering of the texture
+    vtkShaderProgram::Substitute(
+      FSSource, "//VTK::FSQ::Impl", "gl_FragData[0] = texture(source, texCoord);");
+
+    this->QuadHelper =
+      std::make_shared<vtkOpenGLQuadHelper>(renWin, nullptr, FSSource.c_str(), nullptr);
+  }
+  else
+  {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->QuadHelper->Program);
+  }
+
+  if (!this->QuadHelper->Program || !this->QuadHelper->Program->GetCompiled())
+  {
+    vtkErrorMacro("Couldn't build the shader program.");
+    return;
+  }
+
+  this->ColorTexture->Activate();
+  this->QuadHelper->Program->SetUniformi("source", this->ColorTexture->GetTextureUnit());
+
+  ostate->vtkglDisable(GL_BLEND);
+  ostate->vtkglDisable(GL_DEPTH_TEST);
+  ostate->vtkglClear(GL_DEPTH_BUFFER_BIT);
+  ostate->vtkglViewport(pos[0], pos[1], size[0], size[1]);
+  ostate->vtkglScissor(pos[0], pos[1], size[0], size[1]);
+
+  this->QuadHelper->Render();
+
+  this->ColorTexture->Deactivate();
+
+  vtkOpenGLCheckErrorMacro("failed after Render");
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DDynamicResolutionPass::StartTiming(double scale)
+{
+  if (vtkOpenGLRenderTimer::IsSupported())
+  {
+    // a single query is in flight, frames are not measured until its result is available
+    if (this->Timer->Started())
+    {
+      return;
+    }
+    this->Timer->Start();
+  }
+  else
+  {
+    this->TimingStart = std::chrono::steady_clock::now();
+  }
+  this->TimedScale = scale;
+  this->Timing = true;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DDynamicResolutionPass::StopTiming(vtkOpenGLRenderWindow* renWin)
+{
+  if (!this->Timing)
+  {
+    return;
+  }
+  this->Timing = false;
+
+  if (vtkOpenGLRenderTimer::IsSupported())
+  {
+    this->Timer->Stop();
+  }
+  else
+  {
+    // without timer queries, wait for the delegate rendering to complete
+    renWin->WaitForCompletion();
+    this->MeasuredTime =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - this->TimingStart).count();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DDynamicResolutionPass::UpdateScale()
+{
+  double renderTime = 0.0;
+  if (vtkOpenGLRenderTimer::IsSupported())
+  {
+    if (this->Timer->Stopped() && this->Timer->Ready())
+    {
+      renderTime = this->Timer->GetElapsedSeconds();
+      this->Timer->Reset();
+    }
+  }
+  else
+  {
+    renderTime = this->MeasuredTime;
+    this->MeasuredTime = 0.0;
+  }
+
+  if (renderTime <= 0.0 || this->TargetFrameTime <= 0.0)
+  {
+    return;
+  }
+
+  // the rendering time is mostly proportional to the number of pixels,
+  // damp the correction to avoid oscillations
+  double target = this->TimedScale * std::sqrt(this->TargetFrameTime / renderTime);
+  this->Scale = std::clamp(0.5 * (this->Scale + target), this->MinimumScale, 1.0);
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DDynamicResolutionPass::ReleaseGraphicsResources(vtkWindow* w)
+{
+  this->Superclass::ReleaseGraphicsResources(w);
+
+  this->Timer->ReleaseGraphicsResources();
+
+  if (this->QuadHelper)
+  {
+    this->QuadHelper->ReleaseGraphicsResources(w);
+    this->QuadHelper = nullptr;
+  }
+  if (this->FrameBufferObject)
+  {
+    this->FrameBufferObject->ReleaseGraphicsResources(w);
+  }
+  if (this->ColorTexture)
+  {
+    this->ColorTexture->ReleaseGraphicsResources(w);
+  }
+}
@@ -0,0 +1,112 @@
+/**
+ * @class   vtkF3DDynamicResolutionPass
+ * @brief   Render the delegate at a lower resolution during camera motion
+ *
+ * Image processing pass rendering its delegate in a reduced resolution framebuffer while the
+ * interactor style reports a motion state, and upsampling the result with a linear filter.
+ * The resolution scale is adjusted during motion so that the rendering time of the delegate
+ * gets close to the target frame time. It is measured with a GPU timer query when supported,
+ * and with a CPU timer waiting for the completion of the delegate rendering otherwise.
+ * When the camera is idle, including all offscreen renderings, the delegate is rendered directly
+ * at full resolution and the scale is reset, so that each motion starts at full resolution.
+ *
+ * @sa
+ * vtkImageProcessingPass
+ */
+
+#ifndef vtkF3DDynamicResolutionPass_h
+#define vtkF3DDynamicResolutionPass_h
+
+#include <vtkImageProcessingPass.h>
+#include <vtkSmartPointer.h>
+
+#include <chrono>
+#include <memory>
+
+class vtkOpenGLFramebufferObject;
+class vtkOpenGLQuadHelper;
+class vtkOpenGLRenderTimer;
+class vtkOpenGLRenderWindow;
+class vtkTextureObject;
+
+class vtkF3DDynamicResolutionPass : public vtkImageProcessingPass
+{
+public:
+  static vtkF3DDynamicResolutionPass* New();
+  vtkTypeMacro(vtkF3DDynamicResolutionPass, vtkImageProcessingPass);
+
+  /**
+   * Perform rendering according to a render state.
+   */
+  void Render(const vtkRenderState* s) override;
+
+  /**
+   * Release graphics resources and ask components to release their own resources.
+   */
+  void ReleaseGraphicsResources(vtkWindow* w) override;
+
+  ///@{
+  /**
+   * Set/Get the frame time in seconds to reach during camera motion.
+   * Default is 1/30 second.
+   */
+  vtkSetMacro(TargetFrameTime, double);
+  vtkGetMacro(TargetFrameTime, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the minimum resolution scale used during camera motion.
+   * Default is 0.25.
+   */
+  vtkSetClampMacro(MinimumScale, double, 0.05, 1.0);
+  vtkGetMacro(MinimumScale, double);
+  ///@}
+
+  /**
+   * Get the resolution scale used by the last interactive frame, 1 when the camera is idle.
+   */
+  vtkGetMacro(Scale, double);
+
+  /**
+   * Forbidden copies.
+   */
+  vtkF3DDynamicResolutionPass(const vtkF3DDynamicResolutionPass&) = delete;
+  void operator=(const vtkF3DDynamicResolutionPass&) = delete;
+
+private:
+  vtkF3DDynamicResolutionPass();
+  ~vtkF3DDynamicResolutionPass() override;
+
+  /**
+   * Start measuring the rendering time of the delegate rendered with the provided scale,
+   * unless a previous measurement is still pending.
+   */
+  void StartTiming(double scale);
+
+  /**
+   * Stop measuring the rendering time of the delegate.
+   */
+  void StopTiming(vtkOpenGLRenderWindow* renWin);
+
+  /**
+   * Update the resolution scale from the last measured rendering time of the delegate, if any.
+   */
+  void UpdateScale();
+
+  vtkSmartPointer<vtkOpenGLFramebufferObject> FrameBufferObject;
+  vtkSmartPointer<vtkTextureObject> ColorTexture;
+  std::shared_ptr<vtkOpenGLQuadHelper> QuadHelper;
+
+  double TargetFrameTime = 1.0 / 30.0;
+  double MinimumScale = 0.25;
+  double Scale = 1.0;
+
+  std::unique_ptr<vtkOpenGLRenderTimer> Timer;
+  bool Timing = false;
+  double TimedScale = 1.0;
+  std::chrono::steady_clock::time_point TimingStart;
+  double MeasuredTime = 0.0;
+};
+
+#endif
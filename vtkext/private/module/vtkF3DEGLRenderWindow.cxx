@@ -7,9 +7,15 @@
 #endif
 
 #include "vtkF3DEGLRenderWindow.h"
+#include "vtkF3DShaderCache.h"
 
 //------------------------------------------------------------------------------
-vtkF3DEGLRenderWindow::vtkF3DEGLRenderWindow() = default;
+vtkF3DEGLRenderWindow::vtkF3DEGLRenderWindow()
+{
+  // use a shader cache able to store program binaries on disk
+  this->ShaderCache->Delete();
+  this->ShaderCache = vtkF3DShaderCache::New();
+}
 
 //------------------------------------------------------------------------------
 vtkF3DEGLRenderWindow::~vtkF3DEGLRenderWindow() = default;
@@ -3,6 +3,7 @@
 #include <vtkOpenGLState.h>
 
 #include "vtkF3DExternalRenderWindow.h"
+#include "vtkF3DShaderCache.h"
 
 vtkStandardNewMacro(vtkF3DExternalRenderWindow);
 
@@ -10,6 +11,10 @@ vtkStandardNewMacro(vtkF3DExternalRenderWindow);
 vtkF3DExternalRenderWindow::vtkF3DExternalRenderWindow()
 {
   this->FrameBlitMode = BlitToCurrent;
+
+  // use a shader cache able to store program binaries on disk
+  this->ShaderCache->Delete();
+  this->ShaderCache = vtkF3DShaderCache::New();
 }
 
 //------------------------------------------------------------------------------
@@ -9,11 +9,17 @@
 #endif
 
 #include "vtkF3DGLXRenderWindow.h"
+#include "vtkF3DShaderCache.h"
 
 #include <X11/Xlib.h>
 
 //------------------------------------------------------------------------------
-vtkF3DGLXRenderWindow::vtkF3DGLXRenderWindow() = default;
+vtkF3DGLXRenderWindow::vtkF3DGLXRenderWindow()
+{
+  // use a shader cache able to store program binaries on disk
+  this->ShaderCache->Delete();
+  this->ShaderCache = vtkF3DShaderCache::New();
+}
 
 //------------------------------------------------------------------------------
 vtkF3DGLXRenderWindow::~vtkF3DGLXRenderWindow() = default;
@@ -4,6 +4,7 @@
 #include "vtkF3DPostProcessFilter.h"
 
 #include <vtkActor.h>
+#include <vtkCallbackCommand.h>
 #include <vtkEventForwarderCommand.h>
 #include <vtkImageData.h>
 #include <vtkInformation.h>
@@ -18,8 +19,16 @@
 #include <vtkSmartPointer.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkVersion.h>
-
+#include <vtkXMLImageDataReader.h>
+#include <vtkXMLImageDataWriter.h>
+#include <vtkXMLPolyDataReader.h>
+#include <vtkXMLPolyDataWriter.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
 #include <cassert>
+#include <random>
 #include <sstream>
 
 struct vtkF3DGenericImporter::Internals
@@ -36,8 +45,54 @@ struct vtkF3DGenericImporter::Internals
   bool HasAnimation = false;
   bool AnimationEnabled = false;
   std::array<double, 2> TimeRange;
+
+  std::atomic<bool> Cancelled = false;
+
+  std::string CacheDirectory;
+  bool CacheWritten = false;
+
+  // Only set when the outputs were read from the cache
+  vtkSmartPointer<vtkPolyData> CachedSurface;
+  vtkSmartPointer<vtkPolyData> CachedPoints;
+  vtkSmartPointer<vtkImageData> CachedImage;
+  std::string CachedDescription;
 };
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Uncompressed raw appended data, so that reading is mostly a copy of the file content
+template<typename WriterType>
+bool WriteCachedOutput(vtkDataObject* output, const std::string& path)
+{
+  vtkNew<WriterType> writer;
+  writer->SetFileName(path.c_str());
+  writer->SetInputData(output);
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  return writer->Write() == 1;
+}
+
+//----------------------------------------------------------------------------
+template<typename ReaderType>
+vtkSmartPointer<vtkDataObject> ReadCachedOutput(const std::string& path)
+{
+  if (!vtksys::SystemTools::FileExists(path, true))
+  {
+    return nullptr;
+  }
+  vtkNew<ReaderType> reader;
+  reader->SetFileName(path.c_str());
+  reader->Update();
+  if (reader->GetErrorCode() != 0)
+  {
+    return nullptr;
+  }
+  return reader->GetOutputDataObject(0);
+}
+}
+
 vtkStandardNewMacro(vtkF3DGenericImporter);
 
 //----------------------------------------------------------------------------
@@ -127,24 +182,33 @@ void vtkF3DGenericImporter::ImportActors(vtkRenderer* ren)
   vtkNew<vtkEventForwarderCommand> progressForwarder;
   progressForwarder->SetTarget(this);
   this->Pimpl->Reader->AddObserver(vtkCommand::ProgressEvent, progressForwarder);
-  bool status = this->Pimpl->PostPro->GetExecutive()->Update();
-  if (!status || !this->Pimpl->Reader->GetOutputDataObject(0))
+  if (!this->UpdateOutputs())
   {
     this->SetFailureStatus();
     return;
   }
 
-  // Cast to dataset types
-  this->Pimpl->ImportedPoints = vtkPolyData::SafeDownCast(this->Pimpl->PostPro->GetOutput(1));
-  vtkImageData* image = vtkImageData::SafeDownCast(this->Pimpl->PostPro->GetOutput(2));
-  this->Pimpl->ImportedImage = image->GetNumberOfCells() > 0 ? image : nullptr;
+  if (this->Pimpl->CachedSurface)
+  {
+    this->Pimpl->ImportedPoints = this->Pimpl->CachedPoints;
+    this->Pimpl->ImportedImage = this->Pimpl->CachedImage;
+    this->Pimpl->OutputDescription = this->Pimpl->CachedDescription;
+    this->Pimpl->PolyDataMapper->SetInputData(this->Pimpl->CachedSurface);
+  }
+  else
+  {
+    // Cast to dataset types
+    this->Pimpl->ImportedPoints = vtkPolyData::SafeDownCast(this->Pimpl->PostPro->GetOutput(1));
+    vtkImageData* image = vtkImageData::SafeDownCast(this->Pimpl->PostPro->GetOutput(2));
+    this->Pimpl->ImportedImage = image->GetNumberOfCells() > 0 ? image : nullptr;
 
-  // Recover output description from the reader
-  this->Pimpl->OutputDescription =
-    vtkF3DGenericImporter::GetDataObjectDescription(this->Pimpl->Reader->GetOutputDataObject(0));
+    // Recover output description from the reader
+    this->Pimpl->OutputDescription = vtkF3DGenericImporter::GetDataObjectDescription(
+      this->Pimpl->Reader->GetOutputDataObject(0));
 
-  // Add filter outputs to mapper inputs
-  this->Pimpl->PolyDataMapper->SetInputConnection(this->Pimpl->PostPro->GetOutputPort(0));
+    // Add filter outputs to mapper inputs
+    this->Pimpl->PolyDataMapper->SetInputConnection(this->Pimpl->PostPro->GetOutputPort(0));
+  }
   this->Pimpl->PolyDataMapper->ScalarVisibilityOff();
 
   // Set geometry actor default properties
@@ -178,6 +242,181 @@ void vtkF3DGenericImporter::SetInternalReader(vtkAlgorithm* reader)
   {
     this->Pimpl->Reader = reader;
     this->Pimpl->PostPro->SetInputConnection(this->Pimpl->Reader->GetOutputPort());
+
+    this->Pimpl->CacheWritten = false;
+    this->Pimpl->CachedSurface = nullptr;
+    this->Pimpl->CachedPoints = nullptr;
+    this->Pimpl->CachedImage = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::PreUpdate()
+{
+  if (!this->Pimpl->Reader || this->Pimpl->Cancelled)
+  {
+    return false;
+  }
+
+  // Abort from the reading thread itself once cancelled, as algorithms check it while executing
+  vtkNew<vtkCallbackCommand> abortCallback;
+  abortCallback->SetClientData(this->Pimpl.get());
+  abortCallback->SetCallback(
+    [](vtkObject* caller, unsigned long, void* clientData, void*)
+    {
+      if (static_cast<Internals*>(clientData)->Cancelled)
+      {
+        static_cast<vtkAlgorithm*>(caller)->AbortExecuteOn();
+      }
+    });
+  unsigned long readerTag =
+    this->Pimpl->Reader->AddObserver(vtkCommand::ProgressEvent, abortCallback);
+  unsigned long postProTag =
+    this->Pimpl->PostPro->AddObserver(vtkCommand::ProgressEvent, abortCallback);
+
+  bool status = this->UpdateOutputs();
+
+  this->Pimpl->Reader->RemoveObserver(readerTag);
+  this->Pimpl->PostPro->RemoveObserver(postProTag);
+  return status && !this->Pimpl->Cancelled;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::CancelUpdate()
+{
+  this->Pimpl->Cancelled = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::SetCacheDirectory(const std::string& directory)
+{
+  this->Pimpl->CacheDirectory = directory;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::UpdateOutputs()
+{
+  if (this->Pimpl->CachedSurface)
+  {
+    // Cached outputs do not depend on the reader
+    return true;
+  }
+
+  bool useCache = !this->Pimpl->CacheDirectory.empty() && !this->Pimpl->CacheWritten;
+  if (useCache)
+  {
+    // Each time value has its own outputs, do not cache them
+    this->UpdateTemporalInformation();
+    useCache = !this->Pimpl->HasAnimation;
+  }
+
+  if (useCache && this->ReadCache())
+  {
+    F3DLog::Print(
+      F3DLog::Severity::Debug, "Processed geometry read from " + this->Pimpl->CacheDirectory);
+    return true;
+  }
+
+  bool status = this->Pimpl->PostPro->GetExecutive()->Update();
+  if (!status || !this->Pimpl->Reader->GetOutputDataObject(0))
+  {
+    return false;
+  }
+
+  // Outputs of an aborted update may be incomplete, never cache them
+  if (useCache && !this->Pimpl->Cancelled)
+  {
+    this->WriteCache();
+    this->Pimpl->CacheWritten = true;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DGenericImporter::ReadCache()
+{
+  const std::string& directory = this->Pimpl->CacheDirectory;
+  vtksys::ifstream descriptionFile(directory + "/description.txt");
+  if (!descriptionFile.is_open())
+  {
+    return false;
+  }
+
+  vtkSmartPointer<vtkPolyData> surface = vtkPolyData::SafeDownCast(
+    ::ReadCachedOutput<vtkXMLPolyDataReader>(directory + "/surface.vtp"));
+  vtkSmartPointer<vtkPolyData> points = vtkPolyData::SafeDownCast(
+    ::ReadCachedOutput<vtkXMLPolyDataReader>(directory + "/points.vtp"));
+  if (!surface || !points)
+  {
+    return false;
+  }
+
+  // The image is only written when not empty
+  std::string imagePath = directory + "/image.vti";
+  vtkSmartPointer<vtkImageData> image;
+  if (vtksys::SystemTools::FileExists(imagePath, true))
+  {
+    image = vtkImageData::SafeDownCast(::ReadCachedOutput<vtkXMLImageDataReader>(imagePath));
+    if (!image)
+    {
+      return false;
+    }
+  }
+
+  std::stringstream description;
+  description << descriptionFile.rdbuf();
+
+  this->Pimpl->CachedSurface = surface;
+  this->Pimpl->CachedPoints = points;
+  this->Pimpl->CachedImage = image;
+  this->Pimpl->CachedDescription = description.str();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGenericImporter::WriteCache()
+{
+  // Write in a temporary directory renamed once complete,
+  // so that partially written outputs are never read
+  const std::string& directory = this->Pimpl->CacheDirectory;
+  std::string tmpDirectory = directory + "." + std::to_string(std::random_device()()) + ".tmp";
+  if (!vtksys::SystemTools::MakeDirectory(tmpDirectory))
+  {
+    F3DLog::Print(F3DLog::Severity::Warning, "Cannot create geometry cache " + tmpDirectory);
+    return;
+  }
+
+  vtkImageData* image = vtkImageData::SafeDownCast(this->Pimpl->PostPro->GetOutput(2));
+  bool written = ::WriteCachedOutput<vtkXMLPolyDataWriter>(
+    this->Pimpl->PostPro->GetOutput(0), tmpDirectory + "/surface.vtp");
+  written = written &&
+    ::WriteCachedOutput<vtkXMLPolyDataWriter>(
+      this->Pimpl->PostPro->GetOutput(1), tmpDirectory + "/points.vtp");
+  if (written && image->GetNumberOfCells() > 0)
+  {
+    written = ::WriteCachedOutput<vtkXMLImageDataWriter>(image, tmpDirectory + "/image.vti");
+  }
+
+  if (written)
+  {
+    vtksys::ofstream descriptionFile(tmpDirectory + "/description.txt");
+    descriptionFile << vtkF3DGenericImporter::GetDataObjectDescription(
+      this->Pimpl->Reader->GetOutputDataObject(0));
+    written = descriptionFile.good();
+  }
+
+  // Another process may have written the same outputs meanwhile
+  if (!written || !vtksys::SystemTools::RenameFile(tmpDirectory, directory))
+  {
+    vtksys::SystemTools::RemoveADirectory(tmpDirectory);
+  }
+  if (!written)
+  {
+    F3DLog::Print(F3DLog::Severity::Warning, "Cannot write geometry cache in " + directory);
+  }
+  else
+  {
+    F3DLog::Print(F3DLog::Severity::Debug, "Processed geometry cached in " + directory);
   }
 }
 
@@ -28,6 +28,31 @@ public:
    */
   void SetInternalReader(vtkAlgorithm* reader);
 
+  /**
+   * Read the file and run the post processing without importing any actor.
+   * This can be called from another thread before the importer is used,
+   * the file will not be read again when importing actors.
+   * Return false if the reader failed.
+   */
+  bool PreUpdate();
+
+  /**
+   * Ask a PreUpdate running in another thread to stop as soon as possible.
+   * The reader and the post processing are aborted on their next progress update,
+   * the importer must not be used after that.
+   */
+  void CancelUpdate();
+
+  /**
+   * Set the directory used to cache the post processed outputs.
+   * If it contains the outputs of a previous import, they are read instead of executing the
+   * reader, otherwise they are written in it once the reader has been executed.
+   * The directory must be specific to the file and to the reader options.
+   * Outputs of readers providing an animation are never cached.
+   * Default is empty, which disables the cache.
+   */
+  void SetCacheDirectory(const std::string& directory);
+
   /**
    * Get a string describing the outputs
    */
@@ -118,6 +143,22 @@ private:
   vtkF3DGenericImporter(const vtkF3DGenericImporter&) = delete;
   void operator=(const vtkF3DGenericImporter&) = delete;
 
+  /**
+   * Read the outputs from the cache directory if possible, execute the reader and
+   * the post processing otherwise. Return false if the reader failed.
+   */
+  bool UpdateOutputs();
+
+  /**
+   * Read the cached outputs, return false if they are missing.
+   */
+  bool ReadCache();
+
+  /**
+   * Write the post processed outputs in the cache directory.
+   */
+  void WriteCache();
+
   struct Internals;
   std::unique_ptr<Internals> Pimpl;
 };
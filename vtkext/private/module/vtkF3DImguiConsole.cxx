@@ -12,6 +12,9 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
 
 struct vtkF3DImguiConsole::Internals
 {
@@ -24,30 +27,244 @@ struct vtkF3DImguiConsole::Internals
     Completion
   };
 
-  std::vector<std::pair<LogType, std::string>> Logs;
+  struct LogEntry
+  {
+    LogType Type;
+    std::string Text;
+    size_t NumberOfLines;
+  };
+
+  struct VisibleLog
+  {
+    std::uint64_t Id;          // Id of the log, see LogsAdded
+    std::uint64_t LinesBefore; // Number of lines of the visible logs before this one
+  };
+
+  // Fixed capacity ring buffer, the oldest log is overwritten when it is full
+  std::vector<LogEntry> Logs;
+  size_t LogsStart = 0; // Index of the oldest log in Logs
+  size_t MaxNumberOfLogs = 10000;
+  std::uint64_t LogsAdded = 0; // Total number of logs added, each log id is its rank
+
+  // Logs passing the filter, updated incrementally when logs are added
+  std::deque<VisibleLog> VisibleLogs;
+  std::uint64_t VisibleLines = 0;
+  ImGuiTextFilter Filter;
+  bool ShowFilter = false;
+  bool FocusFilter = false;
+
   std::array<char, 256> CurrentInput = {};
   bool NewError = false;
   bool NewWarning = false;
-  std::pair<size_t, size_t> Completions{ 0,
-    0 }; // Index for start and length of completions in Logs
+  std::vector<std::string> Completions; // Displayed after the logs
   std::function<std::vector<std::string>(const std::string& pattern)>
     GetCommandsMatchCallback; // Callback to get the list of commands matching pattern
   std::vector<std::string> CommandHistory;
   std::pair<std::string, int> LastInput; // Last input before navigating history
   int CommandHistoryIndexInv = -1;       // Current inverted index in command history navigation
 
+  /**
+   * Number of lines ImGui uses to display the text
+   */
+  static size_t CountLines(const std::string& text)
+  {
+    const size_t nbLines = std::count(text.begin(), text.end(), '\n');
+    return text.empty() || text.back() != '\n' ? nbLines + 1 : nbLines;
+  }
+
+  /**
+   * Get the index/log with the provided id, it must still be in the ring buffer
+   */
+  size_t GetLogIndex(std::uint64_t id) const
+  {
+    const std::uint64_t firstId = this->LogsAdded - this->Logs.size();
+    return (this->LogsStart + static_cast<size_t>(id - firstId)) % this->Logs.size();
+  }
+  const LogEntry& GetLog(std::uint64_t id) const
+  {
+    return this->Logs[this->GetLogIndex(id)];
+  }
+
+  /**
+   * Add a log, overwriting the oldest one if the ring buffer is full
+   */
+  void AddLog(LogType type, const std::string& text)
+  {
+    if (this->Logs.size() < this->MaxNumberOfLogs)
+    {
+      this->Logs.push_back({ type, text, CountLines(text) });
+    }
+    else
+    {
+      // reuse the string storage of the oldest log
+      LogEntry& entry = this->Logs[this->LogsStart];
+      entry.Type = type;
+      entry.Text.assign(text);
+      entry.NumberOfLines = CountLines(text);
+      this->LogsStart = (this->LogsStart + 1) % this->Logs.size();
+    }
+    this->LogsAdded++;
+
+    const std::uint64_t firstId = this->LogsAdded - this->Logs.size();
+    while (!this->VisibleLogs.empty() && this->VisibleLogs.front().Id < firstId)
+    {
+      this->VisibleLogs.pop_front();
+    }
+
+    const LogEntry& added = this->GetLog(this->LogsAdded - 1);
+    if (this->Filter.PassFilter(added.Text.c_str()))
+    {
+      this->VisibleLogs.push_back({ this->LogsAdded - 1, this->VisibleLines });
+      this->VisibleLines += added.NumberOfLines;
+    }
+  }
+
+  /**
+   * Recompute the visible logs from scratch, required when the filter changes
+   */
+  void UpdateVisibleLogs()
+  {
+    this->VisibleLogs.clear();
+    this->VisibleLines = 0;
+    const std::uint64_t firstId = this->LogsAdded - this->Logs.size();
+    for (std::uint64_t id = firstId; id < this->LogsAdded; id++)
+    {
+      const LogEntry& entry = this->GetLog(id);
+      if (this->Filter.PassFilter(entry.Text.c_str()))
+      {
+        this->VisibleLogs.push_back({ id, this->VisibleLines });
+        this->VisibleLines += entry.NumberOfLines;
+      }
+    }
+  }
+
+  /**
+   * Change the capacity of the ring buffer, keeping the most recent logs
+   */
+  void SetMaxNumberOfLogs(size_t max)
+  {
+    max = std::max<size_t>(max, 1);
+    if (max == this->MaxNumberOfLogs)
+    {
+      return;
+    }
+
+    const size_t kept = std::min(this->Logs.size(), max);
+    std::vector<LogEntry> logs;
+    logs.reserve(kept);
+    for (std::uint64_t id = this->LogsAdded - kept; id < this->LogsAdded; id++)
+    {
+      logs.push_back(std::move(this->Logs[this->GetLogIndex(id)]));
+    }
+    this->Logs = std::move(logs);
+    this->LogsStart = 0;
+    this->MaxNumberOfLogs = max;
+    this->UpdateVisibleLogs();
+  }
+
   /**
    * Clear completions from the logs
    */
   void ClearCompletions()
   {
-    if (this->Completions.second > 0)
+    this->Completions.clear();
+  }
+
+  /**
+   * Display a log with the color matching its type
+   */
+  void RenderLog(LogType type, const std::string& text, bool useColoring)
+  {
+    bool hasColor = useColoring;
+    if (useColoring)
+    {
+      switch (type)
+      {
+        case LogType::Error:
+          ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetErrorColor());
+          break;
+        case LogType::Warning:
+          ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetWarningColor());
+          break;
+        case LogType::Typed:
+          ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetHighlightColor());
+          break;
+        case LogType::Completion:
+          ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetCompletionColor());
+          break;
+        default:
+          hasColor = false;
+      }
+    }
+
+    ImGui::TextUnformatted(text.c_str());
+    if (hasColor)
+    {
+      ImGui::PopStyleColor();
+    }
+  }
+
+  /**
+   * Display the visible logs, only the ones inside the scrolled region are submitted to ImGui
+   */
+  void RenderVisibleLogs(bool useColoring)
+  {
+    const size_t nbRows = this->VisibleLogs.size();
+    if (nbRows == 0)
     {
-      this->Logs.erase(this->Logs.begin() + this->Completions.first,
-        this->Logs.begin() + this->Completions.second);
-      this->Completions.second = 0;
+      return;
+    }
+
+    // Position of a row relative to the first one, all rows are submitted as separated items
+    const float lineHeight = ImGui::GetTextLineHeight();
+    const float spacing = ImGui::GetStyle().ItemSpacing.y;
+    const std::uint64_t firstLines = this->VisibleLogs.front().LinesBefore;
+    auto rowOffset = [&](size_t row)
+    {
+      const std::uint64_t lines =
+        (row < nbRows ? this->VisibleLogs[row].LinesBefore : this->VisibleLines) - firstLines;
+      return static_cast<float>(lines) * lineHeight + static_cast<float>(row) * spacing;
+    };
+
+    // Index of the row displayed at the provided offset
+    auto findRow = [&](float offset)
+    {
+      size_t low = 0;
+      size_t high = nbRows;
+      while (low < high)
+      {
+        const size_t mid = low + (high - low) / 2;
+        if (rowOffset(mid + 1) <= offset)
+        {
+          low = mid + 1;
+        }
+        else
+        {
+          high = mid;
+        }
+      }
+      return low;
+    };
+
+    const float top = ImGui::GetScrollY() - ImGui::GetCursorPosY();
+    const size_t first = findRow(top);
+    const size_t last = std::min(nbRows, findRow(top + ImGui::GetWindowHeight()) + 1);
+
+    if (first > 0)
+    {
+      ImGui::Dummy(ImVec2(0.f, rowOffset(first) - spacing));
+    }
+    for (size_t row = first; row < last; row++)
+    {
+      const LogEntry& entry = this->GetLog(this->VisibleLogs[row].Id);
+      this->RenderLog(entry.Type, entry.Text, useColoring);
+    }
+    if (last < nbRows)
+    {
+      ImGui::Dummy(ImVec2(0.f, rowOffset(nbRows) - rowOffset(last) - spacing));
     }
   }
+
   /**
    * Callback to process text editing events in console
    */
@@ -110,14 +327,10 @@ struct vtkF3DImguiConsole::Internals
               data->CursorPos, candidates[0].c_str(), candidates[0].c_str() + matchLen);
           }
 
-          this->Completions.first = this->Logs.size();
-          this->Completions.second = this->Logs.size() + candidates.size() + 1;
-          // Add all candidates to the logs
-          this->Logs.emplace_back(
-            std::make_pair(Internals::LogType::Completion, "Possible matches:"));
-          std::transform(candidates.begin(), candidates.end(), std::back_inserter(this->Logs),
-            [](const std::string& candidate)
-            { return std::make_pair(Internals::LogType::Completion, candidate); });
+          // Add all candidates to the completions
+          this->Completions.emplace_back("Possible matches:");
+          std::copy(
+            candidates.begin(), candidates.end(), std::back_inserter(this->Completions));
         }
         break;
       }
@@ -183,22 +396,27 @@ vtkF3DImguiConsole::~vtkF3DImguiConsole() = default;
 //----------------------------------------------------------------------------
 void vtkF3DImguiConsole::DisplayText(const char* text)
 {
+  if (this->DeferMessage(vtkOutputWindow::MESSAGE_TYPE_TEXT, text))
+  {
+    return;
+  }
+
   MessageTypes type = this->GetCurrentMessageType();
   if (this->GetDisplayStream(type) != StreamType::Null)
   {
     switch (type)
     {
       case vtkOutputWindow::MESSAGE_TYPE_ERROR:
-        this->Pimpl->Logs.emplace_back(std::make_pair(Internals::LogType::Error, text));
+        this->Pimpl->AddLog(Internals::LogType::Error, text);
         this->Pimpl->NewError = true;
         break;
       case vtkOutputWindow::MESSAGE_TYPE_WARNING:
       case vtkOutputWindow::MESSAGE_TYPE_GENERIC_WARNING:
-        this->Pimpl->Logs.emplace_back(std::make_pair(Internals::LogType::Warning, text));
+        this->Pimpl->AddLog(Internals::LogType::Warning, text);
         this->Pimpl->NewWarning = true;
         break;
       default:
-        this->Pimpl->Logs.emplace_back(std::make_pair(Internals::LogType::Log, text));
+        this->Pimpl->AddLog(Internals::LogType::Log, text);
     }
   }
 
@@ -254,6 +472,12 @@ void vtkF3DImguiConsole::ShowConsole(bool minimal)
   {
     this->Pimpl->CommandHistoryIndexInv = -1; // Reset history navigation on hiding
     this->Pimpl->ClearCompletions();          // Clear completion on hiding
+    if (this->Pimpl->ShowFilter)
+    {
+      this->Pimpl->ShowFilter = false; // Reset the filter on hiding
+      this->Pimpl->Filter.Clear();
+      this->Pimpl->UpdateVisibleLogs();
+    }
     this->InvokeEvent(vtkF3DImguiConsole::HideEvent);
   }
 
@@ -262,46 +486,49 @@ void vtkF3DImguiConsole::ShowConsole(bool minimal)
   // Log window, will only show if not in minimal mode
   if (!minimal)
   {
+    // Ctrl+F toggles the filter of the logs
+    if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_F))
+    {
+      this->Pimpl->ShowFilter = !this->Pimpl->ShowFilter;
+      this->Pimpl->FocusFilter = this->Pimpl->ShowFilter;
+      if (!this->Pimpl->ShowFilter)
+      {
+        this->Pimpl->Filter.Clear();
+        this->Pimpl->UpdateVisibleLogs();
+      }
+    }
+
+    if (this->Pimpl->ShowFilter)
+    {
+      ImGui::Text("Filter:");
+      ImGui::SameLine();
+      ImGui::PushItemWidth(-1);
+      if (this->Pimpl->FocusFilter)
+      {
+        ImGui::SetKeyboardFocusHere();
+      }
+      if (ImGui::InputTextWithHint("##ConsoleFilter", "include,-exclude",
+            this->Pimpl->Filter.InputBuf, sizeof(this->Pimpl->Filter.InputBuf),
+            ImGuiInputTextFlags_EscapeClearsAll))
+      {
+        // Only rebuild the visible logs when the filter changes
+        this->Pimpl->Filter.Build();
+        this->Pimpl->UpdateVisibleLogs();
+      }
+      ImGui::PopItemWidth();
+    }
+
     const float reservedHeight =
       ImGui::GetStyle().ItemSpacing.y + ImGui::GetFrameHeightWithSpacing();
     if (ImGui::BeginChild(
           "LogRegion", ImVec2(0, -reservedHeight), 0, ImGuiWindowFlags_HorizontalScrollbar))
     {
       ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4, 1)); // Tighten spacing
-      for (const auto& [severity, msg] : this->Pimpl->Logs)
+      this->Pimpl->RenderVisibleLogs(this->GetUseColoring());
+      for (const std::string& completion : this->Pimpl->Completions)
       {
-        bool hasColor = true;
-
-        if (this->GetUseColoring())
-        {
-          switch (severity)
-          {
-            case Internals::LogType::Error:
-              ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetErrorColor());
-              break;
-            case Internals::LogType::Warning:
-              ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetWarningColor());
-              break;
-            case Internals::LogType::Typed:
-              ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetHighlightColor());
-              break;
-            case Internals::LogType::Completion:
-              ImGui::PushStyleColor(ImGuiCol_Text, F3DImguiStyle::GetCompletionColor());
-              break;
-            default:
-              hasColor = false;
-          }
-        }
-        else
-        {
-          hasColor = false;
-        }
-
-        ImGui::TextUnformatted(msg.c_str());
-        if (hasColor)
-        {
-          ImGui::PopStyleColor();
-        }
+        this->Pimpl->RenderLog(
+          Internals::LogType::Completion, completion, this->GetUseColoring());
       }
 
       if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
@@ -340,16 +567,17 @@ void vtkF3DImguiConsole::ShowConsole(bool minimal)
   ImGui::SetItemDefaultFocus();
 
   // if always forcing the focus, it prevents grabbing the scrollbar
-  if (!ImGui::IsAnyItemActive())
+  if (!ImGui::IsAnyItemActive() && !this->Pimpl->FocusFilter)
   {
     ImGui::SetKeyboardFocusHere(-1);
   }
+  this->Pimpl->FocusFilter = false;
 
   // do not run the command if nothing is in the input text
   if (runCommand && this->Pimpl->CurrentInput[0] != 0)
   {
-    this->Pimpl->Logs.emplace_back(std::make_pair(
-      Internals::LogType::Typed, std::string("> ") + this->Pimpl->CurrentInput.data()));
+    this->Pimpl->AddLog(
+      Internals::LogType::Typed, std::string("> ") + this->Pimpl->CurrentInput.data());
     this->InvokeEvent(vtkF3DImguiConsole::TriggerEvent, this->Pimpl->CurrentInput.data());
     this->Pimpl->CommandHistory.emplace_back(this->Pimpl->CurrentInput.data());
     this->Pimpl->CommandHistoryIndexInv = -1; // Reset history navigation, looks natural
@@ -415,10 +643,25 @@ void vtkF3DImguiConsole::ShowBadge()
 void vtkF3DImguiConsole::Clear()
 {
   this->Pimpl->Logs.clear();
+  this->Pimpl->LogsStart = 0;
+  this->Pimpl->VisibleLogs.clear();
+  this->Pimpl->VisibleLines = 0;
   this->Pimpl->NewError = false;
   this->Pimpl->NewWarning = false;
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DImguiConsole::SetMaxNumberOfLogs(size_t max)
+{
+  this->Pimpl->SetMaxNumberOfLogs(max);
+}
+
+//----------------------------------------------------------------------------
+size_t vtkF3DImguiConsole::GetNumberOfLogs() const
+{
+  return this->Pimpl->Logs.size();
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DImguiConsole::SetCommandsMatchCallback(
   std::function<std::vector<std::string>(const std::string& pattern)> callback)
@@ -8,6 +8,8 @@
  * It is also adding an input widget where commands registered in libf3d can be executed.
  * Finally, a small icon is displayed on the top right corner when the console is hidden but a new
  * warning or error is logged.
+ * Logs are stored in a ring buffer of fixed capacity and only the visible ones are rendered.
+ * They can be filtered using Ctrl+F.
  */
 
 #ifndef vtkF3DImguiConsole_h
@@ -49,6 +51,17 @@ public:
    */
   void Clear();
 
+  /**
+   * Set the maximum number of logs kept by the console, the oldest logs are removed first.
+   * Default is 10000, minimum is 1.
+   */
+  void SetMaxNumberOfLogs(size_t max);
+
+  /**
+   * Get the number of logs currently kept by the console
+   */
+  size_t GetNumberOfLogs() const;
+
   /**
    * Set the callback to get the list of commands matching pattern
    */
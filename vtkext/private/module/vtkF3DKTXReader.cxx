@@ -0,0 +1,227 @@
+#include "vtkF3DKTXReader.h"
+
+#include "vtkImageData.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtksys/FStream.hxx"
+
+#include <ktx.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+/**
+ * Vulkan formats that can be read without conversion, see vkformat_enum.h
+ */
+enum VkFormat : ktx_uint32_t
+{
+  R8_UNORM = 9,
+  R8_SRGB = 15,
+  R8G8_UNORM = 16,
+  R8G8_SRGB = 22,
+  R8G8B8_UNORM = 23,
+  R8G8B8_SRGB = 29,
+  R8G8B8A8_UNORM = 37,
+  R8G8B8A8_SRGB = 43
+};
+
+struct TextureDeleter
+{
+  void operator()(ktxTexture2* texture) const
+  {
+    ktxTexture2_Destroy(texture);
+  }
+};
+using TexturePtr = std::unique_ptr<ktxTexture2, TextureDeleter>;
+
+//------------------------------------------------------------------------------
+/**
+ * Number of 8-bit components of a texture, 0 if the format is not supported.
+ * Textures needing transcoding are always transcoded to RGBA.
+ */
+int GetNumberOfComponents(ktxTexture2* texture)
+{
+  if (ktxTexture2_NeedsTranscoding(texture))
+  {
+    return 4;
+  }
+
+  switch (texture->vkFormat)
+  {
+    case VkFormat::R8_UNORM:
+    case VkFormat::R8_SRGB:
+      return 1;
+    case VkFormat::R8G8_UNORM:
+    case VkFormat::R8G8_SRGB:
+      return 2;
+    case VkFormat::R8G8B8_UNORM:
+    case VkFormat::R8G8B8_SRGB:
+      return 3;
+    case VkFormat::R8G8B8A8_UNORM:
+    case VkFormat::R8G8B8A8_SRGB:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Create the texture from the file or the memory buffer, nullptr on failure
+ */
+TexturePtr CreateTexture(vtkObject* self, const char* fileName, const void* buffer,
+  vtkIdType bufferLength, ktxTextureCreateFlags flags)
+{
+  ktxTexture2* texture = nullptr;
+  KTX_error_code result = buffer
+    ? ktxTexture2_CreateFromMemory(static_cast<const ktx_uint8_t*>(buffer),
+        static_cast<ktx_size_t>(bufferLength), flags, &texture)
+    : ktxTexture2_CreateFromNamedFile(fileName, flags, &texture);
+  if (result != KTX_SUCCESS)
+  {
+    vtkErrorWithObjectMacro(self, "Error reading KTX2 file: " << ktxErrorString(result));
+    return nullptr;
+  }
+  return TexturePtr(texture);
+}
+}
+
+vtkStandardNewMacro(vtkF3DKTXReader);
+
+//------------------------------------------------------------------------------
+vtkF3DKTXReader::vtkF3DKTXReader() = default;
+
+//------------------------------------------------------------------------------
+vtkF3DKTXReader::~vtkF3DKTXReader() = default;
+
+//------------------------------------------------------------------------------
+void vtkF3DKTXReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DKTXReader::ExecuteInformation()
+{
+  // XXX: Needed because of VTK initialize file pattern in the constructor for some reasons
+  delete[] this->FilePattern;
+  this->FilePattern = nullptr;
+
+  // Setup filename to read the header
+  this->ComputeInternalFileName(this->DataExtent[4]);
+  if ((this->InternalFileName == nullptr || this->InternalFileName[0] == '\0') &&
+    !this->MemoryBuffer)
+  {
+    return;
+  }
+
+  // Only the header is read here, image data is loaded in ExecuteDataWithInformation
+  ::TexturePtr texture = ::CreateTexture(this, this->InternalFileName, this->MemoryBuffer,
+    this->MemoryBufferLength, KTX_TEXTURE_CREATE_NO_FLAGS);
+  if (!texture)
+  {
+    return;
+  }
+
+  int nbComponents = ::GetNumberOfComponents(texture.get());
+  if (nbComponents == 0)
+  {
+    vtkErrorMacro("Unsupported KTX2 texture format: " << texture->vkFormat);
+    return;
+  }
+
+  this->DataExtent[0] = 0;
+  this->DataExtent[1] = static_cast<int>(texture->baseWidth) - 1;
+  this->DataExtent[2] = 0;
+  this->DataExtent[3] = static_cast<int>(texture->baseHeight) - 1;
+
+  this->SetNumberOfScalarComponents(nbComponents);
+  this->SetDataScalarTypeToUnsignedChar();
+
+  this->vtkImageReader::ExecuteInformation();
+}
+
+//------------------------------------------------------------------------------
+int vtkF3DKTXReader::CanReadFile(const char* fname)
+{
+  vtksys::ifstream ifs(fname, vtksys::ifstream::in | vtksys::ifstream::binary);
+
+  if (ifs.fail())
+  {
+    vtkErrorMacro(<< "Could not open file " << fname);
+    return 0;
+  }
+
+  // The file must begin with the KTX2 identifier «KTX 20»\r\n\x1A\n
+  constexpr std::array<unsigned char, 12> identifier = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30,
+    0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+  std::array<char, 12> header;
+  ifs.read(header.data(), header.size());
+  return ifs.gcount() == static_cast<std::streamsize>(header.size()) &&
+    std::memcmp(header.data(), identifier.data(), identifier.size()) == 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkF3DKTXReader::ExecuteDataWithInformation(vtkDataObject* output, vtkInformation* outInfo)
+{
+  vtkImageData* data = this->AllocateOutputData(output, outInfo);
+
+  if (this->UpdateExtentIsEmpty(outInfo, output))
+  {
+    return;
+  }
+
+  vtkUnsignedCharArray* scalars =
+    vtkUnsignedCharArray::SafeDownCast(data->GetPointData()->GetScalars());
+  if (!scalars)
+  {
+    vtkErrorMacro(<< "Could not find expected scalar array");
+    return;
+  }
+  scalars->SetName("Pixels");
+
+  ::TexturePtr texture = ::CreateTexture(this, this->InternalFileName, this->MemoryBuffer,
+    this->MemoryBufferLength, KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT);
+  if (!texture)
+  {
+    return;
+  }
+
+  if (ktxTexture2_NeedsTranscoding(texture.get()))
+  {
+    KTX_error_code result = ktxTexture2_TranscodeBasis(texture.get(), KTX_TTF_RGBA32, 0);
+    if (result != KTX_SUCCESS)
+    {
+      vtkErrorMacro("Error transcoding KTX2 texture: " << ktxErrorString(result));
+      return;
+    }
+  }
+
+  const int nbComponents = ::GetNumberOfComponents(texture.get());
+  const int width = data->GetDimensions()[0];
+  const int height = data->GetDimensions()[1];
+  if (nbComponents != scalars->GetNumberOfComponents() ||
+    width != static_cast<int>(texture->baseWidth) ||
+    height != static_cast<int>(texture->baseHeight))
+  {
+    vtkErrorMacro(<< "KTX2 texture does not match its header");
+    return;
+  }
+
+  ktx_size_t offset = 0;
+  ktxTexture_GetImageOffset(ktxTexture(texture.get()), 0, 0, 0, &offset);
+  const ktx_uint8_t* source = ktxTexture_GetData(ktxTexture(texture.get())) + offset;
+
+  // KTX2 images are stored top to bottom while VTK expects the origin at the bottom left
+  const size_t rowSize = static_cast<size_t>(width) * nbComponents;
+  unsigned char* dataPtr = scalars->GetPointer(0);
+  for (int y = 0; y < height; y++)
+  {
+    std::copy_n(source + (height - 1 - y) * rowSize, rowSize, dataPtr + y * rowSize);
+  }
+}
@@ -0,0 +1,58 @@
+/**
+ * @class   vtkF3DKTXReader
+ * @brief   Reader for KTX2 textures, including Basis Universal supercompressed ones
+ *
+ * Basis Universal textures (ETC1S and UASTC) are transcoded to RGBA using libktx.
+ * Uncompressed 8-bit UNORM and SRGB formats are read as is.
+ * Only the base level of the mip chain is read.
+ *
+ * Textures are never uploaded as block-compressed (BCn, ETC2, ASTC) data, as vtkTexture
+ * only accepts uncompressed images and generates its own mipmaps.
+ */
+
+#ifndef vtkF3DKTXReader_h
+#define vtkF3DKTXReader_h
+
+#include "vtkImageReader.h"
+
+class vtkF3DKTXReader : public vtkImageReader
+{
+public:
+  static vtkF3DKTXReader* New();
+  vtkTypeMacro(vtkF3DKTXReader, vtkImageReader);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return 1 if the reader is compatible with the given file
+   */
+  int CanReadFile(const char* fname) override;
+
+  /**
+   * List of extensions supported by this reader
+   */
+  const char* GetFileExtensions() override
+  {
+    return ".ktx2";
+  }
+
+  /**
+   * Descriptive name of the reader
+   */
+  const char* GetDescriptiveName() override
+  {
+    return "Khronos Texture 2";
+  }
+
+protected:
+  vtkF3DKTXReader();
+  ~vtkF3DKTXReader() override;
+
+  void ExecuteInformation() override;
+  void ExecuteDataWithInformation(vtkDataObject* out, vtkInformation* outInfo) override;
+
+private:
+  vtkF3DKTXReader(const vtkF3DKTXReader&) = delete;
+  void operator=(const vtkF3DKTXReader&) = delete;
+};
+
+#endif
@@ -6,22 +6,123 @@
 #include <vtkActorCollection.h>
 #include <vtkCallbackCommand.h>
 #include <vtkCamera.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkImageData.h>
+#include <vtkLightCollection.h>
 #include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkProperty.h>
 #include <vtkRenderWindow.h>
 #include <vtkRendererCollection.h>
 #include <vtkSmartPointer.h>
+#include <vtkTexture.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <numeric>
+#include <unordered_set>
 #include <vector>
 
+namespace
+{
+//----------------------------------------------------------------------------
+void CollectTextureImages(vtkActor* actor, std::unordered_set<vtkImageData*>& images)
+{
+  auto addTexture = [&](vtkTexture* texture)
+  {
+    vtkImageData* image = texture ? vtkImageData::SafeDownCast(texture->GetInput()) : nullptr;
+    if (image)
+    {
+      images.insert(image);
+    }
+  };
+
+  addTexture(actor->GetTexture());
+  for (const auto& [name, texture] : actor->GetProperty()->GetAllTextures())
+  {
+    addTexture(texture);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Memory in KiB of the arrays of a dataset that are not counted yet,
+// as the outputs of an importer often share their arrays
+unsigned long GetUncountedMemorySize(vtkDataSet* dataset, std::unordered_set<vtkObject*>& counted)
+{
+  unsigned long size = 0;
+  auto add = [&](auto* object)
+  {
+    if (object && counted.insert(object).second)
+    {
+      size += object->GetActualMemorySize();
+    }
+  };
+
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataset);
+  if (pointSet && pointSet->GetPoints())
+  {
+    add(pointSet->GetPoints()->GetData());
+  }
+
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataset);
+  if (polyData)
+  {
+    add(polyData->GetVerts());
+    add(polyData->GetLines());
+    add(polyData->GetPolys());
+    add(polyData->GetStrips());
+  }
+
+  vtkFieldData* fields[] = { dataset->GetPointData(), dataset->GetCellData(),
+    dataset->GetFieldData() };
+  for (vtkFieldData* fieldData : fields)
+  {
+    for (int i = 0; fieldData && i < fieldData->GetNumberOfArrays(); i++)
+    {
+      add(fieldData->GetAbstractArray(i));
+    }
+  }
+  return size;
+}
+}
+
 //----------------------------------------------------------------------------
 struct vtkF3DMetaImporter::Internals
 {
+  /**
+   * Memory used by an importer in KiB.
+   * Geometry and Textures are the imported data, Surfaces, PointSprites and Volume estimate
+   * the copies made on the GPU by the mappers of the coloring, point sprites and volume
+   * structures. Only one of the imported and coloring actors of a surface is visible,
+   * so a single copy of each surface is counted.
+   */
+  struct MemoryUsage
+  {
+    unsigned long Geometry = 0;
+    unsigned long Textures = 0;
+    unsigned long Surfaces = 0;
+    unsigned long PointSprites = 0;
+    unsigned long Volume = 0;
+
+    /**
+     * Memory required to render the imported data, which cannot be skipped
+     */
+    unsigned long GetRequired() const
+    {
+      return this->Geometry + this->Textures + this->Surfaces;
+    }
+
+    unsigned long GetTotal() const
+    {
+      return this->GetRequired() + this->PointSprites + this->Volume;
+    }
+  };
+
   // Actors related vectors
   std::vector<vtkF3DMetaImporter::ColoringStruct> ColoringActorsAndMappers;
   std::vector<vtkF3DMetaImporter::PointSpritesStruct> PointSpritesActorsAndMappers;
@@ -31,6 +132,7 @@ struct vtkF3DMetaImporter::Internals
   {
     vtkSmartPointer<vtkImporter> Importer;
     bool Updated = false;
+    MemoryUsage Memory;
   };
   std::vector<ImporterPair> Importers;
   std::optional<vtkIdType> CameraIndex;
@@ -43,6 +145,109 @@ struct vtkF3DMetaImporter::Internals
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20240707)
   std::map<vtkImporter*, vtkSmartPointer<vtkActorCollection>> ActorsForImporterMap;
 #endif
+
+  /**
+   * Compute the memory used by the imported actors of an importer,
+   * the point sprites use the imported points of a generic importer and its image is the volume
+   */
+  static MemoryUsage ComputeMemoryUsage(
+    vtkActorCollection* actorCollection, vtkF3DGenericImporter* genericImporter)
+  {
+    MemoryUsage memory;
+    std::unordered_set<vtkObject*> counted;
+    std::unordered_set<vtkObject*> renderedSurfaces;
+    std::unordered_set<vtkImageData*> textureImages;
+
+    vtkCollectionSimpleIterator ait;
+    actorCollection->InitTraversal(ait);
+    while (auto* actor = actorCollection->GetNextActor(ait))
+    {
+      ::CollectTextureImages(actor, textureImages);
+
+      // Actors with other mappers, such as the glyph mappers of instancers,
+      // have no coloring nor point sprites structures
+      vtkMapper* mapper = actor->GetMapper();
+      vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(mapper);
+      vtkPolyData* surface = pdMapper ? pdMapper->GetInput() : nullptr;
+      if (!surface)
+      {
+        vtkDataSet* dataset =
+          mapper ? vtkDataSet::SafeDownCast(mapper->GetInputDataObject(0, 0)) : nullptr;
+        if (dataset)
+        {
+          memory.Geometry += ::GetUncountedMemorySize(dataset, counted);
+        }
+        continue;
+      }
+      memory.Geometry += ::GetUncountedMemorySize(surface, counted);
+      memory.Surfaces += ::GetUncountedMemorySize(surface, renderedSurfaces);
+
+      vtkPolyData* points = genericImporter ? genericImporter->GetImportedPoints() : surface;
+      if (points && points->GetPoints())
+      {
+        memory.PointSprites += points->GetPoints()->GetData()->GetActualMemorySize();
+      }
+    }
+
+    if (genericImporter)
+    {
+      vtkPolyData* points = genericImporter->GetImportedPoints();
+      if (points)
+      {
+        memory.Geometry += ::GetUncountedMemorySize(points, counted);
+      }
+      vtkImageData* image = genericImporter->GetImportedImage();
+      if (image)
+      {
+        memory.Geometry += ::GetUncountedMemorySize(image, counted);
+        memory.Volume += image->GetActualMemorySize();
+      }
+    }
+
+    for (vtkImageData* image : textureImages)
+    {
+      memory.Textures += ::GetUncountedMemorySize(image, counted);
+    }
+    return memory;
+  }
+
+  /**
+   * Get the memory used by all the importers that have been updated
+   */
+  unsigned long GetUsedMemory() const
+  {
+    return std::accumulate(this->Importers.begin(), this->Importers.end(), 0UL,
+      [](unsigned long memory, const ImporterPair& importerPair)
+      { return memory + (importerPair.Updated ? importerPair.Memory.GetTotal() : 0UL); });
+  }
+
+  /**
+   * Forward the progress of the importer as a progress of the meta importer
+   */
+  void ObserveProgress(vtkF3DMetaImporter* self, vtkImporter* importer)
+  {
+    vtkNew<vtkCallbackCommand> progressCallback;
+    progressCallback->SetClientData(self);
+    progressCallback->SetCallback(
+      [](vtkObject* const caller, unsigned long, void* clientData, void* callData)
+      {
+        vtkF3DMetaImporter* metaImporter = static_cast<vtkF3DMetaImporter*>(clientData);
+        double progress = *static_cast<double*>(callData);
+        double actualProgress = 0.0;
+        const auto& importers = metaImporter->Pimpl->Importers;
+        for (size_t i = 0; i < importers.size(); i++)
+        {
+          if (importers[i].Importer == caller)
+          {
+            // XXX: This does not consider that some importer may already have been updated
+            // or that some importers may take much longer than other.
+            actualProgress = (i + progress) / importers.size();
+          }
+        }
+        metaImporter->InvokeEvent(vtkCommand::ProgressEvent, &actualProgress);
+      });
+    importer->AddObserver(vtkCommand::ProgressEvent, progressCallback);
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -81,28 +286,122 @@ void vtkF3DMetaImporter::AddImporter(const vtkSmartPointer<vtkImporter>& importe
   this->Pimpl->Importers.emplace_back(
     vtkF3DMetaImporter::Internals::ImporterPair{ importer, false });
   this->Modified();
+  this->Pimpl->ObserveProgress(this, importer);
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::ReplaceImporter(
+  vtkImporter* importer, const vtkSmartPointer<vtkImporter>& newImporter)
+{
+  auto it = std::find_if(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
+    [&](const auto& importerPair) { return importerPair.Importer == importer; });
+  if (it == this->Pimpl->Importers.end())
+  {
+    return false;
+  }
+
+  if (it->Updated && this->Renderer)
+  {
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
+    vtkActorCollection* actorCollection = importer->GetImportedActors();
+
+    vtkCollectionSimpleIterator lit;
+    vtkLightCollection* lightCollection = importer->GetImportedLights();
+    lightCollection->InitTraversal(lit);
+    while (auto* light = lightCollection->GetNextLight(lit))
+    {
+      this->Renderer->RemoveLight(light);
+    }
+#else
+    vtkActorCollection* actorCollection = this->Pimpl->ActorsForImporterMap.at(importer).Get();
+#endif
+
+    // Remove the imported actors and everything created from them
+    std::unordered_set<vtkActor*> removedActors;
+    vtkCollectionSimpleIterator ait;
+    actorCollection->InitTraversal(ait);
+    while (auto* actor = actorCollection->GetNextActor(ait))
+    {
+      removedActors.insert(actor);
+      this->ActorCollection->RemoveItem(actor);
+      this->Renderer->RemoveActor(actor);
+    }
 
-  // Add a progress event observer
-  vtkNew<vtkCallbackCommand> progressCallback;
-  progressCallback->SetClientData(this);
-  progressCallback->SetCallback(
-    [](vtkObject* const caller, unsigned long, void* clientData, void* callData)
+    // Structs are only move constructible, rebuild the vectors with the structs to keep
+    std::vector<vtkF3DMetaImporter::ColoringStruct> coloringActorsAndMappers;
+    for (auto& cs : this->Pimpl->ColoringActorsAndMappers)
     {
-      vtkF3DMetaImporter* self = static_cast<vtkF3DMetaImporter*>(clientData);
-      double progress = *static_cast<double*>(callData);
-      double actualProgress = 0.0;
-      for (size_t i = 0; i < self->Pimpl->Importers.size(); i++)
+      if (removedActors.count(cs.OriginalActor) > 0)
+      {
+        this->Renderer->RemoveActor(cs.Actor);
+      }
+      else
+      {
+        coloringActorsAndMappers.emplace_back(std::move(cs));
+      }
+    }
+    this->Pimpl->ColoringActorsAndMappers = std::move(coloringActorsAndMappers);
+
+    std::vector<vtkF3DMetaImporter::PointSpritesStruct> pointSpritesActorsAndMappers;
+    for (auto& pss : this->Pimpl->PointSpritesActorsAndMappers)
+    {
+      if (pss.Importer == importer)
+      {
+        this->Renderer->RemoveActor(pss.Actor);
+      }
+      else
       {
-        if (self->Pimpl->Importers[i].Importer == caller)
+        pointSpritesActorsAndMappers.emplace_back(std::move(pss));
+      }
+    }
+    this->Pimpl->PointSpritesActorsAndMappers = std::move(pointSpritesActorsAndMappers);
+
+    vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
+    vtkImageData* image = genericImporter ? genericImporter->GetImportedImage() : nullptr;
+    if (image)
+    {
+      std::vector<vtkF3DMetaImporter::VolumeStruct> volumePropsAndMappers;
+      for (auto& vs : this->Pimpl->VolumePropsAndMappers)
+      {
+        if (vs.Mapper->GetInput() == image)
         {
-          // XXX: This does not consider that some importer may already have been updated
-          // or that some importers may take much longer than other.
-          actualProgress = (i + progress) / self->Pimpl->Importers.size();
+          this->Renderer->RemoveVolume(vs.Prop);
+        }
+        else
+        {
+          volumePropsAndMappers.emplace_back(std::move(vs));
         }
       }
-      self->InvokeEvent(vtkCommand::ProgressEvent, &actualProgress);
-    });
-  importer->AddObserver(vtkCommand::ProgressEvent, progressCallback);
+      this->Pimpl->VolumePropsAndMappers = std::move(volumePropsAndMappers);
+    }
+
+    // Bounding box and coloring info are recomputed from the remaining actors
+    this->Pimpl->GeometryBoundingBox.Reset();
+    this->ActorCollection->InitTraversal(ait);
+    while (auto* actor = this->ActorCollection->GetNextActor(ait))
+    {
+      // Not all actors have a polydata mapper, see Update
+      if (actor->GetMapper())
+      {
+        double bounds[6];
+        actor->GetMapper()->GetBounds(bounds);
+        this->Pimpl->GeometryBoundingBox.AddBounds(bounds);
+      }
+    }
+    this->Pimpl->ColoringInfoHandler.ClearColoringInfo();
+
+#if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20240707)
+    this->Pimpl->ActorsForImporterMap.erase(importer);
+#endif
+  }
+
+  importer->RemoveObservers(vtkCommand::ProgressEvent);
+  it->Importer = newImporter;
+  it->Updated = false;
+  it->Memory = Internals::MemoryUsage();
+  this->Modified();
+  this->Pimpl->ObserveProgress(this, newImporter);
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -225,6 +524,36 @@ bool vtkF3DMetaImporter::Update()
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
     vtkActorCollection* actorCollection = importer->GetImportedActors();
 #endif
+
+    // Recover generic importer if any
+    vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
+
+    // Check the memory limit before creating the structures, they are skipped if needed
+    Internals::MemoryUsage& memory = importerPair.Memory;
+    memory = Internals::ComputeMemoryUsage(actorCollection, genericImporter);
+    bool createStructs = true;
+    if (this->MemoryLimit > 0)
+    {
+      unsigned long usedMemory = this->Pimpl->GetUsedMemory();
+      if (usedMemory + memory.GetRequired() > this->MemoryLimit)
+      {
+        F3DLog::Print(F3DLog::Severity::Error,
+          "Imported data requires " + std::to_string(usedMemory + memory.GetRequired()) +
+            " KiB, more than the memory limit of " + std::to_string(this->MemoryLimit) +
+            " KiB");
+        return false;
+      }
+      if (usedMemory + memory.GetTotal() > this->MemoryLimit)
+      {
+        F3DLog::Print(F3DLog::Severity::Warning,
+          "Point sprites and volume are disabled for a file to stay under the memory limit of " +
+            std::to_string(this->MemoryLimit) + " KiB");
+        memory.PointSprites = 0;
+        memory.Volume = 0;
+        createStructs = false;
+      }
+    }
+
     vtkCollectionSimpleIterator ait;
     actorCollection->InitTraversal(ait);
     while (auto* actor = actorCollection->GetNextActor(ait))
@@ -232,17 +561,24 @@ bool vtkF3DMetaImporter::Update()
       // Add to the actor collection
       this->ActorCollection->AddItem(actor);
 
-      vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
-      vtkPolyData* surface = pdMapper->GetInput();
-
       // Increase bounding box size if needed
       double bounds[6];
+      vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+      if (!pdMapper)
+      {
+        // Other mappers, such as the glyph mappers of instancers, are rendered as is,
+        // without coloring nor point sprites
+        if (actor->GetMapper())
+        {
+          actor->GetMapper()->GetBounds(bounds);
+          this->Pimpl->GeometryBoundingBox.AddBounds(bounds);
+        }
+        continue;
+      }
+      vtkPolyData* surface = pdMapper->GetInput();
       surface->GetBounds(bounds);
       this->Pimpl->GeometryBoundingBox.AddBounds(bounds);
 
-      // Recover generic importer if any
-      vtkF3DGenericImporter* genericImporter = vtkF3DGenericImporter::SafeDownCast(importer);
-
       // Create and configure coloring actors
       this->Pimpl->ColoringActorsAndMappers.emplace_back(vtkF3DMetaImporter::ColoringStruct(actor));
       vtkF3DMetaImporter::ColoringStruct& cs = this->Pimpl->ColoringActorsAndMappers.back();
@@ -250,6 +586,11 @@ bool vtkF3DMetaImporter::Update()
       this->Renderer->AddActor(cs.Actor);
       cs.Actor->VisibilityOff();
 
+      if (!createStructs)
+      {
+        continue;
+      }
+
       // Create and configure point sprites actors
       this->Pimpl->PointSpritesActorsAndMappers.emplace_back(
         vtkF3DMetaImporter::PointSpritesStruct(actor, importer));
@@ -263,6 +604,7 @@ bool vtkF3DMetaImporter::Update()
         // TODO when supporting composite, handle with an actor based index
         points = genericImporter->GetImportedPoints();
       }
+      pss.Points = points;
       pss.Mapper->SetInputData(points);
       this->Renderer->AddActor(pss.Actor);
       pss.Actor->VisibilityOff();
@@ -308,6 +650,22 @@ std::string vtkF3DMetaImporter::GetOutputsDescription()
   description += std::accumulate(this->Pimpl->Importers.begin(), this->Pimpl->Importers.end(),
     std::string(), [](const std::string& a, const auto& importerPair)
     { return a + "----------\n" + importerPair.Importer->GetOutputsDescription(); });
+
+  if (!description.empty() && description.back() != '\n')
+  {
+    description += "\n";
+  }
+  description += "----------\nMemory usage:\n";
+  for (size_t i = 0; i < this->Pimpl->Importers.size(); i++)
+  {
+    const Internals::MemoryUsage& memory = this->Pimpl->Importers[i].Memory;
+    description += "File " + std::to_string(i + 1) + ": geometry " +
+      std::to_string(memory.Geometry) + " KiB, textures " + std::to_string(memory.Textures) +
+      " KiB, surfaces " + std::to_string(memory.Surfaces) + " KiB, point sprites " +
+      std::to_string(memory.PointSprites) + " KiB, volume " + std::to_string(memory.Volume) +
+      " KiB\n";
+  }
+  description += "Total: " + std::to_string(this->Pimpl->GetUsedMemory()) + " KiB\n";
   return description;
 }
 
@@ -556,8 +914,11 @@ bool vtkF3DMetaImporter::UpdateAtTimeValue(double timeValue)
   // Update coloring and point sprites
   for (auto& cs : this->Pimpl->ColoringActorsAndMappers)
   {
-    cs.Mapper->SetInputData(
-      vtkPolyDataMapper::SafeDownCast(cs.OriginalActor->GetMapper())->GetInput());
+    vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(cs.OriginalActor->GetMapper());
+    if (pdMapper)
+    {
+      cs.Mapper->SetInputData(pdMapper->GetInput());
+    }
 
     bool visi = cs.Actor->GetVisibility();
     cs.Actor->vtkProp3D::ShallowCopy(cs.OriginalActor);
@@ -565,10 +926,11 @@ bool vtkF3DMetaImporter::UpdateAtTimeValue(double timeValue)
   }
   for (auto& pss : this->Pimpl->PointSpritesActorsAndMappers)
   {
-    if (!vtkF3DGenericImporter::SafeDownCast(pss.Importer))
+    vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(pss.OriginalActor->GetMapper());
+    if (pdMapper && !vtkF3DGenericImporter::SafeDownCast(pss.Importer))
     {
-      pss.Mapper->SetInputData(
-        vtkPolyDataMapper::SafeDownCast(pss.OriginalActor->GetMapper())->GetInput());
+      pss.Points = pdMapper->GetInput();
+      pss.Mapper->SetInputData(pss.Points);
       bool visi = pss.Actor->GetVisibility();
       pss.Actor->vtkProp3D::ShallowCopy(pss.OriginalActor);
       pss.Actor->SetVisibility(visi);
@@ -597,7 +959,11 @@ void vtkF3DMetaImporter::UpdateInfoForColoring()
       while (auto* actor = actorCollection->GetNextActor(ait))
       {
         vtkPolyDataMapper* pdMapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
-        assert(pdMapper);
+        if (!pdMapper)
+        {
+          // Actors without a coloring struct cannot be colored
+          continue;
+        }
 
         // Update coloring vectors, with a dedicated logic for generic importer
         vtkDataSet* datasetForColoring = pdMapper->GetInput();
@@ -641,13 +1007,24 @@ std::string vtkF3DMetaImporter::GetMetaDataDescription() const
 
   vtkIdType nPoints = 0;
   vtkIdType nCells = 0;
+  std::unordered_set<vtkImageData*> textureImages;
+
   vtkCollectionSimpleIterator ait;
   this->ActorCollection->InitTraversal(ait);
   while (auto* actor = this->ActorCollection->GetNextActor(ait))
   {
-    vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
-    nPoints += surface->GetNumberOfPoints();
-    nCells += surface->GetNumberOfCells();
+    // Mappers are not always polydata mappers, eg: glyph mappers of instanced geometries
+    vtkMapper* mapper = actor->GetMapper();
+    vtkDataSet* dataSet =
+      mapper ? vtkDataSet::SafeDownCast(mapper->GetInputDataObject(0, 0)) : nullptr;
+    if (dataSet)
+    {
+      nPoints += dataSet->GetNumberOfPoints();
+      nCells += dataSet->GetNumberOfCells();
+    }
+
+    // textures are often shared between actors, count them once
+    ::CollectTextureImages(actor, textureImages);
   }
 
   description += "Number of points: ";
@@ -655,6 +1032,21 @@ std::string vtkF3DMetaImporter::GetMetaDataDescription() const
   description += "\n";
   description += "Number of cells: ";
   description += std::to_string(nCells);
+
+  if (!textureImages.empty())
+  {
+    unsigned long textureMemory = std::accumulate(textureImages.begin(), textureImages.end(),
+      0UL, [](unsigned long memory, vtkImageData* image)
+      { return memory + image->GetActualMemorySize(); });
+
+    description += "\n";
+    description += "Number of textures: ";
+    description += std::to_string(textureImages.size());
+    description += "\n";
+    description += "Texture memory: ";
+    description += std::to_string(textureMemory);
+    description += " KiB";
+  }
   return description;
 }
 
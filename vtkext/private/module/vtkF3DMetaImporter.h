@@ -8,6 +8,7 @@
 
 #include "F3DColoringInfoHandler.h"
 #include "vtkF3DImporter.h"
+#include "vtkF3DPointCloudOctree.h"
 
 #include <vtkActor.h>
 #include <vtkBoundingBox.h>
@@ -59,8 +60,12 @@ public:
 
     vtkNew<vtkActor> Actor;
     vtkNew<vtkPointGaussianMapper> Mapper;
+    vtkNew<vtkF3DPointCloudOctree> Octree;
     vtkActor* OriginalActor;
     vtkImporter* Importer;
+
+    // the points to render, the mapper may render the points streamed by the octree instead
+    vtkPolyData* Points = nullptr;
   };
 
   struct ColoringStruct
@@ -93,6 +98,14 @@ public:
    */
   void AddImporter(const vtkSmartPointer<vtkImporter>& importer);
 
+  /**
+   * Replace an importer by a new one, keeping its position among the other importers.
+   * Actors, lights and props created for the replaced importer are removed from the renderer
+   * and the new importer will be imported on next Update, without updating the other importers.
+   * Return false if the importer was not added to this meta importer.
+   */
+  bool ReplaceImporter(vtkImporter* importer, const vtkSmartPointer<vtkImporter>& newImporter);
+
   /**
    * Get the bounding box of all geometry actors
    * Should be called after actors have been imported
@@ -104,6 +117,18 @@ public:
    */
   std::string GetMetaDataDescription() const;
 
+  ///@{
+  /**
+   * Set/Get the maximum memory in KiB used by the imported data and by the coloring,
+   * point sprites and volume structures created from it.
+   * When importing a file would exceed it, the point sprites and volume structures of the file
+   * are not created, and if the imported data and its surfaces alone exceed it, Update fails.
+   * 0 means unlimited, which is the default.
+   */
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+  ///@}
+
   F3DColoringInfoHandler& GetColoringInfoHandler();
 
   ///@{
@@ -126,7 +151,8 @@ public:
   bool Update();
 
   /**
-   * Concatenate individual importers output description into one and return it
+   * Concatenate individual importers output description into one and return it,
+   * followed by the memory used by each importer
    */
   std::string GetOutputsDescription() override;
 
@@ -185,6 +211,8 @@ private:
    */
   void UpdateInfoForColoring();
 
+  unsigned long MemoryLimit = 0;
+
   struct Internals;
   std::unique_ptr<Internals> Pimpl;
 
@@ -52,6 +52,7 @@ void vtkF3DOverlayRenderPass::ReleaseGraphicsResources(vtkWindow* w)
   if (this->QuadHelper)
   {
     this->QuadHelper->ReleaseGraphicsResources(w);
+    this->QuadHelper = nullptr;
   }
   if (this->OverlayPass)
   {
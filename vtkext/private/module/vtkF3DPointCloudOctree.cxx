@@ -0,0 +1,856 @@
+#include "vtkF3DPointCloudOctree.h"
+
+#include "F3DLog.h"
+
+#include <vtkCamera.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRenderer.h>
+#include <vtkTable.h>
+#include <vtkVariant.h>
+#include <vtkXMLPolyDataReader.h>
+#include <vtkXMLPolyDataWriter.h>
+#include <vtkXMLTableReader.h>
+#include <vtkXMLTableWriter.h>
+#include <vtksys/MD5.h>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+// deeper nodes only happen with duplicated points, keep them in the last level
+constexpr int MaximumDepth = 16;
+
+// number of nodes read from the disk per update during camera motion
+constexpr int MaximumLoadsPerInteractiveUpdate = 4;
+
+// number of points hashed to identify a point cloud
+constexpr vtkIdType NumberOfHashedPoints = 4096;
+
+struct Node
+{
+  std::array<double, 6> Bounds;
+  std::array<vtkIdType, 8> Children;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType MemorySize = 0;
+  double Spacing = 0.0;
+};
+
+//----------------------------------------------------------------------------
+std::string GetNodePath(const std::string& directory, vtkIdType id)
+{
+  return directory + "/node" + std::to_string(id) + ".vtp";
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Copy the given points of the input with all their point data in a node file.
+ * Set memorySize to the size in bytes of the node once loaded.
+ */
+bool WriteNode(vtkPolyData* input, const std::vector<vtkIdType>& ids, const std::string& path,
+  vtkIdType& memorySize)
+{
+  vtkIdType nbPoints = static_cast<vtkIdType>(ids.size());
+
+  vtkNew<vtkIdList> srcIds;
+  srcIds->SetNumberOfIds(nbPoints);
+  std::copy(ids.begin(), ids.end(), srcIds->begin());
+  vtkNew<vtkIdList> dstIds;
+  dstIds->SetNumberOfIds(nbPoints);
+  std::iota(dstIds->begin(), dstIds->end(), 0);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(nbPoints);
+  points->InsertPoints(dstIds, srcIds, input->GetPoints());
+
+  vtkNew<vtkPolyData> node;
+  node->SetPoints(points);
+  node->GetPointData()->CopyAllocate(input->GetPointData(), nbPoints);
+  node->GetPointData()->CopyData(input->GetPointData(), srcIds, dstIds);
+
+  memorySize = static_cast<vtkIdType>(node->GetActualMemorySize()) * 1024;
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetFileName(path.c_str());
+  writer->SetInputData(node);
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToLZ4();
+  return writer->Write() == 1;
+}
+
+//----------------------------------------------------------------------------
+struct BuildContext
+{
+  vtkPolyData* Input;
+  std::string Directory;
+  vtkIdType MaximumPointsPerNode;
+  int GridResolution;
+  const std::atomic<bool>& Cancel;
+  std::vector<Node> Nodes;
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Subsample the given points of the input in a grid covering the node bounds, write the kept
+ * points in the node file and recursively build the children with the other points.
+ * ids is released as soon as possible to bound the memory used by the recursion.
+ * Return the index of the node, or -1 if a node could not be written or the build was canceled.
+ */
+vtkIdType BuildNode(BuildContext& context, std::vector<vtkIdType>& ids,
+  const std::array<double, 6>& bounds, int depth)
+{
+  if (context.Cancel)
+  {
+    return -1;
+  }
+
+  vtkIdType index = static_cast<vtkIdType>(context.Nodes.size());
+  context.Nodes.emplace_back();
+
+  Node node;
+  node.Bounds = bounds;
+  node.Children.fill(-1);
+  double size = bounds[1] - bounds[0];
+  int resolution = context.GridResolution;
+  node.Spacing = size / resolution;
+
+  std::vector<vtkIdType> kept;
+  std::array<std::vector<vtkIdType>, 8> children;
+  if (static_cast<vtkIdType>(ids.size()) <= context.MaximumPointsPerNode ||
+    depth >= ::MaximumDepth || size <= 0.0)
+  {
+    kept.swap(ids);
+  }
+  else
+  {
+    // keep the first point of each grid cell, the order of the input is preserved
+    const double center[3] = { 0.5 * (bounds[0] + bounds[1]), 0.5 * (bounds[2] + bounds[3]),
+      0.5 * (bounds[4] + bounds[5]) };
+    std::unordered_set<std::uint64_t> cells;
+    cells.reserve(static_cast<size_t>(context.MaximumPointsPerNode));
+    vtkDataArray* coords = context.Input->GetPoints()->GetData();
+    for (vtkIdType id : ids)
+    {
+      double p[3];
+      coords->GetTuple(id, p);
+      if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2]))
+      {
+        // invalid points cannot be rendered, drop them
+        continue;
+      }
+
+      std::uint64_t key = 0;
+      for (int c = 0; c < 3; c++)
+      {
+        int cell = static_cast<int>((p[c] - bounds[2 * c]) / node.Spacing);
+        key = key * resolution + std::clamp(cell, 0, resolution - 1);
+      }
+
+      if (cells.insert(key).second)
+      {
+        kept.emplace_back(id);
+      }
+      else
+      {
+        int octant = (p[0] >= center[0] ? 1 : 0) | (p[1] >= center[1] ? 2 : 0) |
+          (p[2] >= center[2] ? 4 : 0);
+        children[octant].emplace_back(id);
+      }
+    }
+    ids.clear();
+    ids.shrink_to_fit();
+  }
+
+  node.NumberOfPoints = static_cast<vtkIdType>(kept.size());
+  if (!::WriteNode(context.Input, kept, ::GetNodePath(context.Directory, index), node.MemorySize))
+  {
+    return -1;
+  }
+  kept = std::vector<vtkIdType>();
+
+  for (int octant = 0; octant < 8; octant++)
+  {
+    if (children[octant].empty())
+    {
+      continue;
+    }
+
+    std::array<double, 6> childBounds;
+    for (int c = 0; c < 3; c++)
+    {
+      double middle = 0.5 * (bounds[2 * c] + bounds[2 * c + 1]);
+      bool upper = (octant >> c) & 1;
+      childBounds[2 * c] = upper ? middle : bounds[2 * c];
+      childBounds[2 * c + 1] = upper ? bounds[2 * c + 1] : middle;
+    }
+
+    vtkIdType child = ::BuildNode(context, children[octant], childBounds, depth + 1);
+    if (child < 0)
+    {
+      return -1;
+    }
+    node.Children[octant] = child;
+  }
+
+  context.Nodes[index] = node;
+  return index;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Build the nodes and index files of the input in the given directory.
+ */
+bool BuildOctree(vtkPolyData* input, const std::string& directory, vtkIdType maximumPointsPerNode,
+  int gridResolution, const std::atomic<bool>& cancel)
+{
+  // nodes are cubes so that the grid cells are cubes too
+  double inputBounds[6];
+  input->GetPoints()->GetBounds(inputBounds);
+  double size = std::max({ inputBounds[1] - inputBounds[0], inputBounds[3] - inputBounds[2],
+    inputBounds[5] - inputBounds[4] });
+  size *= 1.0 + 1e-6;
+  std::array<double, 6> bounds;
+  for (int c = 0; c < 3; c++)
+  {
+    double center = 0.5 * (inputBounds[2 * c] + inputBounds[2 * c + 1]);
+    bounds[2 * c] = center - 0.5 * size;
+    bounds[2 * c + 1] = center + 0.5 * size;
+  }
+
+  ::BuildContext context{ input, directory, maximumPointsPerNode, gridResolution, cancel, {} };
+  std::vector<vtkIdType> ids(static_cast<size_t>(input->GetNumberOfPoints()));
+  std::iota(ids.begin(), ids.end(), 0);
+  if (::BuildNode(context, ids, bounds, 0) < 0)
+  {
+    return false;
+  }
+
+  vtkIdType nbNodes = static_cast<vtkIdType>(context.Nodes.size());
+  vtkNew<vtkDoubleArray> boundsArray;
+  boundsArray->SetName("Bounds");
+  boundsArray->SetNumberOfComponents(6);
+  boundsArray->SetNumberOfTuples(nbNodes);
+  vtkNew<vtkIdTypeArray> childrenArray;
+  childrenArray->SetName("Children");
+  childrenArray->SetNumberOfComponents(8);
+  childrenArray->SetNumberOfTuples(nbNodes);
+  vtkNew<vtkIdTypeArray> nbPointsArray;
+  nbPointsArray->SetName("NumberOfPoints");
+  nbPointsArray->SetNumberOfTuples(nbNodes);
+  vtkNew<vtkIdTypeArray> memorySizeArray;
+  memorySizeArray->SetName("MemorySize");
+  memorySizeArray->SetNumberOfTuples(nbNodes);
+  vtkNew<vtkDoubleArray> spacingArray;
+  spacingArray->SetName("Spacing");
+  spacingArray->SetNumberOfTuples(nbNodes);
+
+  for (vtkIdType i = 0; i < nbNodes; i++)
+  {
+    const Node& node = context.Nodes[i];
+    std::copy(node.Bounds.begin(), node.Bounds.end(), boundsArray->GetPointer(6 * i));
+    std::copy(node.Children.begin(), node.Children.end(), childrenArray->GetPointer(8 * i));
+    nbPointsArray->SetValue(i, node.NumberOfPoints);
+    memorySizeArray->SetValue(i, node.MemorySize);
+    spacingArray->SetValue(i, node.Spacing);
+  }
+
+  vtkNew<vtkTable> index;
+  index->AddColumn(boundsArray);
+  index->AddColumn(childrenArray);
+  index->AddColumn(nbPointsArray);
+  index->AddColumn(memorySizeArray);
+  index->AddColumn(spacingArray);
+
+  vtkNew<vtkXMLTableWriter> writer;
+  std::string indexPath = directory + "/index.vtt";
+  writer->SetFileName(indexPath.c_str());
+  writer->SetInputData(index);
+  return writer->Write() == 1;
+}
+
+//----------------------------------------------------------------------------
+void AppendToHash(vtksysMD5* md5, const void* data, size_t size)
+{
+  vtksysMD5_Append(md5, reinterpret_cast<const unsigned char*>(data), static_cast<int>(size));
+}
+}
+
+//----------------------------------------------------------------------------
+struct vtkF3DPointCloudOctree::Internals
+{
+  /**
+   * Cancel the running build if any and wait for it to stop.
+   * The build checks the cancel flag before each node so waiting for it is short.
+   */
+  void CancelJob()
+  {
+    if (this->Cancel)
+    {
+      *this->Cancel = true;
+      this->Cancel.reset();
+    }
+    if (this->Job.valid())
+    {
+      this->Job.wait();
+      this->Job = {};
+    }
+  }
+
+  struct CachedNode
+  {
+    vtkSmartPointer<vtkPolyData> Points;
+    std::uint64_t LastUse = 0;
+  };
+
+  /**
+   * Return the node points, reading them from the disk if they are not cached.
+   * Return nullptr if the node file cannot be read.
+   */
+  vtkPolyData* LoadNode(vtkIdType id)
+  {
+    auto it = this->Cache.find(id);
+    if (it != this->Cache.end())
+    {
+      it->second.LastUse = this->UpdateCount;
+      return it->second.Points;
+    }
+
+    vtkNew<vtkXMLPolyDataReader> reader;
+    std::string path = ::GetNodePath(this->Directory, id);
+    reader->SetFileName(path.c_str());
+    reader->Update();
+    vtkPolyData* points = reader->GetOutput();
+    if (points->GetNumberOfPoints() != this->Nodes[id].NumberOfPoints)
+    {
+      F3DLog::Print(F3DLog::Severity::Warning, "Cannot read point cloud octree node " + path);
+      return nullptr;
+    }
+
+    this->Cache[id] = { points, this->UpdateCount };
+    this->CacheSize += this->Nodes[id].MemorySize;
+    return points;
+  }
+
+  /**
+   * Release the least recently used nodes that are not selected until the cache fits the budget.
+   */
+  void Evict(vtkIdType budget)
+  {
+    if (this->CacheSize <= budget)
+    {
+      return;
+    }
+
+    std::vector<std::pair<std::uint64_t, vtkIdType>> candidates;
+    for (const auto& [id, cached] : this->Cache)
+    {
+      if (cached.LastUse != this->UpdateCount)
+      {
+        candidates.emplace_back(cached.LastUse, id);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& candidate : candidates)
+    {
+      if (this->CacheSize <= budget)
+      {
+        break;
+      }
+      this->Cache.erase(candidate.second);
+      this->CacheSize -= this->Nodes[candidate.second].MemorySize;
+    }
+  }
+
+  /**
+   * Concatenate the points of the selected nodes in the output.
+   */
+  void UpdateOutput()
+  {
+    vtkIdType nbPoints = 0;
+    for (vtkIdType id : this->Selection)
+    {
+      nbPoints += this->Cache[id].Points->GetNumberOfPoints();
+    }
+
+    if (nbPoints == 0)
+    {
+      this->Output->Initialize();
+      return;
+    }
+
+    vtkPolyData* first = this->Cache[this->Selection[0]].Points;
+    vtkNew<vtkPoints> points;
+    points->SetDataType(first->GetPoints()->GetDataType());
+    points->SetNumberOfPoints(nbPoints);
+
+    vtkNew<vtkPolyData> output;
+    output->SetPoints(points);
+    vtkPointData* outputPD = output->GetPointData();
+    outputPD->CopyAllocate(first->GetPointData(), nbPoints);
+
+    vtkIdType offset = 0;
+    for (vtkIdType id : this->Selection)
+    {
+      vtkPolyData* node = this->Cache[id].Points;
+      vtkIdType nbNodePoints = node->GetNumberOfPoints();
+      points->InsertPoints(offset, nbNodePoints, 0, node->GetPoints());
+      outputPD->CopyData(node->GetPointData(), offset, nbNodePoints, 0);
+      offset += nbNodePoints;
+    }
+
+    this->Output->ShallowCopy(output);
+  }
+
+  vtkSmartPointer<vtkPolyData> Input;
+  vtkMTimeType InputTime = 0;
+  std::string CacheDirectory;
+
+  std::string Directory;
+  std::vector<Node> Nodes;
+
+  std::unordered_map<vtkIdType, CachedNode> Cache;
+  vtkIdType CacheSize = 0;
+  std::uint64_t UpdateCount = 0;
+
+  std::vector<vtkIdType> Selection;
+  vtkNew<vtkPolyData> Output;
+
+  std::future<void> Job;
+  std::shared_ptr<std::atomic<bool>> Cancel;
+  std::string BuildDirectory;
+};
+
+vtkStandardNewMacro(vtkF3DPointCloudOctree);
+
+//----------------------------------------------------------------------------
+vtkF3DPointCloudOctree::vtkF3DPointCloudOctree()
+  : Pimpl(new Internals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkF3DPointCloudOctree::~vtkF3DPointCloudOctree()
+{
+  this->Pimpl->CancelJob();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DPointCloudOctree::Initialize(vtkPolyData* input, const std::string& cacheDirectory)
+{
+  Internals& internals = *this->Pimpl;
+  internals.CancelJob();
+  internals.Input = input;
+  internals.InputTime = input ? input->GetMTime() : 0;
+  internals.CacheDirectory = cacheDirectory;
+  internals.Directory.clear();
+  internals.Nodes.clear();
+  internals.Cache.clear();
+  internals.CacheSize = 0;
+  internals.Selection.clear();
+  internals.Output->Initialize();
+
+  if (!input || !input->GetPoints() || input->GetNumberOfPoints() == 0 || cacheDirectory.empty())
+  {
+    return false;
+  }
+
+  std::string directory = cacheDirectory + "/" + this->ComputeKey(input);
+  if (this->Load(directory))
+  {
+    F3DLog::Print(F3DLog::Severity::Debug, "Point cloud octree loaded from " + directory);
+    return true;
+  }
+
+  // build in a temporary directory renamed once complete,
+  // so that an interrupted build is never loaded
+  std::string tmpDirectory = directory + "." + std::to_string(std::random_device()()) + ".tmp";
+  if (!vtksys::SystemTools::MakeDirectory(tmpDirectory))
+  {
+    F3DLog::Print(
+      F3DLog::Severity::Warning, "Cannot create point cloud octree directory " + tmpDirectory);
+    return false;
+  }
+
+  F3DLog::Print(F3DLog::Severity::Debug,
+    "Building octree of " + std::to_string(input->GetNumberOfPoints()) + " points in " +
+      directory);
+
+  // build from a deep copy, the input keeps being rendered while the job runs
+  vtkSmartPointer<vtkPolyData> snapshot = vtkSmartPointer<vtkPolyData>::New();
+  snapshot->DeepCopy(input);
+
+  internals.BuildDirectory = directory;
+  internals.Cancel = std::make_shared<std::atomic<bool>>(false);
+  internals.Job = std::async(std::launch::async,
+    [snapshot, tmpDirectory, directory, maximumPointsPerNode = this->MaximumPointsPerNode,
+      gridResolution = this->GridResolution, cancel = internals.Cancel]()
+    {
+      F3DLog::SetDeferMessages(true);
+      bool built =
+        ::BuildOctree(snapshot, tmpDirectory, maximumPointsPerNode, gridResolution, *cancel);
+      if (!built || !vtksys::SystemTools::RenameFile(tmpDirectory, directory))
+      {
+        // another process may have built the same octree meanwhile
+        vtksys::SystemTools::RemoveADirectory(tmpDirectory);
+      }
+    });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DPointCloudOctree::IsReady()
+{
+  Internals& internals = *this->Pimpl;
+
+  // rebuild the octree if the point cloud changed
+  if (internals.Input && internals.Input->GetMTime() != internals.InputTime)
+  {
+    vtkSmartPointer<vtkPolyData> input = internals.Input;
+    std::string cacheDirectory = internals.CacheDirectory;
+    this->Initialize(input, cacheDirectory);
+  }
+
+  if (internals.Job.valid() &&
+    internals.Job.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+  {
+    internals.Job.get();
+    internals.Cancel.reset();
+    F3DLog::FlushDeferredMessages();
+
+    if (this->Load(internals.BuildDirectory))
+    {
+      F3DLog::Print(
+        F3DLog::Severity::Debug, "Point cloud octree built in " + internals.BuildDirectory);
+    }
+    else
+    {
+      F3DLog::Print(F3DLog::Severity::Warning,
+        "Cannot build point cloud octree in " + internals.BuildDirectory);
+    }
+  }
+
+  return !internals.Nodes.empty();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DPointCloudOctree::IsBuilding() const
+{
+  return this->Pimpl->Job.valid();
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData* vtkF3DPointCloudOctree::GetInput()
+{
+  return this->Pimpl->Input;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkF3DPointCloudOctree::GetNumberOfNodes() const
+{
+  return static_cast<vtkIdType>(this->Pimpl->Nodes.size());
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DPointCloudOctree::Load(const std::string& directory)
+{
+  std::string indexPath = directory + "/index.vtt";
+  if (!vtksys::SystemTools::FileExists(indexPath, true))
+  {
+    return false;
+  }
+
+  vtkNew<vtkXMLTableReader> reader;
+  reader->SetFileName(indexPath.c_str());
+  reader->Update();
+  vtkTable* index = reader->GetOutput();
+
+  vtkDataArray* boundsArray = vtkDataArray::SafeDownCast(index->GetColumnByName("Bounds"));
+  vtkDataArray* childrenArray =
+    vtkDataArray::SafeDownCast(index->GetColumnByName("Children"));
+  vtkDataArray* nbPointsArray =
+    vtkDataArray::SafeDownCast(index->GetColumnByName("NumberOfPoints"));
+  vtkDataArray* memorySizeArray =
+    vtkDataArray::SafeDownCast(index->GetColumnByName("MemorySize"));
+  vtkDataArray* spacingArray = vtkDataArray::SafeDownCast(index->GetColumnByName("Spacing"));
+  if (!boundsArray || !childrenArray || !nbPointsArray || !memorySizeArray || !spacingArray ||
+    boundsArray->GetNumberOfComponents() != 6 || childrenArray->GetNumberOfComponents() != 8 ||
+    index->GetNumberOfRows() == 0)
+  {
+    return false;
+  }
+
+  vtkIdType nbNodes = index->GetNumberOfRows();
+  std::vector<::Node> nodes(static_cast<size_t>(nbNodes));
+  for (vtkIdType i = 0; i < nbNodes; i++)
+  {
+    ::Node& node = nodes[i];
+    boundsArray->GetTuple(i, node.Bounds.data());
+    for (int c = 0; c < 8; c++)
+    {
+      node.Children[c] = static_cast<vtkIdType>(childrenArray->GetComponent(i, c));
+      if (node.Children[c] >= nbNodes)
+      {
+        return false;
+      }
+    }
+    node.NumberOfPoints = static_cast<vtkIdType>(nbPointsArray->GetComponent(i, 0));
+    node.MemorySize = static_cast<vtkIdType>(memorySizeArray->GetComponent(i, 0));
+    node.Spacing = spacingArray->GetComponent(i, 0);
+  }
+
+  this->Pimpl->Directory = directory;
+  this->Pimpl->Nodes = std::move(nodes);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData* vtkF3DPointCloudOctree::Update(
+  vtkRenderer* ren, vtkMatrix4x4* matrix, vtkIdType budget, bool interactive)
+{
+  Internals& internals = *this->Pimpl;
+  if (internals.Nodes.empty())
+  {
+    return internals.Output;
+  }
+  internals.UpdateCount++;
+
+  vtkCamera* camera = ren->GetActiveCamera();
+  double planes[24];
+  camera->GetFrustumPlanes(ren->GetTiledAspectRatio(), planes);
+  double position[3];
+  camera->GetPosition(position);
+
+  // number of pixels covered by a world unit, at a unit distance for perspective projection
+  int* size = ren->GetSize();
+  double pixelsPerUnit;
+  if (camera->GetParallelProjection())
+  {
+    pixelsPerUnit = size[1] / (2.0 * camera->GetParallelScale());
+  }
+  else
+  {
+    double viewSize = camera->GetUseHorizontalViewAngle() ? size[0] : size[1];
+    pixelsPerUnit =
+      viewSize / (2.0 * std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0));
+  }
+
+  // largest scaling of the actor matrix, applied to the node spacing
+  double scale = 1.0;
+  if (matrix)
+  {
+    scale = 0.0;
+    for (int j = 0; j < 3; j++)
+    {
+      double column[3] = { matrix->GetElement(0, j), matrix->GetElement(1, j),
+        matrix->GetElement(2, j) };
+      scale = std::max(scale, vtkMath::Norm(column));
+    }
+  }
+
+  // compute the world bounds of a node and its projected point spacing in pixels,
+  // return a negative error if the node is outside the view frustum
+  auto computeError = [&](const ::Node& node)
+  {
+    double worldBounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+      VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (int corner = 0; corner < 8; corner++)
+    {
+      double p[4] = { node.Bounds[corner & 1], node.Bounds[2 + ((corner >> 1) & 1)],
+        node.Bounds[4 + ((corner >> 2) & 1)], 1.0 };
+      if (matrix)
+      {
+        matrix->MultiplyPoint(p, p);
+      }
+      for (int c = 0; c < 3; c++)
+      {
+        worldBounds[2 * c] = std::min(worldBounds[2 * c], p[c]);
+        worldBounds[2 * c + 1] = std::max(worldBounds[2 * c + 1], p[c]);
+      }
+    }
+
+    // the plane normals point inside the frustum, the near and far planes are ignored since
+    // the clipping range is computed from the bounds of the nodes selected by the previous update
+    for (int i = 0; i < 4; i++)
+    {
+      const double* plane = planes + 4 * i;
+      double farthest = plane[3];
+      for (int c = 0; c < 3; c++)
+      {
+        farthest += plane[c] * (plane[c] > 0 ? worldBounds[2 * c + 1] : worldBounds[2 * c]);
+      }
+      if (farthest < 0)
+      {
+        return -1.0;
+      }
+    }
+
+    double spacing = node.Spacing * scale * pixelsPerUnit;
+    if (camera->GetParallelProjection())
+    {
+      return spacing;
+    }
+
+    double distance2 = 0.0;
+    for (int c = 0; c < 3; c++)
+    {
+      double d =
+        std::max({ worldBounds[2 * c] - position[c], 0.0, position[c] - worldBounds[2 * c + 1] });
+      distance2 += d * d;
+    }
+    return distance2 > 0.0 ? spacing / std::sqrt(distance2) : std::numeric_limits<double>::max();
+  };
+
+  // refine the nodes with the largest error first until the budget is reached,
+  // the root node is always selected
+  std::vector<vtkIdType> selection;
+  vtkIdType used = 0;
+  int nbLoads = 0;
+
+  std::priority_queue<std::pair<double, vtkIdType>> candidates;
+  double rootError = computeError(internals.Nodes[0]);
+  if (rootError >= 0.0)
+  {
+    candidates.emplace(rootError, 0);
+  }
+
+  while (!candidates.empty())
+  {
+    auto [error, id] = candidates.top();
+    candidates.pop();
+
+    const ::Node& node = internals.Nodes[id];
+    if (id != 0 && used + node.MemorySize > budget)
+    {
+      continue;
+    }
+
+    if (internals.Cache.find(id) == internals.Cache.end())
+    {
+      if (interactive && nbLoads >= ::MaximumLoadsPerInteractiveUpdate)
+      {
+        continue;
+      }
+      nbLoads++;
+    }
+    if (!internals.LoadNode(id))
+    {
+      continue;
+    }
+
+    selection.emplace_back(id);
+    used += node.MemorySize;
+
+    // refine until the point spacing is smaller than a pixel
+    if (error > 1.0)
+    {
+      for (vtkIdType child : node.Children)
+      {
+        double childError = child >= 0 ? computeError(internals.Nodes[child]) : -1.0;
+        if (childError >= 0.0)
+        {
+          candidates.emplace(childError, child);
+        }
+      }
+    }
+  }
+
+  internals.Evict(budget);
+
+  std::sort(selection.begin(), selection.end());
+  if (selection != internals.Selection)
+  {
+    internals.Selection = std::move(selection);
+    internals.UpdateOutput();
+  }
+
+  return internals.Output;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DPointCloudOctree::ComputeKey(vtkPolyData* input) const
+{
+  unsigned char digest[16];
+  char md5Hash[33];
+  md5Hash[32] = '\0';
+
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+
+  // the build parameters change the content of the nodes
+  ::AppendToHash(md5, &this->MaximumPointsPerNode, sizeof(this->MaximumPointsPerNode));
+  ::AppendToHash(md5, &this->GridResolution, sizeof(this->GridResolution));
+
+  vtkIdType nbPoints = input->GetNumberOfPoints();
+  ::AppendToHash(md5, &nbPoints, sizeof(nbPoints));
+
+  vtkIdType step = std::max<vtkIdType>(1, nbPoints / ::NumberOfHashedPoints);
+  for (vtkIdType id = 0; id < nbPoints; id += step)
+  {
+    double p[3];
+    input->GetPoint(id, p);
+    ::AppendToHash(md5, p, sizeof(p));
+  }
+
+  // point data is stored in the nodes too, so the same subset of its values is hashed
+  std::vector<double> tuple;
+  vtkPointData* pd = input->GetPointData();
+  for (int i = 0; i < pd->GetNumberOfArrays(); i++)
+  {
+    vtkAbstractArray* array = pd->GetAbstractArray(i);
+    std::string name = array->GetName() ? array->GetName() : "";
+    int dataType = array->GetDataType();
+    int nbComponents = array->GetNumberOfComponents();
+    ::AppendToHash(md5, name.c_str(), name.size());
+    ::AppendToHash(md5, &dataType, sizeof(dataType));
+    ::AppendToHash(md5, &nbComponents, sizeof(nbComponents));
+
+    vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+    tuple.resize(static_cast<size_t>(nbComponents));
+    for (vtkIdType id = 0; id < array->GetNumberOfTuples(); id += step)
+    {
+      if (dataArray)
+      {
+        dataArray->GetTuple(id, tuple.data());
+        ::AppendToHash(md5, tuple.data(), tuple.size() * sizeof(double));
+      }
+      else
+      {
+        for (int c = 0; c < nbComponents; c++)
+        {
+          std::string value = array->GetVariantValue(id * nbComponents + c).ToString();
+          ::AppendToHash(md5, value.c_str(), value.size());
+        }
+      }
+    }
+  }
+
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+
+  return md5Hash;
+}
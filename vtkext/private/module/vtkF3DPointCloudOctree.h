@@ -0,0 +1,122 @@
+/**
+ * @class   vtkF3DPointCloudOctree
+ * @brief   On-disk octree used to stream large point clouds
+ *
+ * Hierarchical subsampling of a point cloud stored in a cache directory.
+ * Each node keeps at most one point per cell of a regular grid covering its bounds and hands
+ * the remaining points to its children, so that the points of a node and of all its ancestors
+ * form a subsampled version of the point cloud in the node bounds.
+ * Nodes are written as VTK XML polydata files with all the point data arrays of the input,
+ * and an index table describes the hierarchy.
+ * The octree is built in a background thread from a copy of the input, IsReady reports when it
+ * can be used.
+ *
+ * Update selects the nodes to render for a camera by decreasing screen-space error,
+ * loads them from the disk and keeps the loaded points under a memory budget.
+ *
+ * @sa
+ * vtkPointGaussianMapper
+ */
+
+#ifndef vtkF3DPointCloudOctree_h
+#define vtkF3DPointCloudOctree_h
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+#include <memory>
+#include <string>
+
+class vtkMatrix4x4;
+class vtkPolyData;
+class vtkRenderer;
+
+class vtkF3DPointCloudOctree : public vtkObject
+{
+public:
+  static vtkF3DPointCloudOctree* New();
+  vtkTypeMacro(vtkF3DPointCloudOctree, vtkObject);
+
+  /**
+   * Load the octree of the input from the cache directory if it exists,
+   * start building it in the cache directory in a background thread otherwise.
+   * The input is kept as a reference and can be recovered with GetInput.
+   * Return false if the octree could not be loaded nor its build started.
+   */
+  bool Initialize(vtkPolyData* input, const std::string& cacheDirectory);
+
+  /**
+   * Check if the octree can be used, loading it if its build just finished.
+   * The octree is built again if the input was modified since Initialize.
+   * Must be called from the main thread.
+   */
+  bool IsReady();
+
+  /**
+   * Return true while the octree is built in the background.
+   */
+  bool IsBuilding() const;
+
+  /**
+   * Get the point cloud the octree was initialized with.
+   */
+  vtkPolyData* GetInput();
+
+  /**
+   * Select the nodes to render with the camera of the renderer, load them if needed and
+   * return a point cloud containing the points of all selected nodes.
+   * The returned point cloud is empty if the octree is not ready.
+   * Nodes are refined until their point spacing projects below one pixel or until the memory
+   * used by the selected nodes would exceed the memory budget in bytes.
+   * When interactive is true, only a few nodes are loaded per update so that the camera motion
+   * is not blocked, the returned point cloud is refined on the next updates.
+   * The returned point cloud is only modified when the selection changes.
+   */
+  vtkPolyData* Update(vtkRenderer* ren, vtkMatrix4x4* matrix, vtkIdType budget, bool interactive);
+
+  /**
+   * Get the number of nodes in the octree.
+   */
+  vtkIdType GetNumberOfNodes() const;
+
+  ///@{
+  /**
+   * Set/Get the maximum number of points stored in a leaf node, and the resolution of the
+   * subsampling grid of the other nodes. Only used when building the octree.
+   * Default is 65536 points and a 128 cells grid.
+   */
+  vtkSetClampMacro(MaximumPointsPerNode, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(MaximumPointsPerNode, vtkIdType);
+  vtkSetClampMacro(GridResolution, int, 1, 1024);
+  vtkGetMacro(GridResolution, int);
+  ///@}
+
+  /**
+   * Compute a key identifying the point cloud and the build parameters,
+   * used to name its cache directory.
+   * Only a subset of the points and point data is hashed so that it stays cheap
+   * on large point clouds.
+   */
+  std::string ComputeKey(vtkPolyData* input) const;
+
+  vtkF3DPointCloudOctree(const vtkF3DPointCloudOctree&) = delete;
+  void operator=(const vtkF3DPointCloudOctree&) = delete;
+
+protected:
+  vtkF3DPointCloudOctree();
+  ~vtkF3DPointCloudOctree() override;
+
+private:
+  /**
+   * Read the index file of the given directory.
+   */
+  bool Load(const std::string& directory);
+
+  vtkIdType MaximumPointsPerNode = 65536;
+  int GridResolution = 128;
+
+  struct Internals;
+  std::unique_ptr<Internals> Pimpl;
+};
+
+#endif
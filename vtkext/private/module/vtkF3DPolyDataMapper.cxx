@@ -3,6 +3,9 @@
 #include "F3DLog.h"
 
 #include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkCellData.h>
 #include <vtkDoubleArray.h>
 #include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
@@ -13,16 +16,284 @@
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkProperty.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
 #include <vtkShaderProgram.h>
 #include <vtkShaderProperty.h>
 #include <vtkTexture.h>
 #include <vtkUniforms.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <initializer_list>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+struct TriangleHash
+{
+  size_t operator()(const std::array<vtkIdType, 3>& tri) const
+  {
+    std::hash<vtkIdType> hasher;
+    size_t seed = hasher(tri[0]);
+    seed ^= hasher(tri[1]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= hasher(tri[2]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * Vertex clustering of the input in a regular grid of the given cell size.
+ * Every input point is replaced by the first input point found in its grid cell,
+ * degenerated and duplicated triangles are removed. Point clouds are subsampled the same way.
+ * Abort and return nullptr if the output grows larger than maxSize, estimatedSize is set
+ * to the extrapolated output size in that case, and to the actual size otherwise.
+ * Only read-only accesses are done on the input, which must not be modified meanwhile.
+ */
+vtkSmartPointer<vtkPolyData> ClusterVertices(vtkPolyData* input, const double bounds[6],
+  double cellSize, vtkIdType maxSize, vtkIdType& estimatedSize, const std::atomic<bool>& cancel)
+{
+  constexpr uint64_t maxBin = (1 << 21) - 1;
+  auto binKey = [&](const double pt[3])
+  {
+    uint64_t key = 0;
+    for (int i = 0; i < 3; i++)
+    {
+      double bin = std::floor((pt[i] - bounds[2 * i]) / cellSize);
+      key = (key << 21) | std::min(static_cast<uint64_t>(std::max(bin, 0.0)), maxBin);
+    }
+    return key;
+  };
+
+  vtkPoints* inPoints = input->GetPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkIdType nbPoints = input->GetNumberOfPoints();
+
+  vtkNew<vtkPoints> outPoints;
+  outPoints->SetDataType(inPoints->GetDataType());
+  vtkNew<vtkPolyData> output;
+  output->SetPoints(outPoints);
+  output->GetPointData()->CopyAllocate(inPD);
+
+  // map every input point to its representative output point
+  std::vector<vtkIdType> pointMap(nbPoints);
+  std::unordered_map<uint64_t, vtkIdType> bins;
+  double pt[3];
+  for (vtkIdType i = 0; i < nbPoints; i++)
+  {
+    if (i % 100000 == 0 && cancel)
+    {
+      return nullptr;
+    }
+
+    inPoints->GetPoint(i, pt);
+    auto inserted = bins.emplace(binKey(pt), outPoints->GetNumberOfPoints());
+    if (inserted.second)
+    {
+      outPoints->InsertNextPoint(pt);
+      output->GetPointData()->CopyData(inPD, i, inserted.first->second);
+    }
+    pointMap[i] = inserted.first->second;
+  }
+
+  vtkIdType nbInputCells = input->GetNumberOfPolys() + input->GetNumberOfStrips();
+  if (nbInputCells == 0)
+  {
+    // point cloud, one vertex per representative point
+    vtkIdType nbOutPoints = outPoints->GetNumberOfPoints();
+    estimatedSize = nbOutPoints;
+    if (nbOutPoints > maxSize)
+    {
+      return nullptr;
+    }
+
+    vtkNew<vtkCellArray> verts;
+    verts->AllocateExact(nbOutPoints, nbOutPoints);
+    for (vtkIdType i = 0; i < nbOutPoints; i++)
+    {
+      verts->InsertNextCell(1, &i);
+    }
+    output->SetVerts(verts);
+    return output;
+  }
+
+  vtkNew<vtkCellArray> outPolys;
+  vtkCellData* inCD = input->GetCellData();
+  output->GetCellData()->CopyAllocate(inCD);
+  std::unordered_set<std::array<vtkIdType, 3>, ::TriangleHash> triangles;
+
+  vtkIdType processedCells = 0;
+  auto addTriangle = [&](vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType cellId)
+  {
+    std::array<vtkIdType, 3> tri = { pointMap[a], pointMap[b], pointMap[c] };
+    if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+    {
+      return;
+    }
+
+    // use a canonical order to detect duplicates while keeping the orientation
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+    if (triangles.insert(tri).second)
+    {
+      vtkIdType outId = outPolys->InsertNextCell(3, tri.data());
+      output->GetCellData()->CopyData(inCD, cellId, outId);
+    }
+  };
+
+  // cell ids of polys and strips are offset by the verts and lines
+  vtkIdType cellId = input->GetNumberOfVerts() + input->GetNumberOfLines();
+  for (vtkCellArray* cells : { input->GetPolys(), input->GetStrips() })
+  {
+    bool isStrip = cells == input->GetStrips();
+    auto it = vtk::TakeSmartPointer(cells->NewIterator());
+    for (it->GoToFirstCell(); !it->IsDoneWithTraversal(); it->GoToNextCell(), cellId++)
+    {
+      if (++processedCells % 10000 == 0)
+      {
+        if (cancel)
+        {
+          return nullptr;
+        }
+
+        if (static_cast<vtkIdType>(triangles.size()) > maxSize)
+        {
+          estimatedSize = static_cast<vtkIdType>(
+            static_cast<double>(triangles.size()) * nbInputCells / processedCells);
+          return nullptr;
+        }
+      }
+
+      vtkIdType npts;
+      const vtkIdType* pts;
+      it->GetCurrentCell(npts, pts);
+      for (vtkIdType i = 2; i < npts; i++)
+      {
+        if (isStrip)
+        {
+          // every other triangle of a strip is reversed
+          i % 2 == 0 ? addTriangle(pts[i - 2], pts[i - 1], pts[i], cellId)
+                     : addTriangle(pts[i - 1], pts[i - 2], pts[i], cellId);
+        }
+        else
+        {
+          addTriangle(pts[0], pts[i - 1], pts[i], cellId);
+        }
+      }
+    }
+  }
+
+  estimatedSize = static_cast<vtkIdType>(triangles.size());
+  if (estimatedSize > maxSize)
+  {
+    return nullptr;
+  }
+
+  output->SetPolys(outPolys);
+  return output;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Decimate the input so that its number of triangles, or of points for point clouds,
+ * is lower than the budget. The grid cell size is increased until the budget is met.
+ */
+vtkSmartPointer<vtkPolyData> Decimate(
+  vtkPolyData* input, vtkIdType budget, const std::atomic<bool>& cancel)
+{
+  // do not rely on the bounds cache of the input which is not thread safe
+  vtkPoints* points = input->GetPoints();
+  double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+    VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  double pt[3];
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); i++)
+  {
+    points->GetPoint(i, pt);
+    for (int j = 0; j < 3; j++)
+    {
+      bounds[2 * j] = std::min(bounds[2 * j], pt[j]);
+      bounds[2 * j + 1] = std::max(bounds[2 * j + 1], pt[j]);
+    }
+  }
+
+  double diagonal = std::sqrt((bounds[1] - bounds[0]) * (bounds[1] - bounds[0]) +
+    (bounds[3] - bounds[2]) * (bounds[3] - bounds[2]) +
+    (bounds[5] - bounds[4]) * (bounds[5] - bounds[4]));
+  if (diagonal <= 0.0)
+  {
+    return nullptr;
+  }
+
+  // a surface sampled with a grid of cell size h has about 2 * (diagonal / h)^2 triangles
+  double cellSize = std::max(diagonal * std::sqrt(2.0 / budget), diagonal / (1 << 20));
+  for (int iter = 0; iter < 4; iter++)
+  {
+    vtkIdType size = 0;
+    vtkSmartPointer<vtkPolyData> output = ::ClusterVertices(
+      input, bounds, cellSize, static_cast<vtkIdType>(1.5 * budget), size, cancel);
+    if (cancel)
+    {
+      return nullptr;
+    }
+    if (output && size <= budget)
+    {
+      return output;
+    }
+
+    cellSize *= 1.1 * std::sqrt(static_cast<double>(size) / budget);
+  }
+  return nullptr;
+}
+}
+
+//-----------------------------------------------------------------------------
+struct vtkF3DPolyDataMapper::Internals
+{
+  /**
+   * Cancel the running decimation if any and forget about its result.
+   * The decimation checks the cancel flag regularly so waiting for it is short.
+   */
+  void CancelJob()
+  {
+    if (this->Cancel)
+    {
+      *this->Cancel = true;
+      this->Cancel.reset();
+    }
+    if (this->Job.valid())
+    {
+      this->Job.wait();
+      this->Job = {};
+    }
+    this->Proxy = nullptr;
+  }
+
+  vtkSmartPointer<vtkF3DPolyDataMapper> ProxyMapper;
+  vtkSmartPointer<vtkPolyData> Proxy;
+  vtkMTimeType ProxySyncTime = 0;
+
+  std::future<vtkSmartPointer<vtkPolyData>> Job;
+  std::shared_ptr<std::atomic<bool>> Cancel;
+
+  vtkPolyData* Input = nullptr;
+  vtkMTimeType InputTime = 0;
+  vtkIdType Budget = 0;
+  bool Pending = false;
+};
+
 vtkStandardNewMacro(vtkF3DPolyDataMapper);
 
 //-----------------------------------------------------------------------------
 vtkF3DPolyDataMapper::vtkF3DPolyDataMapper()
+  : Pimpl(new Internals())
 {
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20230518)
   this->SetVBOShiftScaleMethod(vtkPolyDataMapper::ShiftScaleMethodType::DISABLE_SHIFT_SCALE);
@@ -51,6 +322,12 @@ vtkF3DPolyDataMapper::vtkF3DPolyDataMapper()
   }
 }
 
+//-----------------------------------------------------------------------------
+vtkF3DPolyDataMapper::~vtkF3DPolyDataMapper()
+{
+  this->Pimpl->CancelJob();
+}
+
 //-----------------------------------------------------------------------------
 void vtkF3DPolyDataMapper::ReplaceShaderValues(
   std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* actor)
@@ -342,3 +619,118 @@ bool vtkF3DPolyDataMapper::GetNeedToRebuildShaders(
   return ret;
 }
 #endif
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::RenderPiece(vtkRenderer* ren, vtkActor* act)
+{
+  vtkF3DPolyDataMapper* proxyMapper = this->UpdateLOD(ren);
+  if (proxyMapper)
+  {
+    proxyMapper->RenderPiece(ren, act);
+  }
+  else
+  {
+    this->Superclass::RenderPiece(ren, act);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkF3DPolyDataMapper::ReleaseGraphicsResources(vtkWindow* win)
+{
+  if (this->Pimpl->ProxyMapper)
+  {
+    this->Pimpl->ProxyMapper->ReleaseGraphicsResources(win);
+  }
+  this->Superclass::ReleaseGraphicsResources(win);
+}
+
+//-----------------------------------------------------------------------------
+vtkF3DPolyDataMapper* vtkF3DPolyDataMapper::UpdateLOD(vtkRenderer* ren)
+{
+  Internals& internals = *this->Pimpl;
+  vtkPolyData* input = this->GetInput();
+  if (this->LODTriangleBudget <= 0 || !input)
+  {
+    if (internals.Input)
+    {
+      internals.CancelJob();
+      internals.Input = nullptr;
+    }
+    return nullptr;
+  }
+
+  // forget the decimation if the input changed, the outdated proxy is not rendered anymore
+  if (internals.Input != input || internals.InputTime != input->GetMTime() ||
+    internals.Budget != this->LODTriangleBudget)
+  {
+    internals.CancelJob();
+    internals.Input = input;
+    internals.InputTime = input->GetMTime();
+    internals.Budget = this->LODTriangleBudget;
+    internals.Pending = true;
+  }
+  // only start the decimation once the input did not change between two renders,
+  // so that animations, which modify the input on every frame, do not copy it each time
+  else if (internals.Pending)
+  {
+    internals.Pending = false;
+
+    vtkIdType nbTriangles = input->GetNumberOfPolys() + input->GetNumberOfStrips();
+    vtkIdType size = nbTriangles > 0 ? nbTriangles : input->GetNumberOfPoints();
+
+    // skinned and morphed geometries are deformed on the GPU, the proxy would not follow them
+    vtkPointData* pd = input->GetPointData();
+    bool deformed = pd->GetArray("joints") || pd->GetArray("target0_position");
+
+    if (size > this->LODTriangleBudget && !deformed && input->GetPoints())
+    {
+      // the job works on a deep copy since animations update points, connectivity and
+      // attributes of the input in place, which would race with a shallow copy
+      vtkSmartPointer<vtkPolyData> snapshot = vtkSmartPointer<vtkPolyData>::New();
+      snapshot->DeepCopy(input);
+
+      internals.Cancel = std::make_shared<std::atomic<bool>>(false);
+      internals.Job = std::async(std::launch::async,
+        [snapshot, budget = this->LODTriangleBudget, cancel = internals.Cancel]()
+        { return ::Decimate(snapshot, budget, *cancel); });
+    }
+  }
+
+  if (internals.Job.valid() &&
+    internals.Job.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+  {
+    internals.Proxy = internals.Job.get();
+    internals.Cancel.reset();
+    if (internals.Proxy)
+    {
+      F3DLog::Print(F3DLog::Severity::Debug,
+        "Level of detail ready with " +
+          std::to_string(internals.Proxy->GetNumberOfCells()) + " cells");
+    }
+  }
+
+  // the interactor styles raise the desired update rate of the window during motion
+  vtkRenderWindow* renWin = ren->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin ? renWin->GetInteractor() : nullptr;
+  bool interactive = iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+  if (!interactive || !internals.Proxy)
+  {
+    return nullptr;
+  }
+
+  // forward the coloring and rendering settings to the proxy mapper
+  if (!internals.ProxyMapper)
+  {
+    internals.ProxyMapper = vtkSmartPointer<vtkF3DPolyDataMapper>::New();
+  }
+  vtkF3DPolyDataMapper* proxyMapper = internals.ProxyMapper;
+  if (this->GetMTime() > internals.ProxySyncTime ||
+    proxyMapper->GetInput() != internals.Proxy.GetPointer())
+  {
+    proxyMapper->ShallowCopy(this);
+    proxyMapper->SetLODTriangleBudget(0);
+    proxyMapper->SetInputData(internals.Proxy);
+    internals.ProxySyncTime = this->GetMTime();
+  }
+  return proxyMapper;
+}
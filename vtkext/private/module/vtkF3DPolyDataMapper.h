@@ -2,6 +2,9 @@
  * @class   vtkF3DPolyDataMapper
  * @brief   Custom surface mapper used to include skinning and morphing for glTF format
  *
+ * It also supports an interactive level of detail: when a triangle budget is set and the input
+ * is larger than the budget, a decimated proxy is computed in a background thread and is
+ * rendered instead of the input while the camera is moving.
  */
 
 #ifndef vtkF3DPolyDataMapper_h
@@ -10,6 +13,8 @@
 #include <vtkOpenGLPolyDataMapper.h>
 #include <vtkVersion.h>
 
+#include <memory>
+
 class vtkF3DPolyDataMapper : public vtkOpenGLPolyDataMapper
 {
 public:
@@ -34,9 +39,29 @@ public:
     std::map<vtkShader::Type, vtkShader*> shaders, vtkRenderer* ren, vtkActor* actor) override;
   ///@}
 
+  /**
+   * Render the decimated proxy instead of the input while the camera is moving if available.
+   * Start computing the proxy in the background if the input changed.
+   */
+  void RenderPiece(vtkRenderer* ren, vtkActor* act) override;
+
+  /**
+   * Release graphics resources of this mapper and of the decimated proxy mapper.
+   */
+  void ReleaseGraphicsResources(vtkWindow* win) override;
+
+  ///@{
+  /**
+   * Set/Get the maximum number of triangles (or points for point clouds) rendered
+   * during camera motion. 0 disables the level of detail, which is the default.
+   */
+  vtkSetMacro(LODTriangleBudget, vtkIdType);
+  vtkGetMacro(LODTriangleBudget, vtkIdType);
+  ///@}
+
 protected:
   vtkF3DPolyDataMapper();
-  ~vtkF3DPolyDataMapper() override = default;
+  ~vtkF3DPolyDataMapper() override;
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20230902)
   /**
    * Call superclass then check for changes in the environment texture
@@ -53,6 +78,17 @@ private:
    */
   bool RenderWithMatCap(vtkActor* actor);
 
+  /**
+   * Returns the decimated proxy mapper if it should be used for this render, nullptr otherwise.
+   * Start the proxy computation once the input is unchanged between two renders.
+   */
+  vtkF3DPolyDataMapper* UpdateLOD(vtkRenderer* ren);
+
+  vtkIdType LODTriangleBudget = 0;
+
+  struct Internals;
+  std::unique_ptr<Internals> Pimpl;
+
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 3, 20230902)
   vtkMTimeType EnvTextureTime = 0;
   vtkTexture* EnvTexture = nullptr;
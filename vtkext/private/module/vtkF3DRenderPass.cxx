@@ -35,6 +35,7 @@
 #include <vtkOSPRayPass.h>
 #endif
 
+#include <initializer_list>
 #include <sstream>
 
 vtkStandardNewMacro(vtkF3DRenderPass);
@@ -52,24 +53,104 @@ void vtkF3DRenderPass::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ForceOpaqueBackground: " << this->ForceOpaqueBackground << "\n";
 }
 
+// ----------------------------------------------------------------------------
+vtkF3DRenderPass::vtkF3DRenderPass() = default;
+
+// ----------------------------------------------------------------------------
+vtkF3DRenderPass::~vtkF3DRenderPass() = default;
+
 // ----------------------------------------------------------------------------
 void vtkF3DRenderPass::ReleaseGraphicsResources(vtkWindow* w)
 {
   if (this->BlendQuadHelper)
   {
     this->BlendQuadHelper->ReleaseGraphicsResources(w);
+    this->BlendQuadHelper = nullptr;
   }
-  if (this->BackgroundPass)
+
+  // passes that are not part of the current graph must be released explicitly
+  std::initializer_list<vtkRenderPass*> passes = { this->BackgroundPass, this->BlurPass,
+    this->RasterizationPass, this->RaytracingPass, this->MainOnTopPass, this->SSAOPass,
+    this->OpaquePass, this->TranslucentPass, this->VolumetricPass, this->DepthPeelingPass };
+  for (vtkRenderPass* pass : passes)
   {
-    this->BackgroundPass->ReleaseGraphicsResources(w);
+    if (pass)
+    {
+      pass->ReleaseGraphicsResources(w);
+    }
   }
-  if (this->MainPass)
+}
+
+// ----------------------------------------------------------------------------
+void vtkF3DRenderPass::CreatePasses()
+{
+  if (this->BackgroundPass)
   {
-    this->MainPass->ReleaseGraphicsResources(w);
+    // already created
+    return;
   }
-  if (this->MainOnTopPass)
+
+  // background pass, setup framebuffer, clear and draw skybox
+  vtkNew<vtkOpaquePass> bgP;
+  this->BackgroundCameraPass = vtkSmartPointer<vtkCameraPass>::New();
+  this->BackgroundCameraPass->SetDelegatePass(bgP);
+  this->BackgroundPass = vtkSmartPointer<vtkFramebufferPass>::New();
+  this->BackgroundPass->SetColorFormat(vtkTextureObject::Float32);
+
+  this->BlurPass = vtkSmartPointer<vtkF3DHexagonalBokehBlurPass>::New();
+  this->BlurPass->SetDelegatePass(this->BackgroundCameraPass);
+
+  // main rasterization pass, the content of the sequence depends on the options
+  this->LightsPass = vtkSmartPointer<vtkLightsPass>::New();
+  this->OpaquePass = vtkSmartPointer<vtkOpaquePass>::New();
+  this->TranslucentPass = vtkSmartPointer<vtkTranslucentPass>::New();
+  this->VolumetricPass = vtkSmartPointer<vtkVolumetricPass>::New();
+
+  vtkNew<vtkCameraPass> ssaoCamP;
+  ssaoCamP->SetDelegatePass(this->OpaquePass);
+
+  this->SSAOPass = vtkSmartPointer<vtkSSAOPass>::New();
+  this->SSAOPass->SetKernelSize(200);
+  this->SSAOPass->SetDelegatePass(ssaoCamP);
+
+  this->DepthPeelingPass = vtkSmartPointer<vtkDualDepthPeelingPass>::New();
+  this->DepthPeelingPass->SetTranslucentPass(this->TranslucentPass);
+  this->DepthPeelingPass->SetVolumetricPass(this->VolumetricPass);
+
+  this->MainPasses = vtkSmartPointer<vtkRenderPassCollection>::New();
+
+  vtkNew<vtkSequencePass> sequence;
+  sequence->SetPasses(this->MainPasses);
+
+  vtkNew<vtkCameraPass> camP;
+  camP->SetDelegatePass(sequence);
+
+  this->RasterizationPass = vtkSmartPointer<vtkFramebufferPass>::New();
+  this->RasterizationPass->SetDelegatePass(camP);
+  this->RasterizationPass->SetColorFormat(vtkTextureObject::Float32);
+
+  // Needed because VTK can pick the wrong format with certain drivers
+  this->RasterizationPass->SetDepthFormat(vtkTextureObject::Fixed32);
+
   {
-    this->MainOnTopPass->ReleaseGraphicsResources(w);
+    vtkNew<vtkLightsPass> lightsP;
+    vtkNew<vtkOpaquePass> opaqueP;
+
+    vtkNew<vtkRenderPassCollection> collection;
+    collection->AddItem(lightsP);
+    collection->AddItem(opaqueP);
+
+    vtkNew<vtkSequencePass> onTopSequence;
+    onTopSequence->SetPasses(collection);
+
+    vtkNew<vtkCameraPass> onTopCamP;
+    onTopCamP->SetDelegatePass(onTopSequence);
+
+    this->MainOnTopPass = vtkSmartPointer<vtkFramebufferPass>::New();
+    this->MainOnTopPass->SetDelegatePass(onTopCamP);
+
+    // Needed because VTK can pick the wrong format with certain drivers
+    this->MainOnTopPass->SetDepthFormat(vtkTextureObject::Fixed32);
   }
 }
 
@@ -114,121 +195,62 @@ void vtkF3DRenderPass::Initialize(const vtkRenderState* s)
     return;
   }
 
-  this->ReleaseGraphicsResources(s->GetRenderer()->GetRenderWindow());
-
-  // background pass, setup framebuffer, clear and draw skybox
-  vtkNew<vtkOpaquePass> bgP;
-  vtkNew<vtkCameraPass> bgCamP;
-  bgCamP->SetDelegatePass(bgP);
-  this->BackgroundPass = vtkSmartPointer<vtkFramebufferPass>::New();
-  this->BackgroundPass->SetColorFormat(vtkTextureObject::Float32);
+  this->CreatePasses();
 
+  // rewire the persistent passes, no graphics resources are released here
   if (this->UseBlurBackground)
   {
-    vtkNew<vtkF3DHexagonalBokehBlurPass> blur;
-    blur->SetCircleOfConfusionRadius(this->CircleOfConfusionRadius);
-    blur->SetDelegatePass(bgCamP);
-    this->BackgroundPass->SetDelegatePass(blur);
+    this->BlurPass->SetCircleOfConfusionRadius(this->CircleOfConfusionRadius);
+    this->BackgroundPass->SetDelegatePass(this->BlurPass);
   }
   else
   {
-    this->BackgroundPass->SetDelegatePass(bgCamP);
+    this->BackgroundPass->SetDelegatePass(this->BackgroundCameraPass);
   }
 
-  // main pass
 #if F3D_MODULE_RAYTRACING
   if (this->UseRaytracing)
   {
-    vtkNew<vtkOSPRayPass> ospP;
-    this->MainPass = vtkSmartPointer<vtkFramebufferPass>::New();
-    this->MainPass->SetDelegatePass(ospP);
-    this->MainPass->SetColorFormat(vtkTextureObject::Float32);
+    if (!this->RaytracingPass)
+    {
+      vtkNew<vtkOSPRayPass> ospP;
+      this->RaytracingPass = vtkSmartPointer<vtkFramebufferPass>::New();
+      this->RaytracingPass->SetDelegatePass(ospP);
+      this->RaytracingPass->SetColorFormat(vtkTextureObject::Float32);
+    }
+    this->MainPass = this->RaytracingPass;
   }
   else
 #endif
   {
-    vtkNew<vtkLightsPass> lightsP;
-    vtkNew<vtkOpaquePass> opaqueP;
-    vtkNew<vtkTranslucentPass> translucentP;
-    vtkNew<vtkVolumetricPass> volumeP;
-
-    vtkNew<vtkRenderPassCollection> collection;
-    collection->AddItem(lightsP);
+    this->MainPasses->RemoveAllItems();
+    this->MainPasses->AddItem(this->LightsPass);
 
     // opaque passes
-    if (this->UseSSAOPass)
+    vtkBoundingBox bbox(this->Bounds);
+    if (this->UseSSAOPass && bbox.IsValid())
     {
-      vtkBoundingBox bbox(this->Bounds);
-      if (bbox.IsValid())
-      {
-        vtkNew<vtkCameraPass> ssaoCamP;
-        ssaoCamP->SetDelegatePass(opaqueP);
-
-        vtkNew<vtkSSAOPass> ssaoP;
-        ssaoP->SetRadius(0.1 * bbox.GetDiagonalLength());
-        ssaoP->SetBias(0.001 * bbox.GetDiagonalLength());
-        ssaoP->SetKernelSize(200);
-        ssaoP->SetDelegatePass(ssaoCamP);
-
-        collection->AddItem(ssaoP);
-      }
-      else
-      {
-        collection->AddItem(opaqueP);
-      }
+      this->SSAOPass->SetRadius(0.1 * bbox.GetDiagonalLength());
+      this->SSAOPass->SetBias(0.001 * bbox.GetDiagonalLength());
+      this->MainPasses->AddItem(this->SSAOPass);
     }
     else
     {
-      collection->AddItem(opaqueP);
+      this->MainPasses->AddItem(this->OpaquePass);
     }
 
     // translucent and volumic passes
     if (this->UseDepthPeelingPass)
     {
-      vtkNew<vtkDualDepthPeelingPass> ddpP;
-      ddpP->SetTranslucentPass(translucentP);
-      ddpP->SetVolumetricPass(volumeP);
-      collection->AddItem(ddpP);
+      this->MainPasses->AddItem(this->DepthPeelingPass);
     }
     else
     {
-      collection->AddItem(translucentP);
-      collection->AddItem(volumeP);
+      this->MainPasses->AddItem(this->TranslucentPass);
+      this->MainPasses->AddItem(this->VolumetricPass);
     }
 
-    vtkNew<vtkSequencePass> sequence;
-    sequence->SetPasses(collection);
-
-    vtkNew<vtkCameraPass> camP;
-    camP->SetDelegatePass(sequence);
-
-    this->MainPass = vtkSmartPointer<vtkFramebufferPass>::New();
-    this->MainPass->SetDelegatePass(camP);
-    this->MainPass->SetColorFormat(vtkTextureObject::Float32);
-
-    // Needed because VTK can pick the wrong format with certain drivers
-    this->MainPass->SetDepthFormat(vtkTextureObject::Fixed32);
-  }
-
-  {
-    vtkNew<vtkLightsPass> lightsP;
-    vtkNew<vtkOpaquePass> opaqueP;
-
-    vtkNew<vtkRenderPassCollection> collection;
-    collection->AddItem(lightsP);
-    collection->AddItem(opaqueP);
-
-    vtkNew<vtkSequencePass> sequence;
-    sequence->SetPasses(collection);
-
-    vtkNew<vtkCameraPass> camP;
-    camP->SetDelegatePass(sequence);
-
-    this->MainOnTopPass = vtkSmartPointer<vtkFramebufferPass>::New();
-    this->MainOnTopPass->SetDelegatePass(camP);
-
-    // Needed because VTK can pick the wrong format with certain drivers
-    this->MainOnTopPass->SetDepthFormat(vtkTextureObject::Fixed32);
+    this->MainPass = this->RasterizationPass;
   }
 
   this->InitializeTime = this->GetMTime();
@@ -293,7 +315,10 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
   vtkOpenGLState::ScopedglEnableDisable bsaver(ostate, GL_BLEND);
   vtkOpenGLState::ScopedglEnableDisable dsaver(ostate, GL_DEPTH_TEST);
 
-  if (this->BlendQuadHelper && this->BlendQuadHelper->ShaderChangeValue < this->GetMTime())
+  // the blend shader only depends on these two options
+  if (this->BlendQuadHelper &&
+    (this->BlendUseRaytracing != this->UseRaytracing ||
+      this->BlendForceOpaqueBackground != this->ForceOpaqueBackground))
   {
     this->BlendQuadHelper = nullptr;
   }
@@ -367,6 +392,8 @@ void vtkF3DRenderPass::Blend(const vtkRenderState* s)
       vtkOpenGLRenderUtilities::GetFullScreenQuadVertexShader().c_str(), FSSource.c_str(), "");
 
     this->BlendQuadHelper->ShaderChangeValue = this->GetMTime();
+    this->BlendUseRaytracing = this->UseRaytracing;
+    this->BlendForceOpaqueBackground = this->ForceOpaqueBackground;
   }
   else
   {
@@ -7,6 +7,8 @@
  * The second pass renders the dataset with different options (raytracing, SSAO, depth peeling, ...)
  * Once the two passes are rendered into textures, a final shader is applied to combine the
  * background (and optionally blur it using Bokeh depth of field) and the dataset image.
+ * Sub-passes are created once and kept alive: changing an option only rewires the delegates,
+ * framebuffers and shader programs are preserved until ReleaseGraphicsResources is called.
  *
  * @sa
  * vtkRenderPass
@@ -23,8 +25,18 @@
 #include <memory>
 #include <vector>
 
+class vtkCameraPass;
+class vtkDualDepthPeelingPass;
+class vtkF3DHexagonalBokehBlurPass;
 class vtkInformationIntegerKey;
+class vtkLightsPass;
+class vtkOpaquePass;
 class vtkProp;
+class vtkRenderPassCollection;
+class vtkSSAOPass;
+class vtkSequencePass;
+class vtkTranslucentPass;
+class vtkVolumetricPass;
 
 class vtkF3DRenderPass : public vtkRenderPass
 {
@@ -50,13 +62,18 @@ public:
   static vtkInformationIntegerKey* RENDER_UI_ONLY();
 
 protected:
-  vtkF3DRenderPass() = default;
-  ~vtkF3DRenderPass() override = default;
+  vtkF3DRenderPass();
+  ~vtkF3DRenderPass() override;
 
   void ReleaseGraphicsResources(vtkWindow* w) override;
 
   void Initialize(const vtkRenderState* s);
 
+  /**
+   * Create the persistent sub-passes if needed.
+   */
+  void CreatePasses();
+
   void Blend(const vtkRenderState* s);
 
   bool ArmatureVisible = false;
@@ -69,9 +86,24 @@ protected:
   double CircleOfConfusionRadius = 20.0;
 
   vtkSmartPointer<vtkFramebufferPass> BackgroundPass;
-  vtkSmartPointer<vtkFramebufferPass> MainPass;
+  vtkSmartPointer<vtkFramebufferPass> RasterizationPass;
+  vtkSmartPointer<vtkFramebufferPass> RaytracingPass;
   vtkSmartPointer<vtkFramebufferPass> MainOnTopPass;
 
+  // points to RasterizationPass or RaytracingPass
+  vtkFramebufferPass* MainPass = nullptr;
+
+  vtkSmartPointer<vtkCameraPass> BackgroundCameraPass;
+  vtkSmartPointer<vtkF3DHexagonalBokehBlurPass> BlurPass;
+
+  vtkSmartPointer<vtkRenderPassCollection> MainPasses;
+  vtkSmartPointer<vtkLightsPass> LightsPass;
+  vtkSmartPointer<vtkOpaquePass> OpaquePass;
+  vtkSmartPointer<vtkSSAOPass> SSAOPass;
+  vtkSmartPointer<vtkTranslucentPass> TranslucentPass;
+  vtkSmartPointer<vtkVolumetricPass> VolumetricPass;
+  vtkSmartPointer<vtkDualDepthPeelingPass> DepthPeelingPass;
+
   double Bounds[6] = {};
 
   vtkMTimeType InitializeTime = 0;
@@ -81,6 +113,10 @@ protected:
   std::vector<vtkProp*> MainOnTopProps;
 
   std::shared_ptr<vtkOpenGLQuadHelper> BlendQuadHelper;
+
+  // blend shader configuration, the shader is only rebuilt when one of these changes
+  bool BlendUseRaytracing = false;
+  bool BlendForceOpaqueBackground = false;
 };
 
 #endif
@@ -3,10 +3,13 @@
 #include "F3DColoringInfoHandler.h"
 #include "F3DDefaultHDRI.h"
 #include "F3DLog.h"
+#include "vtkF3DAccumulationPass.h"
 #include "vtkF3DCachedLUTTexture.h"
 #include "vtkF3DCachedSpecularTexture.h"
+#include "vtkF3DDynamicResolutionPass.h"
 #include "vtkF3DOpenGLGridMapper.h"
 #include "vtkF3DOverlayRenderPass.h"
+#include "vtkF3DPointCloudOctree.h"
 #include "vtkF3DPolyDataMapper.h"
 #include "vtkF3DRenderPass.h"
 #include "vtkF3DSolidBackgroundPass.h"
@@ -42,6 +45,7 @@
 #include <vtkPolyData.h>
 #include <vtkProperty.h>
 #include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
 #include <vtkSSAAPass.h>
 #include <vtkScalarBarActor.h>
 #include <vtkSkybox.h>
@@ -88,6 +92,7 @@
 
 #include <cctype>
 #include <chrono>
+#include <initializer_list>
 #include <sstream>
 
 namespace
@@ -253,6 +258,18 @@ void vtkF3DRenderer::ReleaseGraphicsResources(vtkWindow* w)
 
   this->UIActor->ReleaseGraphicsResources(w);
 
+  // persistent passes may not be part of the current pass graph
+  std::initializer_list<vtkRenderPass*> passes = { this->F3DPass, this->SSAAPass,
+    this->AccumulationPass, this->ToneMappingPass, this->SolidBackgroundPass, this->FXAAPass,
+    this->UserPass, this->DynamicResolutionPass };
+  for (vtkRenderPass* pass : passes)
+  {
+    if (pass)
+    {
+      pass->ReleaseGraphicsResources(w);
+    }
+  }
+
   this->Superclass::ReleaseGraphicsResources(w);
 }
 
@@ -372,71 +389,90 @@ void vtkF3DRenderer::InitializeUpVector(const std::vector<double>& upVec)
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureRenderPasses()
 {
-  // clean up previous pass
-  vtkRenderPass* pass = this->GetPass();
-  if (pass)
+  // passes are kept alive between calls so that toggling an option only rewires the delegates
+  // instead of reallocating framebuffers and recompiling shaders
+  if (!this->F3DPass)
   {
-    pass->ReleaseGraphicsResources(this->RenderWindow);
+    this->F3DPass = vtkSmartPointer<vtkF3DRenderPass>::New();
+    this->OverlayPass = vtkSmartPointer<vtkF3DOverlayRenderPass>::New();
   }
 
-  vtkNew<vtkF3DRenderPass> newPass;
 #if F3D_MODULE_RAYTRACING
-  newPass->SetUseRaytracing(this->UseRaytracing);
+  this->F3DPass->SetUseRaytracing(this->UseRaytracing);
 #endif
-  newPass->SetUseSSAOPass(this->UseSSAOPass);
-  newPass->SetUseDepthPeelingPass(this->UseDepthPeelingPass);
-  newPass->SetUseBlurBackground(this->UseBlurBackground);
-  newPass->SetCircleOfConfusionRadius(this->CircleOfConfusionRadius);
-  newPass->SetForceOpaqueBackground(this->HDRISkyboxVisible);
-  newPass->SetArmatureVisible(this->ArmatureVisible);
+  this->F3DPass->SetUseSSAOPass(this->UseSSAOPass);
+  this->F3DPass->SetUseDepthPeelingPass(this->UseDepthPeelingPass);
+  this->F3DPass->SetUseBlurBackground(this->UseBlurBackground);
+  this->F3DPass->SetCircleOfConfusionRadius(this->CircleOfConfusionRadius);
+  this->F3DPass->SetForceOpaqueBackground(this->HDRISkyboxVisible);
+  this->F3DPass->SetArmatureVisible(this->ArmatureVisible);
 
   double bounds[6];
   this->ComputeVisiblePropBounds(bounds);
-  newPass->SetBounds(bounds);
+  this->F3DPass->SetBounds(bounds);
 
   // Image post processing passes
-  vtkSmartPointer<vtkRenderPass> renderingPass = newPass;
+  vtkSmartPointer<vtkRenderPass> renderingPass = this->F3DPass;
 
   if (this->AntiAliasingModeEnabled == vtkF3DRenderer::AntiAliasingMode::SSAA)
   {
-    vtkNew<vtkSSAAPass> ssaaP;
+    if (!this->SSAAPass)
+    {
+      this->SSAAPass = vtkSmartPointer<vtkSSAAPass>::New();
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 20250329)
-    ssaaP->SetColorFormat(vtkTextureObject::Float16);
+      this->SSAAPass->SetColorFormat(vtkTextureObject::Float16);
 #endif
-    ssaaP->SetDelegatePass(renderingPass);
-    renderingPass = ssaaP;
+    }
+    this->SSAAPass->SetDelegatePass(renderingPass);
+    renderingPass = this->SSAAPass;
+  }
+  else if (this->AntiAliasingModeEnabled == vtkF3DRenderer::AntiAliasingMode::TAA)
+  {
+    // accumulate the linear colors, before tone mapping
+    if (!this->AccumulationPass)
+    {
+      this->AccumulationPass = vtkSmartPointer<vtkF3DAccumulationPass>::New();
+    }
+    this->AccumulationPass->SetDelegatePass(renderingPass);
+    renderingPass = this->AccumulationPass;
   }
 
   if (this->UseToneMappingPass)
   {
-    vtkNew<vtkToneMappingPass> toneP;
-
+    if (!this->ToneMappingPass)
+    {
+      this->ToneMappingPass = vtkSmartPointer<vtkToneMappingPass>::New();
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240609)
-    toneP->SetToneMappingType(vtkToneMappingPass::NeutralPBR);
+      this->ToneMappingPass->SetToneMappingType(vtkToneMappingPass::NeutralPBR);
 #else
-    toneP->SetToneMappingType(vtkToneMappingPass::GenericFilmic);
-    toneP->SetGenericFilmicDefaultPresets();
+      this->ToneMappingPass->SetToneMappingType(vtkToneMappingPass::GenericFilmic);
+      this->ToneMappingPass->SetGenericFilmicDefaultPresets();
 #endif
-    toneP->SetDelegatePass(renderingPass);
-    renderingPass = toneP;
+    }
+    this->ToneMappingPass->SetDelegatePass(renderingPass);
+    renderingPass = this->ToneMappingPass;
   }
 
   if (!this->HDRISkyboxVisible)
   {
     // if the background is transparent, we need to blend the result to the RGB background
     // before it goes through the next passes
-    vtkNew<vtkF3DSolidBackgroundPass> bgPass;
-    bgPass->SetDelegatePass(renderingPass);
-    renderingPass = bgPass;
+    if (!this->SolidBackgroundPass)
+    {
+      this->SolidBackgroundPass = vtkSmartPointer<vtkF3DSolidBackgroundPass>::New();
+    }
+    this->SolidBackgroundPass->SetDelegatePass(renderingPass);
+    renderingPass = this->SolidBackgroundPass;
   }
 
   if (this->AntiAliasingModeEnabled == vtkF3DRenderer::AntiAliasingMode::FXAA)
   {
-    vtkNew<vtkOpenGLFXAAPass> fxaaP;
-    fxaaP->SetDelegatePass(renderingPass);
-
-    this->SetPass(fxaaP);
-    renderingPass = fxaaP;
+    if (!this->FXAAPass)
+    {
+      this->FXAAPass = vtkSmartPointer<vtkOpenGLFXAAPass>::New();
+    }
+    this->FXAAPass->SetDelegatePass(renderingPass);
+    renderingPass = this->FXAAPass;
   }
 
   if (this->FinalShader.has_value())
@@ -444,10 +480,13 @@ void vtkF3DRenderer::ConfigureRenderPasses()
     // basic validation
     if (this->FinalShader.value().find("pixel") != std::string::npos)
     {
-      vtkNew<vtkF3DUserRenderPass> userP;
-      userP->SetUserShader(this->FinalShader.value().c_str());
-      userP->SetDelegatePass(renderingPass);
-      renderingPass = userP;
+      if (!this->UserPass)
+      {
+        this->UserPass = vtkSmartPointer<vtkF3DUserRenderPass>::New();
+      }
+      this->UserPass->SetUserShader(this->FinalShader.value());
+      this->UserPass->SetDelegatePass(renderingPass);
+      renderingPass = this->UserPass;
     }
     else
     {
@@ -456,10 +495,23 @@ void vtkF3DRenderer::ConfigureRenderPasses()
     }
   }
 
-  vtkNew<vtkF3DOverlayRenderPass> overlayP;
-  overlayP->SetDelegatePass(renderingPass);
+  if (this->UseDynamicResolution)
+  {
+    // the overlay is composited afterwards so that the UI stays at full resolution
+    if (!this->DynamicResolutionPass)
+    {
+      this->DynamicResolutionPass = vtkSmartPointer<vtkF3DDynamicResolutionPass>::New();
+    }
+    this->DynamicResolutionPass->SetTargetFrameTime(this->DynamicResolutionTargetFrameRate > 0.0
+        ? 1.0 / this->DynamicResolutionTargetFrameRate
+        : 0.0);
+    this->DynamicResolutionPass->SetMinimumScale(this->DynamicResolutionMinimumScale);
+    this->DynamicResolutionPass->SetDelegatePass(renderingPass);
+    renderingPass = this->DynamicResolutionPass;
+  }
 
-  this->SetPass(overlayP);
+  this->OverlayPass->SetDelegatePass(renderingPass);
+  this->SetPass(this->OverlayPass);
 
 #if F3D_MODULE_RAYTRACING
   vtkOSPRayRendererNode::SetRendererType("pathtracer", this);
@@ -833,7 +885,7 @@ vtkBoundingBox vtkF3DRenderer::ComputeVisiblePropOrientedBounds(const vtkMatrix4
 
   /* Use custom logic to extend box.
    * Should give the tightest bounds even when non-axis-aligned.
-   * Only implemented for `vtkPolyDataMapper`-based actors. */
+   * Only implemented for `vtkActor`s, other mappers than `vtkPolyDataMapper` use their bounds. */
   const auto extendBoxArbitrary = [&](vtkProp3D* prop3d, vtkBoundingBox& box)
   {
     vtkActor* actor = vtkActor::SafeDownCast(prop3d);
@@ -858,6 +910,22 @@ vtkBoundingBox vtkF3DRenderer::ComputeVisiblePropOrientedBounds(const vtkMatrix4
           return;
         }
       }
+      else if (actor->GetMapper())
+      {
+        /* other mappers, such as glyph mappers, only provide their bounds, use their corners */
+        vtkNew<vtkMatrix4x4> tmpMatrix;
+        vtkMatrix4x4::Multiply4x4(matrix, actor->GetMatrix(), tmpMatrix);
+        const double* bounds = actor->GetMapper()->GetBounds();
+        for (int i = 0; i < 8; ++i)
+        {
+          double p[4] = { bounds[i & 1], bounds[2 + ((i >> 1) & 1)], bounds[4 + ((i >> 2) & 1)],
+            1 };
+          double q[4];
+          tmpMatrix->MultiplyPoint(p, q);
+          box.AddPoint(q);
+        }
+        return;
+      }
     }
     assert(false); /* custom bounds calculations not implemented for this `vtkProp3D` */
   };
@@ -1484,6 +1552,44 @@ void vtkF3DRenderer::SetFinalShader(const std::optional<std::string>& finalShade
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkF3DRenderer::NeedsAccumulationStep()
+{
+  return this->RenderPassesConfigured &&
+    this->AntiAliasingModeEnabled == vtkF3DRenderer::AntiAliasingMode::TAA &&
+    this->AccumulationPass && this->AccumulationPass->NeedsAccumulation();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseDynamicResolution(bool use)
+{
+  if (this->UseDynamicResolution != use)
+  {
+    this->UseDynamicResolution = use;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetDynamicResolutionTargetFrameRate(double frameRate)
+{
+  if (this->DynamicResolutionTargetFrameRate != frameRate)
+  {
+    this->DynamicResolutionTargetFrameRate = frameRate;
+    this->RenderPassesConfigured = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetDynamicResolutionMinimumScale(double scale)
+{
+  if (this->DynamicResolutionMinimumScale != scale)
+  {
+    this->DynamicResolutionMinimumScale = scale;
+    this->RenderPassesConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::SetAntiAliasingMode(AntiAliasingMode mode)
 {
@@ -1740,13 +1846,23 @@ void vtkF3DRenderer::UpdateActors()
   assert(this->Importer);
 
   // Handle importer changes
-  // XXX: Importer only modify itself when adding a new importer,
+  // XXX: Importer only modify itself when adding or replacing an importer,
   // not when updating at a time step
   vtkMTimeType importerMTime = this->Importer->GetMTime();
   if (importerMTime > this->ImporterTimeStamp)
   {
     this->ActorsPropertiesConfigured = false;
     this->GridConfigured = false;
+
+    // New actors and lights may have been imported next to already configured ones
+    this->LightIntensitiesConfigured = false;
+    this->ColorTransferFunctionConfigured = false;
+    this->ColoringMappersConfigured = false;
+    this->PointSpritesMappersConfigured = false;
+    this->VolumePropsAndMappersConfigured = false;
+    this->ScalarBarActorConfigured = false;
+    this->MetaDataConfigured = false;
+    this->ColoringConfigured = false;
   }
   this->ImporterTimeStamp = importerMTime;
 
@@ -1809,6 +1925,11 @@ void vtkF3DRenderer::UpdateActors()
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::Render()
 {
+  if (!this->GetInformation()->Get(vtkF3DRenderPass::RENDER_UI_ONLY()))
+  {
+    this->UpdatePointSpritesStreaming();
+  }
+
   if (!this->TimerVisible)
   {
     this->Superclass::Render();
@@ -2061,6 +2182,16 @@ void vtkF3DRenderer::SetTextureNormal(const std::optional<fs::path>& tex)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetLODTriangleBudget(vtkIdType budget)
+{
+  if (this->LODTriangleBudget != budget)
+  {
+    this->LODTriangleBudget = budget;
+    this->ActorsPropertiesConfigured = false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ConfigureActorsProperties()
 {
@@ -2229,6 +2360,15 @@ void vtkF3DRenderer::ConfigureActorsProperties()
       coloring.Actor->GetProperty()->SetTexture("matcap", matCapTex);
       coloring.OriginalActor->GetProperty()->SetTexture("matcap", matCapTex);
     }
+
+    for (vtkActor* actor : { coloring.Actor.GetPointer(), coloring.OriginalActor })
+    {
+      vtkF3DPolyDataMapper* mapper = vtkF3DPolyDataMapper::SafeDownCast(actor->GetMapper());
+      if (mapper)
+      {
+        mapper->SetLODTriangleBudget(this->LODTriangleBudget);
+      }
+    }
   }
 
   for (const auto& sprites : this->Importer->GetPointSpritesActorsAndMappers())
@@ -2323,6 +2463,76 @@ void vtkF3DRenderer::SetPointSpritesProperties(SplatType type, double pointSprit
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetPointSpritesMemoryBudget(vtkIdType budget)
+{
+  this->PointSpritesMemoryBudget = budget;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::UpdatePointSpritesStreaming()
+{
+  if (!this->Importer)
+  {
+    return;
+  }
+
+  // the interactor styles raise the desired update rate of the window during motion
+  vtkRenderWindow* renWin = this->GetRenderWindow();
+  vtkRenderWindowInteractor* iren = renWin ? renWin->GetInteractor() : nullptr;
+  bool interactive = iren && renWin->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+
+  for (const auto& sprites : this->Importer->GetPointSpritesActorsAndMappers())
+  {
+    vtkF3DPointCloudOctree* octree = sprites.Octree;
+    vtkPolyData* points = sprites.Points;
+    if (!points)
+    {
+      continue;
+    }
+
+    // point clouds fitting in the budget are rendered directly, as well as animated ones
+    // since building an octree for each time step would be slower than rendering them
+    bool stream = this->PointSpritesMemoryBudget > 0 && !this->CachePath.empty() &&
+      sprites.Importer->GetNumberOfAnimations() <= 0 &&
+      static_cast<vtkIdType>(points->GetActualMemorySize()) * 1024 > this->PointSpritesMemoryBudget;
+    if (!stream)
+    {
+      if (sprites.Mapper->GetInputDataObject(0, 0) != points)
+      {
+        sprites.Mapper->SetInputData(points);
+      }
+      continue;
+    }
+
+    if (!sprites.Actor->GetVisibility())
+    {
+      continue;
+    }
+
+    if (octree->GetInput() != points)
+    {
+      octree->Initialize(points, this->CachePath + "/octree");
+    }
+    if (!octree->IsReady())
+    {
+      // render the whole point cloud while the octree is built or if it could not be built
+      if (sprites.Mapper->GetInputDataObject(0, 0) != points)
+      {
+        sprites.Mapper->SetInputData(points);
+      }
+      continue;
+    }
+
+    vtkPolyData* streamed =
+      octree->Update(this, sprites.Actor->GetMatrix(), this->PointSpritesMemoryBudget, interactive);
+    if (sprites.Mapper->GetInputDataObject(0, 0) != streamed)
+    {
+      sprites.Mapper->SetInputData(streamed);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::ShowScalarBar(bool show)
 {
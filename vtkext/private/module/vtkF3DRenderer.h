@@ -27,12 +27,21 @@ namespace fs = std::filesystem;
 class vtkDiscretizableColorTransferFunction;
 class vtkColorTransferFunction;
 class vtkCornerAnnotation;
+class vtkF3DAccumulationPass;
+class vtkF3DDynamicResolutionPass;
+class vtkF3DOverlayRenderPass;
+class vtkF3DRenderPass;
+class vtkF3DSolidBackgroundPass;
+class vtkF3DUserRenderPass;
 class vtkGridAxesActor3D;
 class vtkImageReader2;
+class vtkOpenGLFXAAPass;
 class vtkOrientationMarkerWidget;
+class vtkSSAAPass;
 class vtkScalarBarActor;
 class vtkSkybox;
 class vtkTextActor;
+class vtkToneMappingPass;
 
 class vtkF3DRenderer : public vtkOpenGLRenderer
 {
@@ -47,7 +56,8 @@ public:
   {
     NONE,
     FXAA,
-    SSAA
+    SSAA,
+    TAA
   };
 
   ///@{
@@ -106,8 +116,17 @@ public:
   void SetRaytracingSamples(int samples);
   void SetBackfaceType(const std::optional<std::string>& backfaceType);
   void SetFinalShader(const std::optional<std::string>& finalShader);
+  void SetUseDynamicResolution(bool use);
+  void SetDynamicResolutionTargetFrameRate(double frameRate);
+  void SetDynamicResolutionMinimumScale(double scale);
   ///@}
 
+  /**
+   * Return true if the progressive anti-aliasing has not converged yet,
+   * meaning a render with the vtkF3DAccumulationPass::ACCUMULATE key would improve the image.
+   */
+  bool NeedsAccumulationStep();
+
   /**
    * Set SetUseOrthographicProjection
    */
@@ -270,6 +289,13 @@ public:
    */
   void SetTextureNormal(const std::optional<fs::path>& tex);
 
+  /**
+   * Set the maximum number of triangles rendered per actor during camera motion.
+   * Larger geometries are replaced by a decimated proxy while the camera moves.
+   * 0 disables the level of detail.
+   */
+  void SetLODTriangleBudget(vtkIdType budget);
+
   enum class SplatType
   {
     SPHERE,
@@ -281,6 +307,17 @@ public:
    */
   void SetPointSpritesProperties(SplatType splatType, double pointSpritesSize);
 
+  /**
+   * Set the memory budget in bytes of the point sprites.
+   * Larger point clouds are split in an octree stored in the cache directory and only the nodes
+   * needed for the current camera are loaded, under this budget.
+   * The octree is built in the background, the whole point cloud is rendered until it is ready.
+   * The budget does not bound the CPU memory of the imported point cloud itself.
+   * Point clouds of importers with animations are never streamed.
+   * 0 disables the streaming.
+   */
+  void SetPointSpritesMemoryBudget(vtkIdType budget);
+
   /**
    * Set the visibility of the scalar bar.
    * It will only be shown when coloring and not shown
@@ -491,6 +528,11 @@ private:
    */
   void ConfigureColoring();
 
+  /**
+   * Select and load the octree nodes of the streamed point sprites for the current camera
+   */
+  void UpdatePointSpritesStreaming();
+
   /**
    * Convenience method for configuring a poly data mapper for coloring
    * Return true if mapper was configured for coloring, false otherwise.
@@ -536,6 +578,17 @@ private:
 
   unsigned int Timer = 0; // Timer OpenGL query
 
+  // Render passes are created once and rewired when options change
+  vtkSmartPointer<vtkF3DRenderPass> F3DPass;
+  vtkSmartPointer<vtkSSAAPass> SSAAPass;
+  vtkSmartPointer<vtkF3DAccumulationPass> AccumulationPass;
+  vtkSmartPointer<vtkToneMappingPass> ToneMappingPass;
+  vtkSmartPointer<vtkF3DSolidBackgroundPass> SolidBackgroundPass;
+  vtkSmartPointer<vtkOpenGLFXAAPass> FXAAPass;
+  vtkSmartPointer<vtkF3DUserRenderPass> UserPass;
+  vtkSmartPointer<vtkF3DDynamicResolutionPass> DynamicResolutionPass;
+  vtkSmartPointer<vtkF3DOverlayRenderPass> OverlayPass;
+
   bool CheatSheetConfigured = false;
   bool ActorsPropertiesConfigured = false;
   bool GridConfigured = false;
@@ -576,6 +629,9 @@ private:
   bool UseSSAOPass = false;
   bool UseToneMappingPass = false;
   bool UseBlurBackground = false;
+  bool UseDynamicResolution = false;
+  double DynamicResolutionTargetFrameRate = 30.0;
+  double DynamicResolutionMinimumScale = 0.25;
   std::optional<bool> UseOrthographicProjection = false;
   bool UseTrackball = false;
   bool InvertZoom = false;
@@ -641,6 +697,8 @@ private:
   std::optional<fs::path> TextureMaterial;
   std::optional<fs::path> TextureEmissive;
   std::optional<fs::path> TextureNormal;
+  vtkIdType LODTriangleBudget = 0;
+  vtkIdType PointSpritesMemoryBudget = 0;
 
   vtkSmartPointer<vtkDiscretizableColorTransferFunction> ColorTransferFunction;
   bool ExpandingRangeSet = false;
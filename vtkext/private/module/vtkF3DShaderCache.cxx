@@ -0,0 +1,262 @@
+#include "vtkF3DShaderCache.h"
+
+#include "F3DLog.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkShader.h>
+#include <vtkShaderProgram.h>
+#include <vtkVersion.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
+#include <vtksys/SystemTools.hxx>
+
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240914)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// vtkShaderProgram cannot adopt an existing program object, access its protected members
+// through pointers to members obtained from a derived class
+struct ShaderProgramAccess : public vtkShaderProgram
+{
+  static void SetHandle(vtkShaderProgram* program, int handle, bool linked)
+  {
+    program->*(&ShaderProgramAccess::Handle) = handle;
+    program->*(&ShaderProgramAccess::Linked) = linked;
+    program->SetCompiled(linked);
+  }
+};
+
+//----------------------------------------------------------------------------
+void AppendToHash(vtksysMD5* md5, const std::string& str)
+{
+  // include the terminating null character so that concatenations cannot collide
+  vtksysMD5_Append(
+    md5, reinterpret_cast<const unsigned char*>(str.c_str()), static_cast<int>(str.size() + 1));
+}
+
+//----------------------------------------------------------------------------
+std::string GetSource(vtkShader* shader)
+{
+  return shader ? shader->GetSource() : std::string();
+}
+
+//----------------------------------------------------------------------------
+std::string GetGLString(GLenum name)
+{
+  const GLubyte* str = glGetString(name);
+  return str ? reinterpret_cast<const char*>(str) : "";
+}
+}
+
+vtkStandardNewMacro(vtkF3DShaderCache);
+
+//----------------------------------------------------------------------------
+vtkF3DShaderCache::vtkF3DShaderCache() = default;
+
+//----------------------------------------------------------------------------
+vtkF3DShaderCache::~vtkF3DShaderCache() = default;
+
+//----------------------------------------------------------------------------
+void vtkF3DShaderCache::SetCacheDirectory(const std::string& dir)
+{
+  if (this->CacheDirectory != dir)
+  {
+    this->CacheDirectory = dir;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DShaderCache::ReleaseGraphicsResources(vtkWindow* win)
+{
+  this->Superclass::ReleaseGraphicsResources(win);
+
+  // the next context may be different
+  this->BinarySupport = -1;
+  this->DriverString.clear();
+}
+
+//----------------------------------------------------------------------------
+vtkShaderProgram* vtkF3DShaderCache::ReadyShaderProgram(
+  vtkShaderProgram* shader, vtkTransformFeedback* cap)
+{
+  if (!shader || shader->GetCompiled() || cap || this->CacheDirectory.empty() ||
+    !this->IsBinarySupported())
+  {
+    return this->Superclass::ReadyShaderProgram(shader, cap);
+  }
+
+  const std::string path = this->CacheDirectory + "/" + this->ComputeKey(shader) + ".bin";
+  if (this->LoadProgram(shader, path))
+  {
+    this->NumberOfHits++;
+    F3DLog::Print(F3DLog::Severity::Debug,
+      "Shader program loaded from cache (" + std::to_string(this->NumberOfHits) + " hits, " +
+        std::to_string(this->NumberOfMisses) + " misses)");
+    return this->Superclass::ReadyShaderProgram(shader, cap);
+  }
+
+  this->NumberOfMisses++;
+  F3DLog::Print(F3DLog::Severity::Debug,
+    "Shader program not found in cache (" + std::to_string(this->NumberOfHits) + " hits, " +
+      std::to_string(this->NumberOfMisses) + " misses)");
+
+  // create the program object ourselves so the driver knows the binary will be retrieved,
+  // the shaders are attached to it when compiling
+  if (shader->GetHandle() == 0)
+  {
+    GLuint handle = glCreateProgram();
+    glProgramParameteri(handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    ::ShaderProgramAccess::SetHandle(shader, static_cast<int>(handle), false);
+  }
+
+  vtkShaderProgram* result = this->Superclass::ReadyShaderProgram(shader, cap);
+  if (result && result->GetCompiled())
+  {
+    this->SaveProgram(result, path);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DShaderCache::IsBinarySupported()
+{
+  if (this->BinarySupport < 0)
+  {
+    // GL_NUM_PROGRAM_BINARY_FORMATS is an invalid enum without ARB_get_program_binary,
+    // the value is left untouched in that case
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    this->BinarySupport = numFormats > 0 ? 1 : 0;
+    this->DriverString =
+      ::GetGLString(GL_VENDOR) + ::GetGLString(GL_RENDERER) + ::GetGLString(GL_VERSION);
+
+    if (!this->BinarySupport)
+    {
+      F3DLog::Print(F3DLog::Severity::Debug,
+        "Shader cache disabled: program binaries are not supported by the OpenGL context");
+    }
+  }
+  return this->BinarySupport == 1;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DShaderCache::ComputeKey(vtkShaderProgram* shader)
+{
+  unsigned char digest[16];
+  char md5Hash[33];
+  md5Hash[32] = '\0';
+
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  ::AppendToHash(md5, this->DriverString);
+  ::AppendToHash(md5, ::GetSource(shader->GetVertexShader()));
+  ::AppendToHash(md5, ::GetSource(shader->GetFragmentShader()));
+  ::AppendToHash(md5, ::GetSource(shader->GetGeometryShader()));
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240203)
+  ::AppendToHash(md5, ::GetSource(shader->GetComputeShader()));
+#endif
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+
+  return md5Hash;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DShaderCache::LoadProgram(vtkShaderProgram* shader, const std::string& path)
+{
+  vtksys::ifstream file(path.c_str(), std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+
+  GLenum format = 0;
+  file.read(reinterpret_cast<char*>(&format), sizeof(format));
+  std::vector<char> binary(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  file.close();
+
+  if (binary.empty())
+  {
+    vtksys::SystemTools::RemoveFile(path);
+    return false;
+  }
+
+  GLuint handle = glCreateProgram();
+  glProgramBinary(handle, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  GLint linked = GL_FALSE;
+  glGetProgramiv(handle, GL_LINK_STATUS, &linked);
+  if (linked != GL_TRUE)
+  {
+    // the driver rejected the binary, it will be replaced once the program is compiled
+    glDeleteProgram(handle);
+    vtksys::SystemTools::RemoveFile(path);
+    return false;
+  }
+
+  ::ShaderProgramAccess::SetHandle(shader, static_cast<int>(handle), true);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DShaderCache::SaveProgram(vtkShaderProgram* shader, const std::string& path)
+{
+  GLuint handle = static_cast<GLuint>(shader->GetHandle());
+
+  GLint length = 0;
+  glGetProgramiv(handle, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+  {
+    return;
+  }
+
+  std::vector<char> binary(length);
+  GLenum format = 0;
+  GLsizei written = 0;
+  glGetProgramBinary(handle, length, &written, &format, binary.data());
+  if (written <= 0)
+  {
+    return;
+  }
+
+  if (!vtksys::SystemTools::MakeDirectory(this->CacheDirectory))
+  {
+    F3DLog::Print(F3DLog::Severity::Debug,
+      "Shader cache disabled: cannot create directory " + this->CacheDirectory);
+    this->CacheDirectory.clear();
+    return;
+  }
+
+  // write to a temporary file first so that concurrent processes never read a partial binary
+  std::string tmpPath = path + "." + std::to_string(std::random_device()()) + ".tmp";
+  {
+    vtksys::ofstream file(tmpPath.c_str(), std::ios::binary);
+    if (!file.is_open())
+    {
+      return;
+    }
+    file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+    file.write(binary.data(), written);
+  }
+
+  if (!vtksys::SystemTools::RenameFile(tmpPath, path))
+  {
+    vtksys::SystemTools::RemoveFile(tmpPath);
+  }
+}
@@ -0,0 +1,97 @@
+/**
+ * @class   vtkF3DShaderCache
+ * @brief   Shader cache storing linked programs on disk
+ *
+ * vtkOpenGLShaderCache subclass that stores linked shader programs in a directory using
+ * glGetProgramBinary and reloads them with glProgramBinary instead of compiling their sources.
+ * Program binaries are keyed by a hash of the shader sources and of the OpenGL vendor, renderer
+ * and version strings, so that a driver update does not reuse incompatible binaries.
+ * The disk cache is disabled until a directory is set and is bypassed if the context does not
+ * support program binaries. Programs using transform feedback are never stored.
+ *
+ * @sa
+ * vtkOpenGLShaderCache
+ */
+
+#ifndef vtkF3DShaderCache_h
+#define vtkF3DShaderCache_h
+
+#include <vtkOpenGLShaderCache.h>
+
+#include <string>
+
+class vtkF3DShaderCache : public vtkOpenGLShaderCache
+{
+public:
+  static vtkF3DShaderCache* New();
+  vtkTypeMacro(vtkF3DShaderCache, vtkOpenGLShaderCache);
+
+  /**
+   * Make sure the program is compiled and bound.
+   * If the program is not compiled yet, try to load it from the disk cache first,
+   * and store it in the disk cache once compiled otherwise.
+   */
+  using Superclass::ReadyShaderProgram;
+  vtkShaderProgram* ReadyShaderProgram(
+    vtkShaderProgram* shader, vtkTransformFeedback* cap = nullptr) override;
+
+  /**
+   * Release graphics resources and forget about the current context capabilities.
+   */
+  void ReleaseGraphicsResources(vtkWindow* win) override;
+
+  /**
+   * Set/Get the directory used to store program binaries.
+   * An empty string disables the disk cache, which is the default.
+   */
+  void SetCacheDirectory(const std::string& dir);
+  const std::string& GetCacheDirectory() const
+  {
+    return this->CacheDirectory;
+  }
+
+  /**
+   * Get the number of programs loaded from the disk cache and
+   * the number of programs that had to be compiled.
+   */
+  vtkGetMacro(NumberOfHits, int);
+  vtkGetMacro(NumberOfMisses, int);
+
+  vtkF3DShaderCache(const vtkF3DShaderCache&) = delete;
+  void operator=(const vtkF3DShaderCache&) = delete;
+
+protected:
+  vtkF3DShaderCache();
+  ~vtkF3DShaderCache() override;
+
+private:
+  /**
+   * Check if the current context is able to retrieve and load program binaries.
+   */
+  bool IsBinarySupported();
+
+  /**
+   * Compute the cache key of a program from its sources and the driver strings.
+   */
+  std::string ComputeKey(vtkShaderProgram* shader);
+
+  /**
+   * Load the program binary from the disk and adopt it in the shader program.
+   * Return false if there is no usable binary.
+   */
+  bool LoadProgram(vtkShaderProgram* shader, const std::string& path);
+
+  /**
+   * Store the linked program binary on the disk.
+   */
+  void SaveProgram(vtkShaderProgram* shader, const std::string& path);
+
+  std::string CacheDirectory;
+  std::string DriverString;
+  int BinarySupport = -1;
+
+  int NumberOfHits = 0;
+  int NumberOfMisses = 0;
+};
+
+#endif
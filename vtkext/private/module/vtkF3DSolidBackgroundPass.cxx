@@ -33,9 +33,18 @@ void vtkF3DSolidBackgroundPass::Render(const vtkRenderState* state)
   assert(this->DelegatePass != nullptr);
 
   // create FBO and texture
-  int pos[2];
+  // inside another pass framebuffer, such as the dynamic resolution one, use its size
+  int pos[2] = { 0, 0 };
   int size[2];
-  ren->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+  vtkFrameBufferObjectBase* fbo = state->GetFrameBuffer();
+  if (fbo)
+  {
+    fbo->GetLastSize(size);
+  }
+  else
+  {
+    ren->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+  }
 
   if (this->ColorTexture == nullptr)
   {
@@ -107,6 +116,11 @@ void vtkF3DSolidBackgroundPass::ReleaseGraphicsResources(vtkWindow* win)
 {
   this->Superclass::ReleaseGraphicsResources(win);
 
+  if (this->QuadHelper)
+  {
+    this->QuadHelper->ReleaseGraphicsResources(win);
+    this->QuadHelper = nullptr;
+  }
   if (this->FrameBufferObject)
   {
     this->FrameBufferObject->ReleaseGraphicsResources(win);
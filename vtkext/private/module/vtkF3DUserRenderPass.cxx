@@ -32,9 +32,18 @@ void vtkF3DUserRenderPass::Render(const vtkRenderState* s)
   assert(this->DelegatePass != nullptr);
 
   // create FBO and texture
-  int pos[2];
+  // inside another pass framebuffer, such as the dynamic resolution one, use its size
+  int pos[2] = { 0, 0 };
   int size[2];
-  r->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+  vtkFrameBufferObjectBase* fbo = s->GetFrameBuffer();
+  if (fbo)
+  {
+    fbo->GetLastSize(size);
+  }
+  else
+  {
+    r->GetTiledSizeAndOrigin(&size[0], &size[1], &pos[0], &pos[1]);
+  }
 
   if (this->ColorTexture == nullptr)
   {
@@ -59,7 +68,8 @@ void vtkF3DUserRenderPass::Render(const vtkRenderState* s)
     s, size[0], size[1], size[0], size[1], this->FrameBufferObject, this->ColorTexture);
   renWin->GetState()->PopFramebufferBindings();
 
-  if (this->QuadHelper && this->QuadHelper->ShaderChangeValue < this->GetMTime())
+  // only recompile when the shader code changes, not when the delegate is rewired
+  if (this->QuadHelper && this->CompiledUserShader != this->UserShader)
   {
     this->QuadHelper = nullptr;
   }
@@ -81,6 +91,7 @@ void vtkF3DUserRenderPass::Render(const vtkRenderState* s)
     this->QuadHelper =
       std::make_shared<vtkOpenGLQuadHelper>(renWin, nullptr, FSSource.c_str(), nullptr);
     this->QuadHelper->ShaderChangeValue = this->GetMTime();
+    this->CompiledUserShader = this->UserShader;
   }
   else
   {
@@ -115,6 +126,11 @@ void vtkF3DUserRenderPass::ReleaseGraphicsResources(vtkWindow* w)
 {
   this->Superclass::ReleaseGraphicsResources(w);
 
+  if (this->QuadHelper)
+  {
+    this->QuadHelper->ReleaseGraphicsResources(w);
+    this->QuadHelper = nullptr;
+  }
   if (this->FrameBufferObject)
   {
     this->FrameBufferObject->ReleaseGraphicsResources(w);
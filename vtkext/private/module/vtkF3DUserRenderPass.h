@@ -76,6 +76,7 @@ private:
 
   std::shared_ptr<vtkOpenGLQuadHelper> QuadHelper;
   std::string UserShader;
+  std::string CompiledUserShader;
 };
 
 #endif
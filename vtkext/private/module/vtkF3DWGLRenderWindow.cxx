@@ -1,6 +1,7 @@
 #include <vtkObjectFactory.h>
 
 #include "vtkF3DWGLRenderWindow.h"
+#include "vtkF3DShaderCache.h"
 
 #include <Windows.h>
 #include <dwmapi.h>
@@ -83,7 +84,12 @@ bool IsWindowsInDarkMode()
 vtkStandardNewMacro(vtkF3DWGLRenderWindow);
 
 //------------------------------------------------------------------------------
-vtkF3DWGLRenderWindow::vtkF3DWGLRenderWindow() = default;
+vtkF3DWGLRenderWindow::vtkF3DWGLRenderWindow()
+{
+  // use a shader cache able to store program binaries on disk
+  this->ShaderCache->Delete();
+  this->ShaderCache = vtkF3DShaderCache::New();
+}
 
 //------------------------------------------------------------------------------
 vtkF3DWGLRenderWindow::~vtkF3DWGLRenderWindow() = default;
@@ -0,0 +1,113 @@
+#include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdList.h>
+#include <vtkInformation.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include "vtkF3DFaceVaryingPointDispatcher.h"
+
+#include <iostream>
+
+int TestF3DFaceVaryingPointDispatcher(int argc, char* argv[])
+{
+  // Two triangles sharing an edge: 4 points and 6 corners
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 1.0, 0.0);
+  points->InsertNextPoint(1.0, 1.0, 0.0);
+
+  vtkNew<vtkCellArray> polys;
+  vtkIdType tri0[3] = { 0, 1, 2 };
+  vtkIdType tri1[3] = { 2, 1, 3 };
+  polys->InsertNextCell(3, tri0);
+  polys->InsertNextCell(3, tri1);
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+
+  // Vertex attribute, one tuple per point
+  vtkNew<vtkDoubleArray> vertexArray;
+  vertexArray->SetName("vertex");
+  vertexArray->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < 4; i++)
+  {
+    vertexArray->InsertNextTuple2(i, 10.0 * i);
+  }
+  vertexArray->GetInformation()->Set(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(), 0);
+  polyData->GetPointData()->AddArray(vertexArray);
+
+  // Face-varying attribute, one tuple per corner
+  vtkNew<vtkFloatArray> faceVaryingArray;
+  faceVaryingArray->SetName("faceVarying");
+  for (vtkIdType i = 0; i < 6; i++)
+  {
+    faceVaryingArray->InsertNextValue(100.f + i);
+  }
+  faceVaryingArray->GetInformation()->Set(
+    vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE(), 1);
+  polyData->GetPointData()->AddArray(faceVaryingArray);
+
+  vtkNew<vtkF3DFaceVaryingPointDispatcher> dispatcher;
+  dispatcher->SetInputData(polyData);
+  dispatcher->Update();
+  vtkPolyData* output = dispatcher->GetOutput();
+
+  if (output->GetNumberOfPoints() != 6 || output->GetNumberOfPolys() != 2)
+  {
+    std::cerr << "Unexpected number of points or cells" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const vtkIdType corners[6] = { 0, 1, 2, 2, 1, 3 };
+  vtkDataArray* outputVertexArray = output->GetPointData()->GetArray("vertex");
+  vtkDataArray* outputFaceVaryingArray = output->GetPointData()->GetArray("faceVarying");
+  if (!outputVertexArray || outputVertexArray->GetNumberOfTuples() != 6 ||
+    outputVertexArray->GetDataType() != VTK_DOUBLE || !outputFaceVaryingArray)
+  {
+    std::cerr << "Unexpected output arrays" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIdList> cellPoints;
+  for (vtkIdType i = 0; i < 6; i++)
+  {
+    double expectedPoint[3];
+    double point[3];
+    points->GetPoint(corners[i], expectedPoint);
+    output->GetPoint(i, point);
+    if (point[0] != expectedPoint[0] || point[1] != expectedPoint[1] ||
+      point[2] != expectedPoint[2])
+    {
+      std::cerr << "Unexpected point " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (outputVertexArray->GetComponent(i, 0) != corners[i] ||
+      outputVertexArray->GetComponent(i, 1) != 10.0 * corners[i])
+    {
+      std::cerr << "Unexpected vertex attribute " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (outputFaceVaryingArray->GetComponent(i, 0) != 100.0 + i)
+    {
+      std::cerr << "Unexpected face-varying attribute " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    output->GetCellPoints(i / 3, cellPoints);
+    if (cellPoints->GetId(i % 3) != i)
+    {
+      std::cerr << "Unexpected connectivity " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
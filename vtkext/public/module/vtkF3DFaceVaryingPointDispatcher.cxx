@@ -1,10 +1,59 @@
 #include "vtkF3DFaceVaryingPointDispatcher.h"
 
-#include "vtkFloatArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+/**
+ * Copy the tuples of the input array to the output array
+ * where each output tuple index is a corner of a face and PointIds the corresponding input tuple
+ */
+struct GatherWorker
+{
+  const vtkIdType* PointIds;
+
+  template <typename InputArrayT, typename OutputArrayT>
+  void operator()(InputArrayT* inputArray, OutputArrayT* outputArray)
+  {
+    const auto inputTuples = vtk::DataArrayTupleRange(inputArray);
+    auto outputTuples = vtk::DataArrayTupleRange(outputArray);
+    const vtkIdType* pointIds = this->PointIds;
+
+    vtkSMPTools::For(0, outputTuples.size(),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          outputTuples[i] = inputTuples[pointIds[i]];
+        }
+      });
+  }
+};
+
+void Gather(vtkDataArray* inputArray, vtkDataArray* outputArray, const vtkIdType* pointIds)
+{
+  GatherWorker worker{ pointIds };
+  if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(inputArray, outputArray, worker))
+  {
+    // fallback on the generic vtkDataArray API, serial as some arrays do not support
+    // concurrent writes of different tuples
+    const vtkIdType nbTuples = outputArray->GetNumberOfTuples();
+    for (vtkIdType i = 0; i < nbTuples; i++)
+    {
+      outputArray->SetTuple(i, pointIds[i], inputArray);
+    }
+  }
+}
+}
 
 vtkStandardNewMacro(vtkF3DFaceVaryingPointDispatcher);
 
@@ -23,27 +72,35 @@ int vtkF3DFaceVaryingPointDispatcher::RequestData(vtkInformation* vtkNotUsed(req
   vtkPolyData* input = vtkPolyData::GetData(inputVector[0]->GetInformationObject(0));
   vtkPolyData* output = vtkPolyData::GetData(outputVector->GetInformationObject(0));
 
-  // early exit if all interpolations are "vertex"
   vtkPointData* inputPointData = input->GetPointData();
 
-  vtkIdType nbArrays = inputPointData->GetNumberOfArrays();
-
+  // Resolve the interpolation of all arrays once, only vertex arrays need to be dispatched
+  std::vector<vtkDataArray*> vertexArrays;
   bool earlyExit = true;
 
+  vtkIdType nbArrays = inputPointData->GetNumberOfArrays();
   for (vtkIdType i = 0; i < nbArrays; i++)
   {
     vtkDataArray* inputArray = inputPointData->GetArray(i);
+    if (!inputArray)
+    {
+      continue;
+    }
 
     vtkInformation* info = inputArray->GetInformation();
     int interpType = info->Get(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE());
 
-    if (interpType != 0) // vertex
+    if (interpType == 0) // vertex
+    {
+      vertexArrays.emplace_back(inputArray);
+    }
+    else
     {
       earlyExit = false;
-      break;
     }
   }
 
+  // early exit if all interpolations are "vertex"
   if (earlyExit)
   {
     // nothing to do, just return the input
@@ -54,12 +111,37 @@ int vtkF3DFaceVaryingPointDispatcher::RequestData(vtkInformation* vtkNotUsed(req
   vtkPoints* inputPoints = input->GetPoints();
   vtkCellArray* inputFaces = input->GetPolys();
 
-  vtkIdType nbCells = inputFaces->GetNumberOfCells();
   vtkIdType nbConnectivity = inputFaces->GetNumberOfConnectivityIds();
 
-  // the number of output points is the number of total cells connectivity
+  // The input point of each output point, the number of output points is the number of total
+  // cells connectivity
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->DeepCopy(inputFaces->GetConnectivityArray());
+  const vtkIdType* pointIdsPtr = pointIds->GetPointer(0);
+
+  // Output faces have the same offsets than the input ones, with consecutive point ids
+  vtkNew<vtkIdTypeArray> outputOffsets;
+  outputOffsets->DeepCopy(inputFaces->GetOffsetsArray());
+
+  vtkNew<vtkIdTypeArray> outputConnectivity;
+  outputConnectivity->SetNumberOfValues(nbConnectivity);
+  vtkIdType* outputConnectivityPtr = outputConnectivity->GetPointer(0);
+  vtkSMPTools::For(0, nbConnectivity,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        outputConnectivityPtr[i] = i;
+      }
+    });
+
+  vtkNew<vtkCellArray> outputFaces;
+  outputFaces->SetData(outputOffsets, outputConnectivity);
+
   vtkNew<vtkPoints> outputPoints;
+  outputPoints->SetDataType(inputPoints->GetDataType());
   outputPoints->SetNumberOfPoints(nbConnectivity);
+  Gather(inputPoints->GetData(), outputPoints->GetData(), pointIdsPtr);
 
   vtkPointData* outputPointData = output->GetPointData();
 
@@ -69,65 +151,17 @@ int vtkF3DFaceVaryingPointDispatcher::RequestData(vtkInformation* vtkNotUsed(req
 
   // However, for vertex attributes, the arrays must be replaced by dispatching the values
   // in order to duplicate values and correspond to the new point location
-  for (vtkIdType i = 0; i < nbArrays; i++)
-  {
-    vtkDataArray* inputArray = inputPointData->GetArray(i);
-
-    vtkInformation* info = inputArray->GetInformation();
-    int interpType = info->Get(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE());
-
-    if (interpType == 0) // vertex
-    {
-      auto outputArray = vtkSmartPointer<vtkDataArray>::Take(
-        vtkDataArray::CreateDataArray(inputArray->GetDataType()));
-      outputArray->SetNumberOfComponents(inputArray->GetNumberOfComponents());
-      outputArray->SetNumberOfTuples(nbConnectivity);
-      outputArray->SetName(inputArray->GetName());
-
-      outputPointData->AddArray(outputArray);
-    }
-  }
-
-  vtkNew<vtkCellArray> outputFaces;
-
-  std::vector<vtkIdType> cell;
-  cell.resize(inputFaces->GetMaxCellSize());
-
-  vtkIdType currentVertexIndex = 0;
-
-  for (vtkIdType i = 0; i < nbCells; i++)
+  for (vtkDataArray* inputArray : vertexArrays)
   {
-    vtkIdType cellSize;
-    const vtkIdType* cellPoints;
-    inputFaces->GetCellAtId(i, cellSize, cellPoints);
-
-    for (vtkIdType j = 0; j < cellSize; j++)
-    {
-      cell[j] = currentVertexIndex + j;
-      outputPoints->SetPoint(currentVertexIndex + j, inputPoints->GetPoint(cellPoints[j]));
-
-      for (vtkIdType k = 0; k < nbArrays; k++)
-      {
-        vtkDataArray* inputArray = inputPointData->GetArray(k);
-
-        vtkInformation* info = inputArray->GetInformation();
-        int interpType = info->Get(vtkF3DFaceVaryingPointDispatcher::INTERPOLATION_TYPE());
-
-        if (interpType == 0) // vertex
-        {
-          vtkDataArray* outputArray = outputPointData->GetArray(inputArray->GetName());
-
-          if (outputArray)
-          {
-            outputArray->SetTuple(currentVertexIndex + j, inputArray->GetTuple(cellPoints[j]));
-          }
-        }
-      }
-    }
-
-    outputFaces->InsertNextCell(cellSize, cell.data());
-
-    currentVertexIndex += cellSize;
+    // input arrays may be implicit or use another memory layout, always create a plain array
+    auto outputArray =
+      vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(inputArray->GetDataType()));
+    outputArray->SetNumberOfComponents(inputArray->GetNumberOfComponents());
+    outputArray->SetNumberOfTuples(nbConnectivity);
+    outputArray->SetName(inputArray->GetName());
+    Gather(inputArray, outputArray, pointIdsPtr);
+
+    outputPointData->AddArray(outputArray);
   }
 
   output->SetPoints(outputPoints);
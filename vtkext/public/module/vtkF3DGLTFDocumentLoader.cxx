@@ -0,0 +1,101 @@
+#include "vtkF3DGLTFDocumentLoader.h"
+
+#include <vtkObjectFactory.h>
+
+// clang-format off
+#include <vtk_nlohmannjson.h>
+#include VTK_NLOHMANN_JSON(json.hpp)
+// clang-format on
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+constexpr const char* BASISU_EXTENSION = "KHR_texture_basisu";
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkF3DGLTFDocumentLoader);
+
+//----------------------------------------------------------------------------
+std::vector<std::string> vtkF3DGLTFDocumentLoader::GetSupportedExtensions()
+{
+  std::vector<std::string> extensions = this->Superclass::GetSupportedExtensions();
+  extensions.emplace_back(::BASISU_EXTENSION);
+  return extensions;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DGLTFDocumentLoader::PrepareData()
+{
+  const std::vector<std::string>& usedExtensions = this->GetUsedExtensions();
+  if (std::find(usedExtensions.begin(), usedExtensions.end(), ::BASISU_EXTENSION) ==
+    usedExtensions.end())
+  {
+    return;
+  }
+
+  // The texture extensions are not parsed by vtkGLTFDocumentLoader, read them from the file
+  std::shared_ptr<Model> model = this->GetInternalModel();
+  const nlohmann::json root = nlohmann::json::parse(
+    vtkF3DGLTFDocumentLoader::ReadDocumentJSON(model->FileName), nullptr, false);
+  if (root.is_discarded() || !root.contains("textures") || !root["textures"].is_array())
+  {
+    return;
+  }
+
+  const nlohmann::json& textures = root["textures"];
+  for (size_t i = 0; i < textures.size() && i < model->Textures.size(); i++)
+  {
+    Texture& texture = model->Textures[i];
+    const nlohmann::json& jsonTexture = textures[i];
+    if (texture.Source >= 0 || !jsonTexture.contains("extensions") ||
+      !jsonTexture["extensions"].contains(::BASISU_EXTENSION))
+    {
+      continue;
+    }
+
+    int source = jsonTexture["extensions"][::BASISU_EXTENSION].value("source", -1);
+    if (source < 0 || source >= static_cast<int>(model->Images.size()))
+    {
+      vtkWarningMacro("Invalid " << ::BASISU_EXTENSION << " source in texture " << i);
+      continue;
+    }
+    texture.Source = source;
+  }
+}
+
+//----------------------------------------------------------------------------
+std::string vtkF3DGLTFDocumentLoader::ReadDocumentJSON(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file)
+  {
+    return {};
+  }
+
+  char magic[4];
+  file.read(magic, sizeof(magic));
+  if (file.gcount() == sizeof(magic) && std::string(magic, sizeof(magic)) == "glTF")
+  {
+    // glb: the 12 bytes header is followed by the JSON chunk
+    uint32_t chunkHeader[2];
+    file.seekg(12);
+    file.read(reinterpret_cast<char*>(chunkHeader), sizeof(chunkHeader));
+    constexpr uint32_t JSON_CHUNK_TYPE = 0x4E4F534A;
+    if (!file || chunkHeader[1] != JSON_CHUNK_TYPE)
+    {
+      return {};
+    }
+    std::string json(chunkHeader[0], '\0');
+    file.read(json.data(), json.size());
+    return file ? json : std::string();
+  }
+
+  file.clear();
+  file.seekg(0);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
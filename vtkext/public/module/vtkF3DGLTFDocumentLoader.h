@@ -0,0 +1,49 @@
+/**
+ * @class   vtkF3DGLTFDocumentLoader
+ * @brief   VTK GLTF document loader customization
+ *
+ * Subclasses the native loader to handle texture extensions not parsed by VTK.
+ * Loaders of F3D plugins should inherit from this class.
+ */
+
+#ifndef vtkF3DGLTFDocumentLoader_h
+#define vtkF3DGLTFDocumentLoader_h
+
+#include "vtkextModule.h"
+
+#include <vtkGLTFDocumentLoader.h>
+
+#include <string>
+
+class VTKEXT_EXPORT vtkF3DGLTFDocumentLoader : public vtkGLTFDocumentLoader
+{
+public:
+  static vtkF3DGLTFDocumentLoader* New();
+  vtkTypeMacro(vtkF3DGLTFDocumentLoader, vtkGLTFDocumentLoader);
+
+  /**
+   * Overridden to add KHR_texture_basisu support
+   */
+  std::vector<std::string> GetSupportedExtensions() override;
+
+  /**
+   * Overridden to resolve the KTX2 source of textures using KHR_texture_basisu.
+   * The fallback source is kept when provided, as it does not depend on KTX2 support.
+   */
+  void PrepareData() override;
+
+  /**
+   * Read the JSON part of a glTF or glb file, return an empty string on failure
+   */
+  static std::string ReadDocumentJSON(const std::string& fileName);
+
+protected:
+  vtkF3DGLTFDocumentLoader() = default;
+  ~vtkF3DGLTFDocumentLoader() override = default;
+
+private:
+  vtkF3DGLTFDocumentLoader(const vtkF3DGLTFDocumentLoader&) = delete;
+  void operator=(const vtkF3DGLTFDocumentLoader&) = delete;
+};
+
+#endif
@@ -2,6 +2,10 @@
 
 #include "vtkF3DImporter.h"
 
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240214)
+#include "vtkF3DGLTFDocumentLoader.h"
+#endif
+
 #include <vtkActor.h>
 #include <vtkInformation.h>
 #include <vtkObjectFactory.h>
@@ -31,3 +35,11 @@ void vtkF3DGLTFImporter::ApplyArmatureProperties(vtkActor* actor)
   actor->SetPropertyKeys(info);
 }
 #endif
+
+//----------------------------------------------------------------------------
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240214)
+void vtkF3DGLTFImporter::InitializeLoader()
+{
+  this->Loader = vtkSmartPointer<vtkF3DGLTFDocumentLoader>::New();
+}
+#endif
@@ -25,6 +25,14 @@ protected:
   vtkF3DGLTFImporter();
   ~vtkF3DGLTFImporter() override = default;
 
+  // need https://gitlab.kitware.com/vtk/vtk/-/merge_requests/10884
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240214)
+  /**
+   * Overridden to instantiate our own document loader
+   */
+  void InitializeLoader() override;
+#endif
+
   // need https://gitlab.kitware.com/vtk/vtk/-/merge_requests/11774
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 20241219)
   /**